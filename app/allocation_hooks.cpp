@@ -0,0 +1,149 @@
+// Replacements of the global 'operator new' and 'operator delete' that feed
+// the allocation tracker. Only linked into the executable when it is built
+// with 'SENBONZAKURA_TRACK_ALLOCATIONS', so that regular builds keep the
+// allocator of the standard library untouched.
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#include <malloc.h>
+
+#include "senbonzakura/allocation_tracker.hpp"
+
+namespace {
+
+// Sizes are taken from the allocator rather than from the requests, so that
+// allocations and deallocations always add up, even through the unsized
+// 'operator delete'.
+void *Allocate(std::size_t size, std::size_t alignment, bool is_nothrow) {
+  if (size == 0) {
+    size = 1;
+  }
+
+  while (true) {
+    void *pointer = nullptr;
+    if (alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+      pointer = std::malloc(size);
+    } else if (posix_memalign(&pointer, alignment, size) != 0) {
+      pointer = nullptr;
+    }
+    if (pointer != nullptr) {
+      RecordAllocation(malloc_usable_size(pointer));
+      return pointer;
+    }
+
+    std::new_handler new_handler = std::get_new_handler();
+    if (new_handler == nullptr) {
+      if (is_nothrow) {
+        return nullptr;
+      }
+      throw std::bad_alloc{};
+    }
+    new_handler();
+  }
+}
+
+void Deallocate(void *pointer) {
+  if (pointer == nullptr) {
+    return;
+  }
+
+  RecordDeallocation(malloc_usable_size(pointer));
+  std::free(pointer);
+
+  return;
+}
+
+const bool kAreHooksMarkedInstalled = []() {
+  MarkAllocationHooksInstalled();
+  return true;
+}();
+
+} // namespace
+
+void *operator new(std::size_t size) {
+  return Allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__, false);
+}
+
+void *operator new[](std::size_t size) {
+  return Allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__, false);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+  try {
+    return Allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__, true);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+  try {
+    return Allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__, true);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment) {
+  return Allocate(size, static_cast<std::size_t>(alignment), false);
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment) {
+  return Allocate(size, static_cast<std::size_t>(alignment), false);
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment,
+                   const std::nothrow_t &) noexcept {
+  try {
+    return Allocate(size, static_cast<std::size_t>(alignment), true);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment,
+                     const std::nothrow_t &) noexcept {
+  try {
+    return Allocate(size, static_cast<std::size_t>(alignment), true);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+void operator delete(void *pointer) noexcept { Deallocate(pointer); }
+
+void operator delete[](void *pointer) noexcept { Deallocate(pointer); }
+
+void operator delete(void *pointer, std::size_t) noexcept {
+  Deallocate(pointer);
+}
+
+void operator delete[](void *pointer, std::size_t) noexcept {
+  Deallocate(pointer);
+}
+
+void operator delete(void *pointer, std::align_val_t) noexcept {
+  Deallocate(pointer);
+}
+
+void operator delete[](void *pointer, std::align_val_t) noexcept {
+  Deallocate(pointer);
+}
+
+void operator delete(void *pointer, std::size_t, std::align_val_t) noexcept {
+  Deallocate(pointer);
+}
+
+void operator delete[](void *pointer, std::size_t, std::align_val_t) noexcept {
+  Deallocate(pointer);
+}
+
+void operator delete(void *pointer, const std::nothrow_t &) noexcept {
+  Deallocate(pointer);
+}
+
+void operator delete[](void *pointer, const std::nothrow_t &) noexcept {
+  Deallocate(pointer);
+}
@@ -1,19 +1,29 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
 #include <format>
+#include <fstream>
 #include <iostream>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 #include <CLI/CLI.hpp>
 
+#include "senbonzakura/compilation_driver.hpp"
 #include "senbonzakura/diagnostic_reporter.hpp"
-#include "senbonzakura/file_scanner.hpp"
+#include "senbonzakura/diagnostic_sink.hpp"
 #include "senbonzakura/file_writer.hpp"
-#include "senbonzakura/lexer.hpp"
-#include "senbonzakura/parser.hpp"
+#include "senbonzakura/perf_counters.hpp"
+#include "senbonzakura/time_report.hpp"
+#include "senbonzakura/trace.hpp"
 
 int main(int argc, const char **argv) {
   std::string output_directory_path;
   std::vector<std::string> eta_programs_filepaths;
+  CompilationOptions compilation_options;
 
   CLI::App senbonzakura_compiler_app{
       "This is the Senbonzakura Compiler. A compiler written using C++ 20 for "
@@ -36,6 +46,107 @@ int main(int argc, const char **argv) {
                       "diagnostic files will be placed.")
           ->needs("--lex");
 
+  senbonzakura_compiler_app
+      .add_option("-j,--jobs", compilation_options.job_count,
+                  "The number of files compiled at the same time. The "
+                  "results and diagnostics of every file are still printed "
+                  "in the order in which the files were given. Defaults to "
+                  "1.")
+      ->check(CLI::PositiveNumber);
+
+  senbonzakura_compiler_app
+      .add_option("--lex-threads", compilation_options.lex_thread_count,
+                  "The number of threads used to lex each file. A file is "
+                  "only split into chunks of at least 1 MiB, at newline "
+                  "boundaries, and the output does not depend on this value. "
+                  "Defaults to 1.")
+      ->check(CLI::PositiveNumber);
+
+  std::vector<std::string> emitted_outputs;
+  senbonzakura_compiler_app
+      .add_option("--emit", emitted_outputs,
+                  "The lexer outputs to write for every file, separated by "
+                  "commas: 'lexed' for the human-readable token list and "
+                  "'lexedb' for the binary token stream that can be "
+                  "memory-mapped by other tools. Defaults to 'lexed'.")
+      ->delimiter(',')
+      ->check(CLI::IsMember({"lexed", "lexedb"}));
+
+  senbonzakura_compiler_app.add_flag(
+      "-p,--parse", compilation_options.emit_parsed,
+      "Also writes, for every file, the S-expression of its syntax tree to a "
+      "'.parsed' file, or its first error, as '<line>:<column> "
+      "error:<description>', when it has any.");
+
+  senbonzakura_compiler_app
+      .add_flag("--pretty", compilation_options.pretty_print_parsed,
+                "Pretty-prints the '.parsed' files, with every definition "
+                "and statement on its own line, indented by its depth. "
+                "Otherwise every tree is written on a single line.")
+      ->needs("--parse");
+
+  senbonzakura_compiler_app.add_option(
+      "--cache-dir", compilation_options.cache_directory,
+      "A directory where the tokens of the files that compiled without any "
+      "diagnostic are cached, keyed by the hash of their contents. Unchanged "
+      "files are then neither lexed nor parsed again. The directory can be "
+      "shared by several concurrent runs. Disabled by default.");
+
+  compilation_options.max_error_count = 20;
+  senbonzakura_compiler_app.add_option(
+      "--max-errors", compilation_options.max_error_count,
+      "The maximum number of errors printed for each file. The remaining "
+      "ones are only counted, so that a garbage input cannot flood the "
+      "output. 0 prints every error. Defaults to 20.");
+
+  bool print_time_report = false;
+  senbonzakura_compiler_app.add_flag(
+      "--time-report", print_time_report,
+      "Prints, to the standard error, how long every phase took for each "
+      "file and for the whole run, along with the bytes and tokens "
+      "processed, the throughput and the peak resident set size. Builds "
+      "configured with '-DSENBONZAKURA_TRACK_ALLOCATIONS=ON' also report the "
+      "heap allocations, bytes and peak live bytes of every phase.");
+
+  std::string time_report_json_path;
+  senbonzakura_compiler_app.add_option(
+      "--time-report-json", time_report_json_path,
+      "Writes the same report as '--time-report' to the given file, as "
+      "JSON.");
+
+  senbonzakura_compiler_app.add_flag(
+      "--perf-counters", compilation_options.measure_perf_counters,
+      "Counts cycles, instructions, branch misses, L1D and LLC misses and "
+      "page faults in every phase with 'perf_event_open', and prints, to the "
+      "standard error, the instructions per cycle and the misses per KB of "
+      "source code of each file and of the whole run. Events that the "
+      "system does not allow to count are left out with a warning.");
+
+  std::string diagnostics_format = "text";
+  senbonzakura_compiler_app
+      .add_option("--diagnostics-format", diagnostics_format,
+                  "How diagnostics are written: 'text' for the colored "
+                  "messages, 'jsonl' for a JSON object per line, or 'sarif' "
+                  "for a SARIF 2.1.0 log. The 'jsonl' and 'sarif' formats "
+                  "stream every diagnostic as soon as it is found, to the "
+                  "file descriptor given by '--diagnostics-fd', and replace "
+                  "the text output. Defaults to 'text'.")
+      ->check(CLI::IsMember({"text", "jsonl", "sarif"}));
+
+  int diagnostics_fd = 1;
+  senbonzakura_compiler_app.add_option(
+      "--diagnostics-fd", diagnostics_fd,
+      "The file descriptor that the 'jsonl' and 'sarif' diagnostics are "
+      "written to, which must be open for writing. Defaults to 1, the "
+      "standard output.");
+
+  std::string trace_file_path;
+  senbonzakura_compiler_app.add_option(
+      "--trace", trace_file_path,
+      "Writes Chrome trace events of every phase of every file, on every "
+      "thread, to the given file. It can be opened in 'chrome://tracing' or "
+      "in Perfetto.");
+
   try {
     CLI11_PARSE(senbonzakura_compiler_app, argc, argv);
   } catch (const CLI::ParseError &parse_error) {
@@ -51,39 +162,190 @@ int main(int argc, const char **argv) {
     output_directory_path = std::string{PROJECT_ROOT_DIR} + "/output";
   }
 
+  if (!emitted_outputs.empty()) {
+    compilation_options.emit_lexed =
+        std::ranges::find(emitted_outputs, "lexed") != emitted_outputs.end();
+    compilation_options.emit_lexedb =
+        std::ranges::find(emitted_outputs, "lexedb") != emitted_outputs.end();
+  }
+  std::vector<std::string_view> emitted_extensions;
+  if (compilation_options.emit_lexed) {
+    emitted_extensions.push_back("'.lexed'");
+  }
+  if (compilation_options.emit_lexedb) {
+    emitted_extensions.push_back("'.lexedb'");
+  }
+  if (compilation_options.emit_parsed) {
+    emitted_extensions.push_back("'.parsed'");
+  }
+  std::string emitted_files_description;
+  for (std::size_t index = 0; index < emitted_extensions.size(); index++) {
+    if (index > 0) {
+      emitted_files_description +=
+          index + 1 == emitted_extensions.size() ? " and " : ", ";
+    }
+    emitted_files_description += emitted_extensions[index];
+  }
+  emitted_files_description +=
+      emitted_extensions.size() == 1 ? " file has" : " files have";
+  std::string_view performed_phases_description =
+      compilation_options.emit_parsed ? "Lexing and parsing phases"
+                                      : "Lexing phase";
+
   FileWriter file_writer{eta_programs_filepaths, output_directory_path};
+  bool is_time_report_enabled =
+      print_time_report || !time_report_json_path.empty();
+  std::vector<std::pair<std::string, TimeReport>> file_time_reports;
+  // Problems with the outputs of the run itself, rather than of a file.
+  DiagnosticReporter run_diagnostic_reporter;
+  std::unique_ptr<DiagnosticSink> diagnostic_sink;
+  if (diagnostics_format == "jsonl") {
+    diagnostic_sink = std::make_unique<JsonLinesDiagnosticSink>(diagnostics_fd);
+  } else if (diagnostics_format == "sarif") {
+    diagnostic_sink = std::make_unique<SarifDiagnosticSink>(diagnostics_fd);
+  }
+  compilation_options.diagnostic_sink = diagnostic_sink.get();
+  run_diagnostic_reporter.SetSink(diagnostic_sink.get());
+  if (!trace_file_path.empty()) {
+    if (IsTracingSupported()) {
+      StartTracing();
+    } else {
+      run_diagnostic_reporter.ReportSystemError(
+          Severity::kWarning,
+          "[W]: This compiler was built without tracing support, so "
+          "'--trace' is ignored. Rebuild it with "
+          "'-DSENBONZAKURA_ENABLE_TRACING=ON'.");
+    }
+  }
+  if (compilation_options.measure_perf_counters) {
+    PerfCounters perf_counters;
+    if (!perf_counters.HasAnyEvent()) {
+      compilation_options.measure_perf_counters = false;
+      run_diagnostic_reporter.ReportSystemError(
+          Severity::kWarning,
+          std::format("[W]: No performance counter can be opened, so "
+                      "'--perf-counters' is ignored: {}.",
+                      perf_counters.DescribeUnavailableEvents()));
+    } else if (std::string unavailable_events =
+                   perf_counters.DescribeUnavailableEvents();
+               !unavailable_events.empty()) {
+      run_diagnostic_reporter.ReportSystemError(
+          Severity::kWarning,
+          std::format("[W]: Some performance counters cannot be opened, and "
+                      "are shown as '-': {}.",
+                      unavailable_events));
+    }
+  }
+  std::vector<std::pair<std::string, PerfCounterReport>>
+      file_perf_counter_reports;
+  auto run_start = std::chrono::steady_clock::now();
 
-  for (const std::string &current_eta_filepath : eta_programs_filepaths) {
-    DiagnosticReporter diagnostic_reporter;
-    FileScanner file_scanner{current_eta_filepath, diagnostic_reporter};
+  std::size_t failed_file_count = CompileFiles(
+      eta_programs_filepaths, file_writer, compilation_options,
+      [&](const FileCompilationResult &result) {
+        const DiagnosticReporter &diagnostic_reporter =
+            result.diagnostic_reporter;
+        // The 'jsonl' and 'sarif' diagnostics have already been streamed.
+        if (!diagnostic_sink) {
+          if (diagnostic_reporter.HasWarnings() ||
+              diagnostic_reporter.HasNormalErrors() ||
+              diagnostic_reporter.HasFatalErrors()) {
+            diagnostic_reporter.OutputSystemErrors();
+            diagnostic_reporter.OutputCompilerErrors();
+          } else {
+            std::cout << kAnsiGreen
+                      << std::format(
+                             "[SUCCESS]: {} of the file: '{}' {} been "
+                             "successfully performed. The corresponding {} "
+                             "been stored at '{}'.",
+                             performed_phases_description, result.file_path,
+                             compilation_options.emit_parsed ? "have" : "has",
+                             emitted_files_description, output_directory_path)
+                      << kAnsiReset << '\n';
+          }
+        }
 
-    file_scanner.ScanFile();
-    const std::string &file_content = file_scanner.GetFileContentBytes();
+        if (is_time_report_enabled) {
+          file_time_reports.emplace_back(result.file_path,
+                                         result.time_report);
+        }
+        if (compilation_options.measure_perf_counters) {
+          file_perf_counter_reports.emplace_back(result.file_path,
+                                                 result.perf_counter_report);
+        }
+      });
 
-    Lexer lexer{current_eta_filepath, file_content, diagnostic_reporter};
-    const std::vector<Token> tokens = lexer.LexTokens();
+  if (is_time_report_enabled) {
+    std::chrono::nanoseconds run_wall_time =
+        std::chrono::steady_clock::now() - run_start;
+    TimeReport total_time_report;
+    for (const auto &[file_path, time_report] : file_time_reports) {
+      total_time_report.Merge(time_report);
+    }
+    total_time_report.SetPeakResidentSetSize(GetPeakResidentSetSize());
 
-    Parser parser{current_eta_filepath, tokens, diagnostic_reporter};
-    parser.Parse();
+    if (print_time_report) {
+      for (const auto &[file_path, time_report] : file_time_reports) {
+        std::cerr << FormatTimeReport(std::format("'{}'", file_path),
+                                      time_report);
+      }
+      std::cerr << FormatTimeReport(
+          std::format("{} files", file_time_reports.size()),
+          total_time_report, run_wall_time);
+    }
 
-    file_writer.WriteLexerOutput(current_eta_filepath, tokens);
+    if (!time_report_json_path.empty()) {
+      std::ofstream time_report_json_file{time_report_json_path};
+      time_report_json_file << FormatTimeReportJson(
+          file_time_reports, total_time_report, run_wall_time);
+      if (!time_report_json_file) {
+        run_diagnostic_reporter.ReportSystemError(
+            Severity::kError,
+            std::format("[E]: Could not write the time report to '{}'.",
+                        time_report_json_path));
+      }
+    }
+  }
 
-    if (diagnostic_reporter.HasWarnings() ||
-        diagnostic_reporter.HasNormalErrors() ||
-        diagnostic_reporter.HasFatalErrors()) {
-      diagnostic_reporter.OutputSystemErrors();
-      diagnostic_reporter.OutputCompilerErrors();
-      return 0;
-    } else {
-      std::cout << kAnsiGreen
-                << std::format(
-                       "[SUCCESS]: Lexing phase of the file: '{}' has been "
-                       "successfully performed. The corresponding "
-                       "'.lexed' file has been stored at '{}'.",
-                       current_eta_filepath, output_directory_path)
-                << kAnsiReset << std::endl;
+  if (compilation_options.measure_perf_counters) {
+    PerfCounterReport total_perf_counter_report;
+    for (const auto &[file_path, perf_counter_report] :
+         file_perf_counter_reports) {
+      std::cerr << FormatPerfCounterReport(std::format("'{}'", file_path),
+                                           perf_counter_report);
+      total_perf_counter_report.Merge(perf_counter_report);
+    }
+    std::cerr << FormatPerfCounterReport(
+        std::format("{} files", file_perf_counter_reports.size()),
+        total_perf_counter_report);
+  }
+
+  if (IsTracingEnabled()) {
+    std::ofstream trace_file{trace_file_path};
+    trace_file << FormatTrace();
+    if (!trace_file) {
+      run_diagnostic_reporter.ReportSystemError(
+          Severity::kError,
+          std::format("[E]: Could not write the trace to '{}'.",
+                      trace_file_path));
+    }
+  }
+  if (diagnostic_sink) {
+    diagnostic_sink->Finish();
+    if (diagnostic_sink->HasWriteError()) {
+      // There is nowhere else to report it, so it is written as text.
+      std::cerr << kAnsiRed
+                << std::format("[Error] - [Message]:[E]: Could not write the "
+                               "diagnostics to the file descriptor {}.",
+                               diagnostics_fd)
+                << kAnsiReset << '\n';
+      return 1;
     }
+  } else {
+    run_diagnostic_reporter.OutputSystemErrors();
   }
 
-  return 0;
+  return failed_file_count == 0 && !run_diagnostic_reporter.HasNormalErrors()
+             ? 0
+             : 1;
 }
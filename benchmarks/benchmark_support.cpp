@@ -0,0 +1,105 @@
+#include "benchmark_support.hpp"
+
+#include <cstddef>
+#include <format>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+namespace {
+
+void AppendIdentifierHeavyFunction(std::string &source, std::size_t index) {
+  source += std::format(
+      "compute_{0}(values: int[], count: int): int, bool {{\n"
+      "  total: int = 0\n"
+      "  index: int = 0\n"
+      "  while (index < count & index < length(values)) {{\n"
+      "    current_value: int = values[index]\n"
+      "    if (current_value >= total | !(current_value == index)) {{\n"
+      "      total = total + current_value * index - count / 2\n"
+      "    }} else {{\n"
+      "      total = total - current_value % 7 *>> count\n"
+      "    }}\n"
+      "    index = index + 1\n"
+      "  }}\n"
+      "  return total, total != count\n"
+      "}}\n\n",
+      index);
+
+  return;
+}
+
+void AppendCommentHeavyFunction(std::string &source, std::size_t index) {
+  source += std::format(
+      "// Function number {0}. This comment is long on purpose, so that the\n"
+      "// lexer spends most of its time skipping to the end of the line, as\n"
+      "// it does on heavily documented sources and on license headers.\n"
+      "documented_{0}(x: int): int {{\n"
+      "  // Doubles the argument, which is all this function ever does.\n"
+      "  return x * 2 // Trailing comments are skipped the same way.\n"
+      "}}\n\n",
+      index);
+
+  return;
+}
+
+void AppendLiteralHeavyFunction(std::string &source, std::size_t index) {
+  source += std::format(
+      "literals_{0}(): int[] {{\n"
+      "  numbers: int[] = {{1234567890, 42, 9223372036854775807, {0}, 0}}\n"
+      "  characters: int[] = {{'a', 'Z', '\\n', '\\'', '\\x{{41}}', '0'}}\n"
+      "  message: int[] = \"Hello, world! A longer string literal.\\n\"\n"
+      "  escaped: int[] = \"tab\\there, quote\\\" and \\x{{7E}} too\"\n"
+      "  return message\n"
+      "}}\n\n",
+      index);
+
+  return;
+}
+
+} // namespace
+
+std::string MakeBenchmarkSource(SourceShape shape, std::size_t size) {
+  std::string source;
+  source.reserve(size + 1024);
+  source += "use io\n\n";
+
+  for (std::size_t index = 0; source.size() < size; index++) {
+    switch (shape) {
+    case (SourceShape::kIdentifierHeavy):
+      AppendIdentifierHeavyFunction(source, index);
+      break;
+    case (SourceShape::kCommentHeavy):
+      AppendCommentHeavyFunction(source, index);
+      break;
+    case (SourceShape::kLiteralHeavy):
+      AppendLiteralHeavyFunction(source, index);
+      break;
+    }
+  }
+
+  return source;
+}
+
+const char *GetSourceShapeName(SourceShape shape) {
+  switch (shape) {
+  case (SourceShape::kIdentifierHeavy):
+    return "identifier_heavy";
+  case (SourceShape::kCommentHeavy):
+    return "comment_heavy";
+  case (SourceShape::kLiteralHeavy):
+    return "literal_heavy";
+  }
+
+  return "unknown";
+}
+
+void SetSourceThroughput(benchmark::State &state, std::size_t source_size,
+                         std::size_t token_count) {
+  state.SetBytesProcessed(state.iterations() * source_size);
+  state.counters["tokens"] =
+      benchmark::Counter(static_cast<double>(token_count),
+                         benchmark::Counter::kIsIterationInvariantRate);
+
+  return;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+// Shapes of the synthetic Eta sources the benchmarks run on. Each one stresses
+// a different path of the lexer.
+enum class SourceShape {
+  // Short statements with many identifiers, keywords and operators.
+  kIdentifierHeavy,
+  // Long comment lines between short statements.
+  kCommentHeavy,
+  // Integer, character and string literals, some of them with escapes.
+  kLiteralHeavy,
+};
+
+// Returns a valid Eta source of the given shape, made of whole functions, with
+// at least 'size' bytes. The same arguments always produce the same source.
+std::string MakeBenchmarkSource(SourceShape shape, std::size_t size);
+
+// Name of 'shape', used to label the benchmarks.
+const char *GetSourceShapeName(SourceShape shape);
+
+// Reports the throughput of a benchmark that processes a source of
+// 'source_size' bytes made of 'token_count' tokens on every iteration, both in
+// bytes per second and in tokens per second.
+void SetSourceThroughput(benchmark::State &state, std::size_t source_size,
+                         std::size_t token_count);
@@ -0,0 +1,69 @@
+#include "senbonzakura/keywords.hpp"
+#include "senbonzakura/token_type.hpp"
+
+#include <functional>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace {
+
+// Mix of keywords and identifiers, in roughly the proportion they show up in
+// Eta programs.
+const std::vector<std::string_view> kLexemes{
+    "x",     "int",   "foo",    "if",     "length", "bar_baz", "return",
+    "i",     "while", "c3po",   "true",   "use",    "r2d2",    "else",
+    "bool",  "false", "args",   "result", "ints",   "n",       "lengths",
+    "print", "tmp'",  "if_not", "value",  "a",      "b",       "index",
+};
+
+// The keyword map the lexer used to build for every file.
+std::map<std::string, TokenType> MakeKeywordMap() {
+  return {
+      {"int", TokenType::kInt},       {"bool", TokenType::kBool},
+      {"if", TokenType::kIf},         {"else", TokenType::kElse},
+      {"while", TokenType::kWhile},   {"return", TokenType::kReturn},
+      {"true", TokenType::kTrue},     {"false", TokenType::kFalse},
+      {"length", TokenType::kLength}, {"use", TokenType::kUse},
+  };
+}
+
+void BM_KeywordLookupPerfectHash(benchmark::State &state) {
+  for (auto _ : state) {
+    for (std::string_view lexeme : kLexemes) {
+      benchmark::DoNotOptimize(LookupKeyword(lexeme));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kLexemes.size());
+}
+BENCHMARK(BM_KeywordLookupPerfectHash);
+
+void BM_KeywordLookupMap(benchmark::State &state) {
+  std::map<std::string, TokenType> keywords = MakeKeywordMap();
+  for (auto _ : state) {
+    for (std::string_view lexeme : kLexemes) {
+      // Mirrors the former 'Lexer::Identifier': build the lexeme string, then
+      // 'contains()' followed by 'operator[]'.
+      std::string lexeme_str{lexeme};
+      TokenType token_type = TokenType::kIdentifier;
+      if (keywords.contains(lexeme_str)) {
+        token_type = keywords[lexeme_str];
+      }
+      benchmark::DoNotOptimize(token_type);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kLexemes.size());
+}
+BENCHMARK(BM_KeywordLookupMap);
+
+void BM_KeywordMapConstruction(benchmark::State &state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(MakeKeywordMap());
+  }
+}
+BENCHMARK(BM_KeywordMapConstruction);
+
+} // namespace
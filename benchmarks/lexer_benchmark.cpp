@@ -0,0 +1,63 @@
+#include "senbonzakura/diagnostic_reporter.hpp"
+#include "senbonzakura/lexer.hpp"
+#include "senbonzakura/parallel_lexer.hpp"
+#include "senbonzakura/token.hpp"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "benchmark_support.hpp"
+
+namespace {
+
+// Arguments: the 'SourceShape' and the size of the source in bytes.
+void BM_LexTokens(benchmark::State &state) {
+  auto shape = static_cast<SourceShape>(state.range(0));
+  std::string source_code =
+      MakeBenchmarkSource(shape, static_cast<std::size_t>(state.range(1)));
+  std::vector<Token> tokens;
+
+  for (auto _ : state) {
+    DiagnosticReporter diagnostic_reporter;
+    Lexer lexer{"benchmark.eta", source_code, diagnostic_reporter};
+    tokens.clear();
+    lexer.LexTokens(tokens);
+    benchmark::DoNotOptimize(tokens.data());
+  }
+
+  SetSourceThroughput(state, source_code.size(), tokens.size());
+  state.SetLabel(GetSourceShapeName(shape));
+}
+BENCHMARK(BM_LexTokens)
+    ->ArgsProduct({{static_cast<long>(SourceShape::kIdentifierHeavy),
+                    static_cast<long>(SourceShape::kCommentHeavy),
+                    static_cast<long>(SourceShape::kLiteralHeavy)},
+                   {1 << 16, 1 << 20, 1 << 24}});
+
+// Arguments: the number of threads, over a 64 MiB identifier-heavy source.
+void BM_LexTokensInParallel(benchmark::State &state) {
+  std::string source_code =
+      MakeBenchmarkSource(SourceShape::kIdentifierHeavy, 1 << 26);
+  std::size_t token_count = 0;
+
+  for (auto _ : state) {
+    DiagnosticReporter diagnostic_reporter;
+    std::vector<Token> tokens =
+        LexTokensInParallel("benchmark.eta", source_code, diagnostic_reporter,
+                            static_cast<std::size_t>(state.range(0)));
+    token_count = tokens.size();
+    benchmark::DoNotOptimize(tokens.data());
+  }
+
+  SetSourceThroughput(state, source_code.size(), token_count);
+}
+BENCHMARK(BM_LexTokensInParallel)
+    ->RangeMultiplier(2)
+    ->Range(1, 16)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace
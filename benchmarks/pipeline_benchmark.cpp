@@ -0,0 +1,150 @@
+#include "senbonzakura/diagnostic_reporter.hpp"
+#include "senbonzakura/file_scanner.hpp"
+#include "senbonzakura/file_writer.hpp"
+#include "senbonzakura/lexer.hpp"
+#include "senbonzakura/line_table.hpp"
+#include "senbonzakura/token.hpp"
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "benchmark_support.hpp"
+
+namespace {
+
+// Source file written to the temporary directory for the benchmarks that go
+// through the file system. It is removed when the benchmark is done.
+class BenchmarkFile {
+public:
+  BenchmarkFile(SourceShape shape, std::size_t size)
+      : directory_{std::filesystem::temp_directory_path() /
+                   "senbonzakura_bench"},
+        source_code_{MakeBenchmarkSource(shape, size)} {
+    std::filesystem::create_directories(directory_);
+    path_ = (directory_ / "benchmark.eta").string();
+    std::ofstream{path_, std::ios::binary} << source_code_;
+  }
+  BenchmarkFile(const BenchmarkFile &) = delete;
+  BenchmarkFile &operator=(const BenchmarkFile &) = delete;
+  ~BenchmarkFile() { std::filesystem::remove_all(directory_); }
+
+  std::string GetDirectory() const { return directory_.string(); }
+  const std::string &GetPath() const { return path_; }
+  const std::string &GetSourceCode() const { return source_code_; }
+
+private:
+  std::filesystem::path directory_;
+  std::string path_;
+  std::string source_code_;
+};
+
+std::vector<Token> LexSourceCode(std::string_view source_code) {
+  DiagnosticReporter diagnostic_reporter;
+  Lexer lexer{"benchmark.eta", source_code, diagnostic_reporter};
+  std::vector<Token> tokens;
+  lexer.LexTokens(tokens);
+
+  return tokens;
+}
+
+// Argument: the size of the source in bytes. Every page is touched, since
+// the file is memory-mapped and would otherwise only be read by the lexer.
+void BM_ScanFile(benchmark::State &state) {
+  BenchmarkFile benchmark_file{SourceShape::kIdentifierHeavy,
+                               static_cast<std::size_t>(state.range(0))};
+
+  for (auto _ : state) {
+    DiagnosticReporter diagnostic_reporter;
+    FileScanner file_scanner{benchmark_file.GetPath(), diagnostic_reporter};
+    file_scanner.ScanFile();
+    std::string_view content = file_scanner.GetFileContentBytes();
+    char checksum = 0;
+    for (std::size_t i = 0; i < content.size(); i += 4096) {
+      checksum ^= content[i];
+    }
+    benchmark::DoNotOptimize(checksum);
+  }
+
+  state.SetBytesProcessed(state.iterations() *
+                          benchmark_file.GetSourceCode().size());
+}
+BENCHMARK(BM_ScanFile)->Arg(1 << 16)->Arg(1 << 20)->Arg(1 << 24);
+
+// Arguments: the 'SourceShape' and the size of the source in bytes.
+void BM_WriteLexerOutput(benchmark::State &state) {
+  auto shape = static_cast<SourceShape>(state.range(0));
+  BenchmarkFile benchmark_file{shape,
+                               static_cast<std::size_t>(state.range(1))};
+  std::vector<Token> tokens = LexSourceCode(benchmark_file.GetSourceCode());
+  std::vector<std::string> file_paths{benchmark_file.GetPath()};
+  FileWriter file_writer{file_paths, benchmark_file.GetDirectory()};
+
+  for (auto _ : state) {
+    file_writer.WriteLexerOutput(benchmark_file.GetPath(), tokens,
+                                 benchmark_file.GetSourceCode());
+  }
+
+  SetSourceThroughput(state, benchmark_file.GetSourceCode().size(),
+                      tokens.size());
+  state.SetLabel(GetSourceShapeName(shape));
+}
+BENCHMARK(BM_WriteLexerOutput)
+    ->ArgsProduct({{static_cast<long>(SourceShape::kIdentifierHeavy),
+                    static_cast<long>(SourceShape::kLiteralHeavy)},
+                   {1 << 20, 1 << 24}});
+
+// Argument: the 'SourceShape'. Formats the '.lexed' line of every token of a
+// 1 MiB source into a reused buffer, without any I/O.
+void BM_AppendTokenString(benchmark::State &state) {
+  auto shape = static_cast<SourceShape>(state.range(0));
+  std::string source_code = MakeBenchmarkSource(shape, 1 << 20);
+  std::vector<Token> tokens = LexSourceCode(source_code);
+  LineTable line_table{source_code};
+  std::string buffer;
+
+  for (auto _ : state) {
+    for (const Token &token : tokens) {
+      AppendTokenString(buffer, token, source_code,
+                        line_table.Resolve(token.offset_));
+      buffer += '\n';
+      if (buffer.size() >= (1 << 20)) {
+        buffer.clear();
+      }
+    }
+    benchmark::DoNotOptimize(buffer.data());
+  }
+
+  SetSourceThroughput(state, source_code.size(), tokens.size());
+  state.SetLabel(GetSourceShapeName(shape));
+}
+BENCHMARK(BM_AppendTokenString)
+    ->Arg(static_cast<long>(SourceShape::kIdentifierHeavy))
+    ->Arg(static_cast<long>(SourceShape::kLiteralHeavy));
+
+// Same as 'BM_AppendTokenString', with a new string for every token.
+void BM_TokenToString(benchmark::State &state) {
+  auto shape = static_cast<SourceShape>(state.range(0));
+  std::string source_code = MakeBenchmarkSource(shape, 1 << 20);
+  std::vector<Token> tokens = LexSourceCode(source_code);
+  LineTable line_table{source_code};
+
+  for (auto _ : state) {
+    for (const Token &token : tokens) {
+      benchmark::DoNotOptimize(TokenToString(token, source_code, line_table));
+    }
+  }
+
+  SetSourceThroughput(state, source_code.size(), tokens.size());
+  state.SetLabel(GetSourceShapeName(shape));
+}
+BENCHMARK(BM_TokenToString)
+    ->Arg(static_cast<long>(SourceShape::kIdentifierHeavy))
+    ->Arg(static_cast<long>(SourceShape::kLiteralHeavy));
+
+} // namespace
@@ -0,0 +1,25 @@
+# Escreve em OUTPUT um cabeçalho definindo 'SENBONZAKURA_BUILD_ID' como o hash
+# do conteúdo de SOURCES (separados por '|') e de PROJECT_VERSION. Roda a cada
+# build em que alguma dessas fontes mudou, e só reescreve o cabeçalho quando o
+# hash muda, para não recompilar quem o inclui à toa.
+string(REPLACE "|" ";" source_files "${SOURCES}")
+set(source_hashes "${PROJECT_VERSION}")
+foreach(source_file IN LISTS source_files)
+  file(SHA256 "${source_file}" source_hash)
+  string(APPEND source_hashes "\n${source_hash}")
+endforeach()
+string(SHA256 build_id "${source_hashes}")
+
+set(header_content
+"#pragma once
+
+// Generated by 'lib/cmake/generate_build_id.cmake'. Do not edit.
+#define SENBONZAKURA_BUILD_ID \"senbonzakura-${PROJECT_VERSION}-${build_id}\"
+")
+
+if(EXISTS "${OUTPUT}")
+  file(READ "${OUTPUT}" previous_content)
+endif()
+if(NOT previous_content STREQUAL header_content)
+  file(WRITE "${OUTPUT}" "${header_content}")
+endif()
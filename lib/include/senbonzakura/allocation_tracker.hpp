@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Counts the heap allocations of every thread. The counts are only fed when
+// the executable replaces the global 'operator new' and 'operator delete' with
+// hooks that call 'RecordAllocation' and 'RecordDeallocation', which the
+// 'senbonzakura' executable does when built with
+// 'SENBONZAKURA_TRACK_ALLOCATIONS'. Otherwise every count stays at zero.
+//
+// Counts are kept per thread, without any synchronization, so memory freed on
+// another thread than the one that allocated it is not subtracted from the live
+// bytes of the allocating thread.
+
+// Allocations made while an 'AllocationScope' was active.
+struct AllocationCounters {
+  std::uint64_t allocation_count = 0;
+  std::uint64_t allocated_bytes = 0;
+  // Largest amount of memory allocated during the scope and not yet freed.
+  std::uint64_t peak_live_bytes = 0;
+};
+
+// Called by the allocation hooks. They must not allocate.
+void RecordAllocation(std::size_t size);
+void RecordDeallocation(std::size_t size);
+
+// Called once by the allocation hooks, before 'main' starts.
+void MarkAllocationHooksInstalled();
+bool AreAllocationHooksInstalled();
+
+// Measures the allocations of the calling thread between its construction and
+// the call to 'Stop'. Scopes can be nested.
+class AllocationScope {
+public:
+  AllocationScope();
+
+  AllocationScope(const AllocationScope &) = delete;
+  AllocationScope &operator=(const AllocationScope &) = delete;
+
+  AllocationCounters Stop();
+
+private:
+  std::uint64_t start_allocation_count_;
+  std::uint64_t start_allocated_bytes_;
+  std::int64_t start_live_bytes_;
+  // Peak of the enclosing scope, which is restored when this one stops.
+  std::int64_t enclosing_peak_live_bytes_;
+};
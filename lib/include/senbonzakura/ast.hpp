@@ -0,0 +1,182 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "senbonzakura/string_interner.hpp"
+#include "senbonzakura/token_type.hpp"
+
+// Position of a node in 'Ast::nodes_'. Children are referred to by index
+// rather than by pointer, which halves their size and keeps the whole tree in
+// a few contiguous arrays.
+using AstIndex = std::uint32_t;
+
+inline constexpr AstIndex kNoAstIndex = std::numeric_limits<AstIndex>::max();
+
+// Run of 'count' indices starting at 'begin' in 'Ast::children_', used by the
+// nodes with a variable number of children.
+struct AstRange {
+  std::uint32_t begin;
+  std::uint32_t count;
+};
+
+enum class AstNodeKind : std::uint8_t {
+  // 'range': the 'kUse' nodes followed by the 'kFunction' and
+  // 'kGlobalDeclaration' nodes, in source order.
+  kProgram,
+  // 'symbol': the name of the interface.
+  kUse,
+  // 'pair.first': index in 'Ast::functions_'.
+  kFunction,
+  // 'pair': the 'kDeclaration' node and the literal value, or 'kNoAstIndex'.
+  kGlobalDeclaration,
+  // 'pair': the 'kIdentifier' node of the name and the type. Used for
+  // parameters, global variables and local variables.
+  kDeclaration,
+
+  // Types. 'kArrayType' has the element type and the length expression, or
+  // 'kNoAstIndex', in 'pair'.
+  kIntType,
+  kBoolType,
+  kArrayType,
+
+  // Statements.
+  // 'range': the statements.
+  kBlock,
+  // 'pair.first': index in 'Ast::if_statements_'.
+  kIf,
+  // 'pair': the condition and the body.
+  kWhile,
+  // 'range': the returned values.
+  kReturn,
+  // 'pair.first': index in 'Ast::assignments_'. Also represents declarations
+  // of several variables without any value.
+  kAssignment,
+  // The pseudo-variable '_' on the left-hand side of an assignment.
+  kDiscard,
+
+  // Expressions. A procedure call statement is a 'kCall' node.
+  // 'symbol'.
+  kIdentifier,
+  // 'integer_value': the magnitude, as in 'TokenValue'.
+  kInteger,
+  // 'character_value'.
+  kCharacter,
+  // 'symbol': the decoded contents.
+  kString,
+  // 'boolean_value'.
+  kBoolean,
+  // 'range': the elements.
+  kArrayLiteral,
+  // 'pair.first': the operand. 'operator_type' is 'kMinus' or 'kBang'.
+  kUnary,
+  // 'pair': the operands. 'operator_type' is the token type of the operator.
+  kBinary,
+  // 'range': the 'kIdentifier' node of the function followed by the
+  // arguments.
+  kCall,
+  // 'pair': the array and the index.
+  kIndex,
+  // 'pair.first': the array.
+  kLength,
+
+  // Code that could not be parsed, after a syntax error. Only 'offset' is
+  // set, and it can stand for any declaration, type, statement or expression.
+  kError,
+};
+
+// A node is 16 bytes long. Kinds with more than two fixed children keep them
+// in a side table of 'Ast' instead, so that the common nodes stay small.
+struct AstNode {
+  AstNodeKind kind;
+  TokenType operator_type;
+  // Offset of the first token of the node in the source code.
+  std::uint32_t offset;
+  union {
+    struct {
+      AstIndex first;
+      AstIndex second;
+    } pair;
+    AstRange range;
+    std::uint64_t integer_value;
+    Symbol symbol;
+    char character_value;
+    bool boolean_value;
+  };
+};
+
+static_assert(sizeof(AstNode) == 16);
+
+struct AstFunction {
+  Symbol name;
+  // 'kDeclaration' nodes.
+  AstRange parameters;
+  // Type nodes. Empty for procedures.
+  AstRange return_types;
+  AstIndex body;
+};
+
+struct AstIf {
+  AstIndex condition;
+  AstIndex then_branch;
+  // 'kNoAstIndex' without an 'else'.
+  AstIndex else_branch;
+};
+
+struct AstAssignment {
+  // 'kDeclaration', 'kDiscard', 'kIdentifier' and 'kIndex' nodes.
+  AstRange targets;
+  AstRange values;
+};
+
+// Abstract syntax tree of a source file, stored as flat arrays: the nodes,
+// the child lists of the nodes with a variable number of children, and one
+// side table per kind of node with more than two children. A tree costs a few
+// large allocations, however many nodes it has, and is walked through
+// indices into contiguous memory.
+class Ast {
+public:
+  // Reserves room for the tree of a file with 'token_count' tokens, which has
+  // about as many nodes, so that building it seldom reallocates.
+  void Reserve(std::size_t token_count);
+
+  AstIndex AddNode(AstNodeKind kind, std::uint32_t offset);
+  AstIndex AddPairNode(AstNodeKind kind, std::uint32_t offset, AstIndex first,
+                       AstIndex second = kNoAstIndex);
+  // 'children' are copied to the child lists, so they can live in a scratch
+  // buffer that is reused for every list.
+  AstIndex AddRangeNode(AstNodeKind kind, std::uint32_t offset,
+                        std::span<const AstIndex> children);
+  AstIndex AddFunction(std::uint32_t offset, Symbol name,
+                       std::span<const AstIndex> parameters,
+                       std::span<const AstIndex> return_types, AstIndex body);
+  AstIndex AddIf(std::uint32_t offset, AstIndex condition, AstIndex then_branch,
+                 AstIndex else_branch);
+  AstIndex AddAssignment(std::uint32_t offset,
+                         std::span<const AstIndex> targets,
+                         std::span<const AstIndex> values);
+  AstNode &GetNode(AstIndex index);
+  void SetRoot(AstIndex root);
+
+  const AstNode &GetNode(AstIndex index) const;
+  std::span<const AstIndex> GetChildren(AstRange range) const;
+  const AstFunction &GetFunction(const AstNode &node) const;
+  const AstIf &GetIf(const AstNode &node) const;
+  const AstAssignment &GetAssignment(const AstNode &node) const;
+  // The 'kProgram' node, or 'kNoAstIndex' before the tree is complete.
+  AstIndex GetRoot() const;
+  std::size_t GetNodeCount() const;
+
+private:
+  AstRange AddChildren(std::span<const AstIndex> children);
+
+  std::vector<AstNode> nodes_;
+  std::vector<AstIndex> children_;
+  std::vector<AstFunction> functions_;
+  std::vector<AstIf> if_statements_;
+  std::vector<AstAssignment> assignments_;
+  AstIndex root_ = kNoAstIndex;
+};
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "senbonzakura/token.hpp"
+
+// Must be bumped whenever a change to the compiler alters the output of a
+// cached phase for the same source code, so that older entries are ignored.
+inline constexpr std::uint32_t kBuildCacheVersion = 1;
+
+// On-disk cache of the outputs of the compilation phases, keyed by the hash of
+// the source code they were produced from. A cached file skips scanning,
+// lexing and parsing, and goes straight to writing its outputs.
+//
+// Every entry is written to a temporary file that is then renamed over its
+// final name, so readers never see a partially written entry and several
+// processes can share the same cache directory. Failing to read or write the
+// cache is never an error: the file is simply compiled again.
+class BuildCache {
+public:
+  // Key of the entries of 'source_code', mixing the hash of its bytes with
+  // the cache and format versions and the identity of the compiler build.
+  // No 'CompilationOptions' field is part of it: the lexer produces the same
+  // tokens with any number of threads, and only files without diagnostics are
+  // cached, so the error limit and the sink never change an entry either.
+  struct Key {
+    std::uint64_t hash;
+
+    bool operator==(const Key &other) const = default;
+  };
+
+  explicit BuildCache(std::string directory);
+
+  const std::string &GetDirectory() const;
+  static Key ComputeKey(std::string_view source_code);
+
+  // Returns the tokens stored for 'key', or nothing when there is no valid
+  // entry for a source code of 'source_size' bytes.
+  std::optional<std::vector<Token>> LoadTokens(Key key,
+                                               std::size_t source_size) const;
+  // Stores 'tokens', lexed from 'source_code', under 'key'. Returns false if
+  // the entry could not be written.
+  bool StoreTokens(Key key, const std::vector<Token> &tokens,
+                   std::string_view source_code) const;
+
+private:
+  std::string GetEntryPath(Key key, std::string_view extension) const;
+
+  std::string directory_;
+};
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "senbonzakura/diagnostic_reporter.hpp"
+#include "senbonzakura/file_writer.hpp"
+#include "senbonzakura/perf_counters.hpp"
+#include "senbonzakura/time_report.hpp"
+
+struct CompilationOptions {
+  // Number of files compiled at the same time.
+  std::size_t job_count = 1;
+  // Number of threads used to lex a single large file.
+  std::size_t lex_thread_count = 1;
+  // Which lexer outputs are written: the '.lexed' text and the '.lexedb'
+  // binary token stream.
+  bool emit_lexed = true;
+  bool emit_lexedb = false;
+  // Whether the '.parsed' S-expression of the syntax tree is written, and
+  // whether it is pretty-printed.
+  bool emit_parsed = false;
+  bool pretty_print_parsed = false;
+  // Directory of the 'BuildCache'. The cache is disabled when it is empty.
+  std::string cache_directory = {};
+  // Whether the hardware events of every phase are counted, which costs a few
+  // system calls per phase.
+  bool measure_perf_counters = false;
+  // Maximum number of errors kept for every file (see
+  // 'DiagnosticReporter::SetErrorLimit'). 0 means no limit.
+  std::size_t max_error_count = 0;
+  // Where the diagnostics of every file are streamed as they are reported,
+  // besides being kept in its result. Shared by every thread.
+  DiagnosticSink *diagnostic_sink = nullptr;
+};
+
+// Everything the compilation of one file produced that outlives it. The
+// tokens and the source code are released as soon as the file is done.
+struct FileCompilationResult {
+  std::string file_path;
+  DiagnosticReporter diagnostic_reporter;
+  // Whether the outputs were produced from the build cache, skipping the
+  // lexer, and the parser unless the '.parsed' output is written.
+  bool is_cached = false;
+  // Time spent in every phase, and the size of the file in bytes and tokens.
+  TimeReport time_report;
+  // Events counted in every phase, when 'measure_perf_counters' is set.
+  PerfCounterReport perf_counter_report;
+
+  // A file fails when it has errors. Warnings alone do not make it fail.
+  bool HasFailed() const;
+};
+
+// Scans, lexes and parses the file at 'file_path', writing the outputs
+// selected by 'options' through 'file_writer'. Uses its own
+// 'DiagnosticReporter', so it can run on any thread.
+FileCompilationResult CompileFile(const std::string &file_path,
+                                  const FileWriter &file_writer,
+                                  const CompilationOptions &options);
+
+// Compiles every file of 'file_paths' on 'options.job_count' threads and
+// hands each result to 'on_file_compiled', on the calling thread and in the
+// order of 'file_paths', so the output does not depend on the scheduling.
+// Returns the number of files that failed.
+std::size_t CompileFiles(
+    const std::vector<std::string> &file_paths, const FileWriter &file_writer,
+    const CompilationOptions &options,
+    const std::function<void(const FileCompilationResult &)>
+        &on_file_compiled);
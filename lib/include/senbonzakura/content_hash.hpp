@@ -0,0 +1,9 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+// 64-bit XXH64 hash of 'bytes'. It is not a cryptographic hash: it identifies
+// the contents of a file in the build cache, where it only has to tell apart
+// different versions of the same sources, at several GB/s.
+std::uint64_t HashContent(std::string_view bytes, std::uint64_t seed = 0);
@@ -1,10 +1,15 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <format>
-#include <sstream>
+#include <ostream>
 #include <string>
+#include <string_view>
 #include <vector>
 
+#include "senbonzakura/string_interner.hpp"
+
 const std::string kAnsiRed = "\033[31m";
 const std::string kAnsiGreen = "\033[32m";
 const std::string kAnsiReset = "\033[0m";
@@ -33,57 +38,121 @@ struct std::formatter<Severity, char> : std::formatter<std::string, char> {
   }
 };
 
+// Position of a diagnostic within a source file. The file is identified by the
+// interned symbol of its path, so a location is 20 bytes long and copying it
+// never allocates. 'line' and 'column' are resolved from 'offset' by whoever
+// reports the diagnostic, since it has the source code at hand, and are kept
+// because the source is released long before the diagnostic is output.
 struct SourceCodeLocation {
-  std::string source_name;
-  std::size_t line;
-  std::size_t column;
+  Symbol file;
+  std::uint32_t line;
+  std::uint32_t column;
+  // Byte range of the diagnosed code, from the start of the file.
+  std::uint32_t offset = 0;
+  std::uint32_t length = 0;
 
   friend std::ostream &
   operator<<(std::ostream &os, const SourceCodeLocation &source_code_location);
 };
 
-template <>
-struct std::formatter<SourceCodeLocation, char>
-    : std::formatter<std::string, char> {
-  auto format(const SourceCodeLocation &loc, auto &ctx) const {
-    std::stringstream ss;
-    ss << loc;
-    return std::formatter<std::string, char>::format(ss.str(), ctx);
-  }
+// Text of a diagnostic, which is only formatted when it is output. 'format' is
+// not copied, so it must be a string literal, and is formatted with 'argument'
+// as its only argument. Diagnostics are mostly a literal plus a short lexeme,
+// so reporting one seldom allocates, and the ones dropped by the error limit
+// are never formatted at all.
+struct DiagnosticMessage {
+  std::string_view format = "{}";
+  std::string argument;
+
+  // Appends the formatted text to 'output'.
+  void FormatTo(std::string &output) const;
 };
 
+// Removes the '[E]: ' or '[W]: ' tag that starts most messages, which only
+// repeats the severity, for the outputs that show the severity on their own.
+std::string_view StripSeverityTag(std::string_view message);
+
 struct CompilerError {
-  std::string compiler_error_message;
-  SourceCodeLocation source_code_location;
-  Severity compiler_error_severity;
+  DiagnosticMessage message;
+  SourceCodeLocation location;
+  Severity severity;
 
   friend std::ostream &operator<<(std::ostream &os,
                                   const CompilerError &compiler_error);
 };
 
 struct SystemError {
-  std::string system_error_message;
-  Severity system_error_severity;
+  DiagnosticMessage message;
+  Severity severity;
 
   friend std::ostream &operator<<(std::ostream &os,
                                   const SystemError &system_error);
 };
 
+class DiagnosticSink;
+
+// Collects the diagnostics of a unit of work, such as a file or a chunk of a
+// file being lexed. A reporter is not synchronized: every thread reports into
+// its own, without any lock, and the reporters are then merged with 'Merge' in
+// a fixed order (see 'LexTokensInParallel' and 'CompileFiles'), so the output
+// never depends on the scheduling.
 class DiagnosticReporter {
 private:
+  void CountDiagnostic(Severity sev);
+  // Stores 'compiler_error', unless it is an error past the error limit, which
+  // is only counted as suppressed.
+  void KeepCompilerError(CompilerError compiler_error);
+
   std::vector<CompilerError> compiler_errors_;
   std::vector<SystemError> system_errors_;
-  int warning_count_ = 0;
-  int normal_error_count_ = 0;
-  int fatal_error_count_ = 0;
+  std::size_t warning_count_ = 0;
+  std::size_t normal_error_count_ = 0;
+  std::size_t fatal_error_count_ = 0;
+  // Errors, fatal or not, that were stored and that were only counted.
+  std::size_t kept_error_count_ = 0;
+  std::size_t suppressed_error_count_ = 0;
+  // Maximum number of errors kept. 0 means no limit.
+  std::size_t error_limit_ = 0;
+  DiagnosticSink *sink_ = nullptr;
 
 public:
+  // Keeps at most 'error_limit' errors, and fatal errors, so that a garbage
+  // input cannot flood the output. Further errors are still counted, and
+  // summarized by 'OutputCompilerErrors'. Warnings are always kept. 0 disables
+  // the limit, which is the default.
+  void SetErrorLimit(std::size_t error_limit);
+  // Whether errors are being dropped already, so that a producer can stop
+  // looking for more of them.
+  bool HasReachedErrorLimit() const;
+  std::size_t GetSuppressedErrorCount() const;
+  // Streams every diagnostic that is kept from now on to 'sink', whether it is
+  // reported or merged, besides storing it. The sink must outlive the
+  // reporter, and can be shared by reporters of different threads.
+  void SetSink(DiagnosticSink *sink);
+  // Streams to the sink how many errors of the file at 'file_path' were past
+  // the error limit, as the summary of 'OutputCompilerErrors' does, once the
+  // file is done. Does nothing when no error was suppressed.
+  void StreamSuppressedErrorCount(std::string_view file_path) const;
+
+  // 'msg' is already formatted. The overloads taking a 'DiagnosticMessage'
+  // defer the formatting until the diagnostic is output.
   void ReportCompilerError(SourceCodeLocation loc, Severity sev,
                            std::string msg);
+  void ReportCompilerError(SourceCodeLocation loc, Severity sev,
+                           DiagnosticMessage msg);
   void ReportSystemError(Severity sev, std::string msg);
+  void ReportSystemError(Severity sev, DiagnosticMessage msg);
+  // Appends every diagnostic of 'other' after the ones reported so far, within
+  // the error limit of this reporter.
+  void Merge(const DiagnosticReporter &other);
   bool HasWarnings() const;
   bool HasNormalErrors() const;
   bool HasFatalErrors() const;
+  // The diagnostics that were kept, in the order in which they were reported
+  // or merged.
+  const std::vector<CompilerError> &GetCompilerErrors() const;
+  // Both write all of their diagnostics to 'std::cout' at once, without
+  // flushing it.
   void OutputCompilerErrors() const;
   void OutputSystemErrors() const;
 };
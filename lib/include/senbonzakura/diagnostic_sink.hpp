@@ -0,0 +1,84 @@
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include "senbonzakura/diagnostic_reporter.hpp"
+
+// Receives every diagnostic as soon as it enters a 'DiagnosticReporter' that
+// streams to it (see 'DiagnosticReporter::SetSink'), so that a tool reading
+// the stream can react to the first fatal error while the other files are
+// still being compiled. Reporters of different threads share a sink, so
+// diagnostics of different files may interleave, but every record is written
+// whole.
+class DiagnosticSink {
+public:
+  virtual ~DiagnosticSink() = default;
+
+  void Emit(const CompilerError &compiler_error);
+  void Emit(const SystemError &system_error);
+  // Completes the output, after the last diagnostic.
+  void Finish();
+  // Whether writing to the file descriptor has failed at least once.
+  bool HasWriteError() const;
+
+protected:
+  // Records are written with a single 'write' each, and never closes 'fd'.
+  explicit DiagnosticSink(int fd);
+
+  // Both append the record of a diagnostic to 'record_'. 'message' is the
+  // formatted message, without its '[E]: ' or '[W]: ' tag.
+  virtual void AppendRecord(const CompilerError &compiler_error,
+                            std::string_view message) = 0;
+  virtual void AppendRecord(const SystemError &system_error,
+                            std::string_view message) = 0;
+  virtual void AppendEnd();
+  // Writes 'record_' and clears it. Must be called with 'mutex_' held, or
+  // before the sink is shared.
+  void WriteRecord();
+
+  std::string record_;
+
+private:
+  int fd_;
+  std::mutex mutex_;
+  // Reused by every diagnostic, so that emitting one seldom allocates.
+  std::string message_;
+  bool has_write_error_ = false;
+};
+
+// Writes every diagnostic as a JSON object on its own line:
+//   {"severity":"fatal","file":"main.eta","line":2,"column":10,"offset":9,
+//    "length":3,"message":"..."}
+// System errors have no location, so they only have the severity and the
+// message.
+class JsonLinesDiagnosticSink : public DiagnosticSink {
+public:
+  explicit JsonLinesDiagnosticSink(int fd);
+
+protected:
+  void AppendRecord(const CompilerError &compiler_error,
+                    std::string_view message) override;
+  void AppendRecord(const SystemError &system_error,
+                    std::string_view message) override;
+};
+
+// Writes a SARIF 2.1.0 log with a single run, whose results are written as
+// they are reported. The log is only valid JSON once 'Finish' is called.
+class SarifDiagnosticSink : public DiagnosticSink {
+public:
+  explicit SarifDiagnosticSink(int fd);
+
+protected:
+  void AppendRecord(const CompilerError &compiler_error,
+                    std::string_view message) override;
+  void AppendRecord(const SystemError &system_error,
+                    std::string_view message) override;
+  void AppendEnd() override;
+
+private:
+  void AppendResultStart(Severity severity, std::string_view message);
+
+  bool has_results_ = false;
+};
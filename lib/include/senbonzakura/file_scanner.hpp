@@ -1,20 +1,24 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 
 #include "senbonzakura/diagnostic_reporter.hpp"
+#include "senbonzakura/source_buffer.hpp"
 
 class FileScanner {
 private:
   std::string file_path_;
-  std::string file_content_bytes_;
+  SourceBuffer source_buffer_;
   DiagnosticReporter &diagnostic_reporter_;
 
 public:
   FileScanner(std::string file_path, DiagnosticReporter &diagnostic_reporter);
 
   const DiagnosticReporter &GetDiagnosticReporter() const;
-  const std::string &GetFileContentBytes() const;
+  // The returned view stays valid for as long as the scanner, and is always
+  // followed by a readable '\0' (see 'SourceBuffer').
+  std::string_view GetFileContentBytes() const;
   const std::string &GetFilePath() const;
   void ScanFile();
 };
@@ -1,8 +1,11 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 
+#include "senbonzakura/ast.hpp"
+#include "senbonzakura/diagnostic_reporter.hpp"
 #include "senbonzakura/token.hpp"
 
 class FileWriter {
@@ -10,11 +13,33 @@ private:
   const std::string output_directory_;
   const std::vector<std::string> &eta_programs_filepaths_;
 
+  // Path of the output file of 'current_eta_filepath_str' with the given
+  // extension, inside the output directory.
+  std::string GetOutputFilePath(const std::string &current_eta_filepath_str,
+                                std::string_view extension) const;
+
 public:
   FileWriter(const std::vector<std::string> &eta_programs_filepaths,
              const std::string output_directory = "");
   const std::vector<std::string> &GetProgramFilepaths() const;
   const std::string &GetOutputDirectory() const;
   void WriteLexerOutput(const std::string &current_eta_filepath_str,
-                        std::vector<Token> tokens) const;
+                        const std::vector<Token> &tokens,
+                        std::string_view source_code) const;
+  // Writes the binary '.lexedb' counterpart of the '.lexed' output (see
+  // 'lexedb.hpp').
+  void WriteLexedbOutput(const std::string &current_eta_filepath_str,
+                         const std::vector<Token> &tokens,
+                         std::string_view source_code) const;
+  // Writes the '.parsed' S-expression of 'ast', which must be a complete tree
+  // without 'kError' nodes. The tree is walked without recursion, so any
+  // nesting that the parser accepts can be written. With 'is_pretty_printed',
+  // every definition and statement starts on its own line, indented by its
+  // depth. Otherwise the whole tree is written on one line.
+  void WriteParserOutput(const std::string &current_eta_filepath_str,
+                         const Ast &ast, bool is_pretty_printed) const;
+  // Writes the '.parsed' output of a file that could not be parsed, which is
+  // only the line and column of 'compiler_error' and its message.
+  void WriteParserError(const std::string &current_eta_filepath_str,
+                        const CompilerError &compiler_error) const;
 };
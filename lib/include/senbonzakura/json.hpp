@@ -0,0 +1,9 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+// Appends 'string' to 'output' as a JSON string literal, quotes included.
+// Control characters are escaped, and bytes outside of ASCII are copied as
+// they are, so UTF-8 input stays valid UTF-8.
+void AppendJsonString(std::string &output, std::string_view string);
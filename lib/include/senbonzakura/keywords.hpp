@@ -0,0 +1,98 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "senbonzakura/token_type.hpp"
+
+struct Keyword {
+  std::string_view lexeme;
+  TokenType token_type;
+};
+
+inline constexpr std::array kKeywords{
+    Keyword{"int", TokenType::kInt},
+    Keyword{"bool", TokenType::kBool},
+    Keyword{"if", TokenType::kIf},
+    Keyword{"else", TokenType::kElse},
+    Keyword{"while", TokenType::kWhile},
+    Keyword{"return", TokenType::kReturn},
+    Keyword{"true", TokenType::kTrue},
+    Keyword{"false", TokenType::kFalse},
+    Keyword{"length", TokenType::kLength},
+    Keyword{"use", TokenType::kUse},
+};
+
+// Perfect hash over 'kKeywords', keyed on the length and the first and last
+// characters of a lexeme. The multipliers are searched at compile time, so
+// the table stays collision-free if the keyword set ever changes.
+class KeywordTable {
+public:
+  static constexpr std::size_t kSize = 32;
+
+  consteval KeywordTable() {
+    for (std::uint32_t length_multiplier = 1; length_multiplier < kSize;
+         length_multiplier++) {
+      for (std::uint32_t last_multiplier = 1; last_multiplier < kSize;
+           last_multiplier++) {
+        length_multiplier_ = length_multiplier;
+        last_multiplier_ = last_multiplier;
+        if (TryFill()) {
+          return;
+        }
+      }
+    }
+    throw "Could not find a perfect hash for the Eta keywords.";
+  }
+
+  // Returns the keyword token type of 'lexeme', or 'kIdentifier' when it is
+  // not a keyword. Performs a single string comparison and no allocation.
+  constexpr TokenType Lookup(std::string_view lexeme) const {
+    if (lexeme.length() < kMinLength || lexeme.length() > kMaxLength) {
+      return TokenType::kIdentifier;
+    }
+    const Keyword &entry = entries_[Hash(lexeme)];
+
+    return entry.lexeme == lexeme ? entry.token_type : TokenType::kIdentifier;
+  }
+
+private:
+  static constexpr std::size_t kMinLength = 2;
+  static constexpr std::size_t kMaxLength = 6;
+
+  constexpr std::size_t Hash(std::string_view lexeme) const {
+    return (lexeme.length() * length_multiplier_ +
+            static_cast<unsigned char>(lexeme.front()) +
+            static_cast<unsigned char>(lexeme.back()) * last_multiplier_) %
+           kSize;
+  }
+
+  consteval bool TryFill() {
+    entries_.fill(Keyword{"", TokenType::kIdentifier});
+    for (const Keyword &keyword : kKeywords) {
+      if (keyword.lexeme.length() < kMinLength ||
+          keyword.lexeme.length() > kMaxLength) {
+        throw "A keyword does not fit the length bounds of the keyword table.";
+      }
+      Keyword &entry = entries_[Hash(keyword.lexeme)];
+      if (!entry.lexeme.empty()) {
+        return false;
+      }
+      entry = keyword;
+    }
+
+    return true;
+  }
+
+  std::array<Keyword, kSize> entries_{};
+  std::uint32_t length_multiplier_ = 1;
+  std::uint32_t last_multiplier_ = 1;
+};
+
+inline constexpr KeywordTable kKeywordTable{};
+
+constexpr TokenType LookupKeyword(std::string_view lexeme) {
+  return kKeywordTable.Lookup(lexeme);
+}
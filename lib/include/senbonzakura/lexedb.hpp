@@ -0,0 +1,120 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "senbonzakura/diagnostic_reporter.hpp"
+#include "senbonzakura/line_table.hpp"
+#include "senbonzakura/source_buffer.hpp"
+#include "senbonzakura/string_interner.hpp"
+#include "senbonzakura/token.hpp"
+#include "senbonzakura/token_stream.hpp"
+
+// Binary counterpart of the '.lexed' output. A '.lexedb' file is made of the
+// following sections, in this order, each one starting at a multiple of 8
+// bytes:
+//
+//   - A 'LexedbHeader'.
+//   - 'token_count' 'LexedbTokenRecord's.
+//   - 'line_count' 32-bit offsets at which the lines of the source start.
+//   - 'string_count' 'LexedbStringRecord's, one for every distinct identifier
+//     and decoded string literal.
+//   - 'string_pool_size' bytes holding the contents of those strings.
+//
+// Every field is stored in the byte order of the machine that wrote the file,
+// which is recorded in the header. The sizes of the sections follow from the
+// header alone, so the file is read in place, without any parsing.
+inline constexpr std::array<char, 8> kLexedbMagic = {'E', 'T', 'A', 'L',
+                                                     'E', 'X', 'D', 'B'};
+inline constexpr std::uint32_t kLexedbVersion = 1;
+inline constexpr std::uint32_t kLexedbByteOrderMark = 0x01020304;
+
+struct LexedbHeader {
+  std::array<char, 8> magic;
+  std::uint32_t version;
+  std::uint32_t byte_order_mark;
+  std::uint32_t source_size;
+  std::uint32_t token_count;
+  std::uint32_t line_count;
+  std::uint32_t string_count;
+  std::uint32_t string_pool_size;
+  std::uint32_t reserved;
+};
+
+// 'value' holds the magnitude of a 'kInteger', 0 or 1 for 'kFalse' and
+// 'kTrue', the byte of a 'kCharacter', and the index of the string record of
+// a 'kIdentifier' or a 'kString'. It is 0 for every other token type.
+struct LexedbTokenRecord {
+  std::uint32_t offset;
+  std::uint32_t length;
+  std::uint8_t token_type;
+  std::array<std::uint8_t, 7> padding;
+  std::uint64_t value;
+};
+
+// Position of a string inside the string pool.
+struct LexedbStringRecord {
+  std::uint32_t offset;
+  std::uint32_t length;
+};
+
+static_assert(sizeof(LexedbHeader) == 40);
+static_assert(sizeof(LexedbTokenRecord) == 24);
+static_assert(sizeof(LexedbStringRecord) == 8);
+
+// Returns the '.lexedb' representation of 'tokens', lexed from 'source_code'.
+// Tokens cut short by a lexical error are followed by a 'kFileEnd' record.
+std::string SerializeLexedb(const std::vector<Token> &tokens,
+                            std::string_view source_code);
+
+// Read-only view of a '.lexedb' file. The file is memory-mapped and checked
+// once when it is loaded, after which records are read from the mapping as
+// they are requested.
+class LexedbReader {
+public:
+  // Loads the '.lexedb' file at 'file_path'. Returns false, reporting the
+  // reason to 'diagnostic_reporter', when the file cannot be read or is not a
+  // valid '.lexedb' file.
+  bool Load(const std::string &file_path,
+            DiagnosticReporter &diagnostic_reporter);
+
+  std::size_t GetSourceSize() const;
+  std::size_t GetTokenCount() const;
+  // Returns the token at 'index'. Identifiers and string literals are interned
+  // into 'GetStringInterner()' the first time they are needed.
+  Token GetToken(std::size_t index);
+  std::size_t GetLineCount() const;
+  // Same as 'LineTable::Resolve' over the source the tokens were lexed from.
+  LineColumn Resolve(std::size_t offset) const;
+  std::size_t GetStringCount() const;
+  std::string_view GetString(std::size_t index) const;
+
+private:
+  LexedbTokenRecord GetTokenRecord(std::size_t index) const;
+  std::uint32_t GetLineStart(std::size_t index) const;
+
+  SourceBuffer source_buffer_;
+  LexedbHeader header_{};
+  const char *token_records_ = nullptr;
+  const char *line_starts_ = nullptr;
+  const char *string_records_ = nullptr;
+  const char *string_pool_ = nullptr;
+  // Symbol of every string record, filled in lazily.
+  std::vector<Symbol> symbols_;
+};
+
+// Token stream over the tokens of a loaded '.lexedb' file, so that they can be
+// handed to the 'Parser' without lexing the source again.
+class LexedbTokenStream : public TokenStream {
+private:
+  LexedbReader &lexedb_reader_;
+  std::size_t next_ = 0;
+
+public:
+  explicit LexedbTokenStream(LexedbReader &lexedb_reader);
+  Token NextToken() override;
+};
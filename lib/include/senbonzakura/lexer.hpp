@@ -1,55 +1,78 @@
 #pragma once
 
-#include <any>
-#include <map>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "senbonzakura/diagnostic_reporter.hpp"
+#include "senbonzakura/line_table.hpp"
+#include "senbonzakura/simd_scanner.hpp"
+#include "senbonzakura/string_interner.hpp"
 #include "senbonzakura/token.hpp"
+#include "senbonzakura/token_stream.hpp"
 #include "senbonzakura/token_type.hpp"
 
-class Lexer {
+class Lexer : public TokenStream {
 private:
-  void AddToken(TokenType token_type);
-  void AddToken(TokenType token_type, std::any value);
+  void AddToken(TokenType token_type, TokenValue value = {});
   char Advance();
+  // Location of the bytes in [begin, end) of the source code.
+  SourceCodeLocation GetSourceCodeLocation(std::size_t begin, std::size_t end);
   void Character();
   void Comment();
+  // Decodes the escape sequence whose '\' has just been consumed. Returns
+  // false after reporting an error if it is not valid.
+  bool EscapeSequence(char &value);
   void Identifier();
   void Integer();
-  bool IsAlpha(char c);
-  bool IsAlphaNumeric(char c);
   bool IsAtEnd();
-  bool IsHexDigit(char c);
-  bool IsDigit(char c);
   void LexToken();
-  bool Match(char expected);
   char Peek(std::size_t offset);
+  void Operator();
   void ReportError(const std::string& message, unsigned int col_offset);
   void String();
-  void UpdateColumnNumber();
+  void Whitespace();
 
   std::size_t current_ = 0;
   std::size_t start_ = 0;
-  std::size_t line_ = 1;
-  std::size_t column_ = 1;
-  std::size_t column_delta_ = 1;
+  std::size_t end_ = 0;
   std::string file_path_{""};
-  std::string source_code_;
+  std::string_view source_code_;
+  // Only built when a diagnostic needs a line and column number, along with
+  // the symbol of 'file_path_'.
+  std::optional<LineTable> line_table_;
+  Symbol file_symbol_{};
+  std::string string_buffer_;
+  Token pending_token_{};
+  bool has_pending_token_ = false;
+  bool has_fatal_error_ = false;
   std::vector<Token> tokens_;
-  std::map<std::string, TokenType> keywords_to_tokentypes_ = {
-      {"int", TokenType::kInt},       {"bool", TokenType::kBool},
-      {"if", TokenType::kIf},         {"else", TokenType::kElse},
-      {"while", TokenType::kWhile},   {"return", TokenType::kReturn},
-      {"true", TokenType::kTrue},     {"false", TokenType::kFalse},
-      {"length", TokenType::kLength}, {"use", TokenType::kUse},
-  };
   DiagnosticReporter &diagnostic_reporter_;
+  const SimdScanner &simd_scanner_ = GetSimdScanner();
+  StringInterner &string_interner_ = GetStringInterner();
 
 public:
-  Lexer(const std::string &file_path,
-        const std::string &source_code,
+  // The lexer does not copy 'source_code', which must outlive it and must be
+  // followed by a readable '\0' sentinel, as provided by 'std::string' and
+  // 'SourceBuffer'.
+  Lexer(const std::string &file_path, std::string_view source_code,
         DiagnosticReporter &diagnostic_reporter);
+  // Lexes only the bytes in [begin, end) of 'source_code'. Token offsets are
+  // still relative to the whole source code. 'end' must be either the length
+  // of the source code or the position right after a '\n', since no token
+  // extends past a newline (see 'LexTokensInParallel').
+  Lexer(const std::string &file_path, std::string_view source_code,
+        std::size_t begin, std::size_t end,
+        DiagnosticReporter &diagnostic_reporter);
+  std::string_view GetSourceCode() const;
+  // Lexes the whole source code at once. Unlike the token stream, the
+  // returned sequence does not end with 'kFileEnd' when a lexical error is
+  // found.
   const std::vector<Token> &LexTokens();
+  // Same as above, but appends the tokens to 'tokens' instead.
+  void LexTokens(std::vector<Token> &tokens);
+  // Lexes only up to the next token. After the last token, or after a fatal
+  // lexical error, returns 'kFileEnd'.
+  Token NextToken() override;
 };
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "senbonzakura/token_type.hpp"
+
+// Lexical category of a single byte of source code. The lexer dispatches on
+// the category of the first byte of a lexeme instead of comparing it against
+// every character range it could belong to.
+enum class CharClass : std::uint8_t {
+  kInvalid,
+  kSentinel, // The '\0' that terminates the source buffer.
+  kWhitespace,
+  kNewline,
+  kAlpha,
+  kDigit,
+  kDoubleQuote,
+  kSingleQuote,
+  kPunctuator, // Operators, delimiters and the start of a comment.
+};
+
+// What the lexer must do after the punctuator DFA stops in a given state.
+enum class PunctuatorAction : std::uint8_t {
+  kNone,
+  kToken,
+  kComment,
+};
+
+struct Punctuator {
+  std::string_view lexeme;
+  PunctuatorAction action;
+  TokenType token_type;
+};
+
+// Every operator and delimiter of Eta, plus the comment opener. The punctuator
+// DFA below is generated from this list, so adding a new operator only
+// requires a new entry here.
+inline constexpr std::array kPunctuators{
+    Punctuator{"(", PunctuatorAction::kToken, TokenType::kLeftParen},
+    Punctuator{")", PunctuatorAction::kToken, TokenType::kRightParen},
+    Punctuator{"{", PunctuatorAction::kToken, TokenType::kLeftBracket},
+    Punctuator{"}", PunctuatorAction::kToken, TokenType::kRightBracket},
+    Punctuator{"[", PunctuatorAction::kToken, TokenType::kLeftSquareBracket},
+    Punctuator{"]", PunctuatorAction::kToken, TokenType::kRightSquareBracket},
+    Punctuator{",", PunctuatorAction::kToken, TokenType::kComma},
+    Punctuator{":", PunctuatorAction::kToken, TokenType::kColon},
+    Punctuator{";", PunctuatorAction::kToken, TokenType::kSemiColon},
+    Punctuator{"+", PunctuatorAction::kToken, TokenType::kPlus},
+    Punctuator{"-", PunctuatorAction::kToken, TokenType::kMinus},
+    Punctuator{"%", PunctuatorAction::kToken, TokenType::kRemainder},
+    Punctuator{"*", PunctuatorAction::kToken, TokenType::kStar},
+    Punctuator{"/", PunctuatorAction::kToken, TokenType::kSlash},
+    Punctuator{"_", PunctuatorAction::kToken, TokenType::kUnderscore},
+    Punctuator{"!", PunctuatorAction::kToken, TokenType::kBang},
+    Punctuator{"!=", PunctuatorAction::kToken, TokenType::kBangEqual},
+    Punctuator{"=", PunctuatorAction::kToken, TokenType::kEqual},
+    Punctuator{"==", PunctuatorAction::kToken, TokenType::kEqualEqual},
+    Punctuator{">", PunctuatorAction::kToken, TokenType::kGreater},
+    Punctuator{">=", PunctuatorAction::kToken, TokenType::kGreaterEqual},
+    Punctuator{"<", PunctuatorAction::kToken, TokenType::kLess},
+    Punctuator{"<=", PunctuatorAction::kToken, TokenType::kLessEqual},
+    Punctuator{"&", PunctuatorAction::kToken, TokenType::kLogicalAnd},
+    Punctuator{"|", PunctuatorAction::kToken, TokenType::kLogicalOr},
+    Punctuator{"*>>", PunctuatorAction::kToken, TokenType::kHighMul},
+    Punctuator{"//", PunctuatorAction::kComment, TokenType::kFileEnd},
+};
+
+consteval std::array<CharClass, 256> BuildCharClassTable() {
+  std::array<CharClass, 256> table{};
+  table.fill(CharClass::kInvalid);
+
+  for (unsigned char c = 'a'; c <= 'z'; c++) {
+    table[c] = CharClass::kAlpha;
+  }
+  for (unsigned char c = 'A'; c <= 'Z'; c++) {
+    table[c] = CharClass::kAlpha;
+  }
+  for (unsigned char c = '0'; c <= '9'; c++) {
+    table[c] = CharClass::kDigit;
+  }
+  for (const Punctuator &punctuator : kPunctuators) {
+    table[static_cast<unsigned char>(punctuator.lexeme[0])] =
+        CharClass::kPunctuator;
+  }
+  table['\0'] = CharClass::kSentinel;
+  table[' '] = CharClass::kWhitespace;
+  table['\t'] = CharClass::kWhitespace;
+  table['\r'] = CharClass::kWhitespace;
+  table['\n'] = CharClass::kNewline;
+  table['\"'] = CharClass::kDoubleQuote;
+  table['\''] = CharClass::kSingleQuote;
+
+  return table;
+}
+
+inline constexpr std::array<CharClass, 256> kCharClassTable =
+    BuildCharClassTable();
+
+// Characters that may appear after the first character of an identifier.
+consteval std::array<bool, 256> BuildIdentifierPartTable() {
+  std::array<bool, 256> table{};
+  for (std::size_t c = 0; c < table.size(); c++) {
+    table[c] = kCharClassTable[c] == CharClass::kAlpha ||
+               kCharClassTable[c] == CharClass::kDigit;
+  }
+  table['_'] = true;
+  table['\''] = true;
+
+  return table;
+}
+
+inline constexpr std::array<bool, 256> kIdentifierPartTable =
+    BuildIdentifierPartTable();
+
+// Deterministic automaton recognizing every entry of 'kPunctuators'. Its input
+// alphabet is restricted to the characters that appear in some punctuator,
+// which keeps the transition table a few hundred bytes in size. The lexer runs
+// it with maximal munch: it stops at the first rejected character and backs up
+// to the last accepting state it went through (e.g. "*>" lexes as '*' '>').
+struct PunctuatorDfa {
+  static constexpr std::uint8_t kRejectState = 0;
+  static constexpr std::uint8_t kStartState = 1;
+  static constexpr std::size_t kMaxStates = 32;
+  static constexpr std::size_t kMaxInputs = 32;
+
+  std::array<std::uint8_t, 256> input_table{};
+  std::array<std::array<std::uint8_t, kMaxInputs>, kMaxStates> transitions{};
+  std::array<PunctuatorAction, kMaxStates> actions{};
+  std::array<TokenType, kMaxStates> token_types{};
+  std::size_t state_count = 2;
+
+  constexpr std::uint8_t Next(std::uint8_t state, char c) const {
+    return transitions[state][input_table[static_cast<unsigned char>(c)]];
+  }
+};
+
+consteval PunctuatorDfa BuildPunctuatorDfa() {
+  PunctuatorDfa dfa{};
+  // Input 0 is reserved for characters that do not belong to any punctuator
+  // (including the '\0' sentinel), so it always leads to the reject state.
+  std::uint8_t input_count = 1;
+
+  for (const Punctuator &punctuator : kPunctuators) {
+    std::uint8_t state = PunctuatorDfa::kStartState;
+    for (char c : punctuator.lexeme) {
+      std::uint8_t &input = dfa.input_table[static_cast<unsigned char>(c)];
+      if (input == 0) {
+        input = input_count++;
+      }
+      std::uint8_t &next_state = dfa.transitions[state][input];
+      if (next_state == PunctuatorDfa::kRejectState) {
+        next_state = static_cast<std::uint8_t>(dfa.state_count++);
+      }
+      state = next_state;
+    }
+    dfa.actions[state] = punctuator.action;
+    dfa.token_types[state] = punctuator.token_type;
+  }
+
+  if (input_count > PunctuatorDfa::kMaxInputs ||
+      dfa.state_count > PunctuatorDfa::kMaxStates) {
+    throw "The punctuator DFA does not fit in its transition table.";
+  }
+
+  return dfa;
+}
+
+inline constexpr PunctuatorDfa kPunctuatorDfa = BuildPunctuatorDfa();
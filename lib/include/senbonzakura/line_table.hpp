@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// 1-based line and column numbers of a byte of source code. Columns count
+// bytes, so a tab advances the column by one.
+struct LineColumn {
+  std::uint32_t line;
+  std::uint32_t column;
+
+  bool operator==(const LineColumn &other) const = default;
+};
+
+// Byte offsets at which every line of a source file starts. Tokens and
+// positions are stored as plain byte offsets, and are turned into line and
+// column numbers with a binary search only when a diagnostic or an output line
+// needs them.
+class LineTable {
+public:
+  // Builds the table with a single vectorized scan for '\n' over the source.
+  explicit LineTable(std::string_view source_code);
+
+  std::size_t GetLineCount() const;
+  // Offset of the first byte of 'line' (1-based).
+  std::size_t GetLineStart(std::size_t line) const;
+  // 'offset' may be equal to the length of the source, which is the position
+  // of the 'kFileEnd' token.
+  LineColumn Resolve(std::size_t offset) const;
+
+private:
+  std::vector<std::uint32_t> line_starts_;
+};
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Largest magnitude an integer literal may have. Eta integers are signed 64-bit
+// values and the lexer does not see the unary minus in front of a literal, so
+// 2^63 is accepted here and left for the parser to reject unless it is
+// negated, which yields '-9223372036854775808'.
+inline constexpr std::uint64_t kMaxIntegerLiteralMagnitude =
+    std::uint64_t{1} << 63;
+
+// Parses the decimal 'digits' of an integer literal without allocating.
+// Returns false if the literal is larger than 'kMaxIntegerLiteralMagnitude'.
+bool DecodeIntegerLiteral(std::string_view digits, std::uint64_t &magnitude);
+
+enum class EscapeStatus {
+  kValid,
+  kUnknown,    // The character after '\' does not start any escape.
+  kMalformed,  // A '\x' escape without braces or hexadecimal digits.
+  kOutOfRange, // A '\x' escape outside of the ASCII range.
+};
+
+struct DecodedEscape {
+  EscapeStatus status;
+  char value;
+  // Number of bytes of the escape sequence, including the leading '\'.
+  std::size_t length;
+};
+
+// Decodes the escape sequence at the start of 'text', which must begin with
+// '\'. Supports '\\', '\'', '\"', '\n', '\t', '\r' and '\x{H}' with 1 to 6
+// hexadecimal digits. Source files are treated as ASCII, so '\x' escapes
+// above 0x7F are rejected.
+DecodedEscape DecodeEscapeSequence(std::string_view text);
+
+// Appends 'value' to 'output', escaping '\' and every non-printable character
+// the way the '.lexed' output expects, so that each token stays on one line.
+void AppendEscapedLiteral(std::string &output, std::string_view value);
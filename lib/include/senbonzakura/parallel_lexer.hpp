@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "senbonzakura/diagnostic_reporter.hpp"
+#include "senbonzakura/token.hpp"
+
+// Files smaller than this are always lexed on the calling thread, since
+// starting the workers would cost more than lexing them.
+inline constexpr std::size_t kMinParallelLexingChunkSize = 1 << 20;
+
+// Returns the boundaries of at most 'chunk_count' chunks of 'source_code',
+// starting with 0 and ending with the length of the source code. Every inner
+// boundary follows a '\n'. Eta tokens cannot contain a newline, with the sole
+// exception of a character literal holding a raw one, so these are the points
+// where a lexer can start over without knowing what came before.
+std::vector<std::size_t> SplitAtNewlines(std::string_view source_code,
+                                         std::size_t chunk_count);
+
+// Lexes 'source_code' with up to 'thread_count' threads, each one working on a
+// chunk returned by 'SplitAtNewlines'. The result, including the diagnostics
+// reported to 'diagnostic_reporter', is the same as the one of
+// 'Lexer::LexTokens': the tokens of the chunks are concatenated in order, and
+// everything after the first fatal lexical error is dropped.
+std::vector<Token> LexTokensInParallel(const std::string &file_path,
+                                       std::string_view source_code,
+                                       DiagnosticReporter &diagnostic_reporter,
+                                       std::size_t thread_count);
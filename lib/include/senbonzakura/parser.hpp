@@ -1,20 +1,145 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
 #include <vector>
 
+#include "senbonzakura/ast.hpp"
 #include "senbonzakura/diagnostic_reporter.hpp"
+#include "senbonzakura/line_table.hpp"
+#include "senbonzakura/string_interner.hpp"
 #include "senbonzakura/token.hpp"
+#include "senbonzakura/token_stream.hpp"
+#include "senbonzakura/token_type.hpp"
 
+// Recursive descent parser of Eta source files. Statements and definitions
+// are parsed by recursive descent, and expressions by precedence climbing
+// (Pratt parsing) over the operator table of the Eta Language Specification.
 class Parser {
 private:
-  std::size_t current_ = 0;
-  std::size_t start_ = 0;
+  // Deepest nesting of statements and expressions that is parsed. Every
+  // statement, parenthesis and unary operator is one level, and the braces of
+  // the body of an 'if' or a 'while' belong to it, so 'if a { if b { ... } }'
+  // is nested as deep as it looks. Every level costs a few stack frames, and
+  // files are parsed on threads of the driver, so the limit is kept well
+  // within their stack size.
+  static constexpr std::size_t kMaxNestingDepth = 2000;
+
+  // Counts one level of nesting while it is alive.
+  class NestingScope {
+  public:
+    explicit NestingScope(Parser &parser);
+    ~NestingScope();
+    NestingScope(const NestingScope &) = delete;
+    NestingScope &operator=(const NestingScope &) = delete;
+
+  private:
+    Parser &parser_;
+  };
+
+  const Token &Peek(std::size_t offset = 0);
+  bool Check(TokenType token_type);
+  // Consumes the current token if it is of type 'token_type'.
+  bool Match(TokenType token_type);
+  // Consumes the current token, which must be of type 'token_type'.
+  // Otherwise reports an error, with 'expectation' describing what was
+  // expected, and returns false.
+  bool Expect(TokenType token_type, std::string_view expectation);
+  // Reports a syntax error at the current token. 'format' must be a string
+  // literal, formatted with a description of the current token.
+  void ReportUnexpectedToken(std::string_view format);
+  // Reports a syntax error and enters panic mode, where further errors are
+  // not reported until the parser resynchronizes.
+  void ReportError(std::uint32_t offset, std::uint32_t length,
+                   std::string_view format, std::string argument = {});
+  // Reports code that was parsed fine but is not allowed where it is. Parsing
+  // goes on as usual, since the tokens are where they are expected.
+  void ReportInvalidConstruct(std::uint32_t offset, std::uint32_t length,
+                              std::string_view format,
+                              std::string argument = {});
+  // Whether the parser is in panic mode, unwinding to the nearest statement
+  // or definition after a syntax error.
+  bool HasFailed() const;
+  // Leave panic mode by skipping tokens, up to the end of the statement that
+  // started at 'statement_offset' or the start of the next definition.
+  // Braces are skipped in pairs, so that a block is never resumed midway.
+  void SynchronizeStatement(std::uint32_t statement_offset);
+  void SynchronizeDefinition(std::uint32_t definition_offset);
+  // Whether 'token' is the first one of its line, which is where definitions
+  // start in practice.
+  bool IsAtLineStart(const Token &token) const;
+  // Stands for the code that could not be parsed, at the current token.
+  AstIndex AddErrorNode();
+  // Reports the integer literal 'token' if its magnitude is 2^63, which the
+  // lexer accepts for the smallest integer, unless it is the direct operand of
+  // a unary minus.
+  void CheckIntegerLiteral(const Token &token, bool is_negated);
+
+  AstIndex Program();
+  AstIndex Use();
+  AstIndex Function();
+  AstIndex GlobalDeclaration();
+  AstIndex GlobalValue();
+  // 'name: type'. Lengths of arrays can only be given in the declarations of
+  // local variables.
+  AstIndex Declaration(bool allows_lengths);
+  AstIndex Type(bool allows_lengths);
+
+  // A 'return' statement can only be parsed by 'Block', since it must be the
+  // last statement of its block.
+  AstIndex Block();
+  AstIndex Statement();
+  // The body of an 'if' or a 'while', which is a block or a single statement.
+  AstIndex Branch();
+  AstIndex If();
+  AstIndex While();
+  AstIndex Return();
+  // Assignments, declarations and procedure calls, which all start with an
+  // identifier or '_'.
+  AstIndex SimpleStatement();
+  AstIndex AssignmentTarget();
+
+  AstIndex Expression(int min_binding_power = 0);
+  // 'is_negated' tells whether the expression is the operand of a unary minus.
+  AstIndex PrefixExpression(bool is_negated = false);
+  AstIndex PrimaryExpression();
+  // Parses the elements of a list closed by 'closing_type' into 'scratch_',
+  // after the opening token has been consumed.
+  bool ExpressionList(TokenType closing_type, bool allows_trailing_comma,
+                      std::string_view expectation);
+  AstIndex AddIdentifier(const Token &token);
+
   std::string file_path_{""};
-  const std::vector<Token> &tokens_;
+  std::string_view source_code_;
+  TokenCursor token_cursor_;
   DiagnosticReporter &diagnostic_reporter_;
+  Ast ast_;
+  // Children of the lists being parsed, innermost last. Every list is moved
+  // to the tree once it is complete, so a single buffer serves all of them.
+  std::vector<AstIndex> scratch_;
+  // Only built when a diagnostic needs a line and column number, along with
+  // the symbol of 'file_path_'.
+  std::optional<LineTable> line_table_;
+  Symbol file_symbol_{};
+  std::size_t nesting_depth_ = 0;
+  std::size_t syntax_error_count_ = 0;
+  bool is_panicking_ = false;
+  StringInterner &string_interner_ = GetStringInterner();
 
 public:
-  Parser(const std::string &file_path, const std::vector<Token> &tokens,
-         DiagnosticReporter &diagnostic_reporter);
-  void Parse();
+  // The parser pulls tokens from 'token_stream' as it needs them, so it can
+  // consume a 'Lexer' directly without materializing the whole token sequence.
+  // 'source_code' is the code the tokens were lexed from, and is only read to
+  // report diagnostics.
+  Parser(const std::string &file_path, std::string_view source_code,
+         TokenStream &token_stream, DiagnosticReporter &diagnostic_reporter);
+  // Reserves room for the tree of a file with 'token_count' tokens.
+  void Reserve(std::size_t token_count);
+  // Parses the whole file, reporting every independent syntax error. The code
+  // that could not be parsed is left in the tree as 'kError' nodes.
+  Ast Parse();
+  std::size_t GetSyntaxErrorCount() const;
 };
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Hardware and software events counted with Linux 'perf_event_open'.
+enum class PerfEvent {
+  kCycles,
+  kInstructions,
+  kBranchMisses,
+  kL1dMisses,
+  kLlcMisses,
+  kPageFaults,
+};
+
+inline constexpr std::size_t kPerfEventCount = 6;
+
+std::string_view GetPerfEventName(PerfEvent perf_event);
+
+// A count for every event, along with whether it could be counted at all.
+struct PerfCounterValues {
+  std::array<std::uint64_t, kPerfEventCount> counts{};
+  std::array<bool, kPerfEventCount> is_available{};
+
+  std::uint64_t Get(PerfEvent perf_event) const;
+  bool IsAvailable(PerfEvent perf_event) const;
+  // Sums the counts, keeping the events that are available in both.
+  PerfCounterValues &operator+=(const PerfCounterValues &other);
+};
+
+// The counters of the calling thread, which also count the threads it starts
+// after they were opened, such as the ones lexing the chunks of a file.
+// Events that cannot be opened, like the hardware ones inside most
+// containers and virtual machines, are left out.
+class PerfCounters {
+public:
+  PerfCounters();
+  ~PerfCounters();
+
+  PerfCounters(const PerfCounters &) = delete;
+  PerfCounters &operator=(const PerfCounters &) = delete;
+
+  bool HasAnyEvent() const;
+  // The events that could not be opened and why, such as
+  // "cycles (No such file or directory)", or an empty string.
+  std::string DescribeUnavailableEvents() const;
+
+  // Current counts, scaled up when the kernel multiplexed the counters.
+  PerfCounterValues Read() const;
+
+private:
+  std::array<int, kPerfEventCount> file_descriptors_;
+  std::array<int, kPerfEventCount> open_errors_{};
+};
+
+// The counters of the calling thread, opened the first time it asks for them,
+// or nullptr when none of the events can be counted.
+const PerfCounters *GetThreadPerfCounters();
+
+// Events counted during one compilation phase, such as "lex".
+struct PhasePerfCounters {
+  std::string phase_name;
+  PerfCounterValues values;
+};
+
+// The events counted in every phase of one or more files, kept in the order in
+// which the phases first ran, like 'TimeReport'.
+class PerfCounterReport {
+public:
+  void AddPhaseCounters(std::string_view phase_name,
+                        const PerfCounterValues &values);
+  void Merge(const PerfCounterReport &other);
+
+  const std::vector<PhasePerfCounters> &GetPhaseCounters() const;
+  std::size_t GetByteCount() const;
+  void SetByteCount(std::size_t byte_count);
+
+private:
+  std::vector<PhasePerfCounters> phase_counters_;
+  std::size_t byte_count_ = 0;
+};
+
+// Adds the events counted on the calling thread, from its construction to its
+// destruction, to the phase 'phase_name' of 'perf_counter_report'. Does
+// nothing when 'perf_counter_report' is nullptr.
+class PerfCounterScope {
+public:
+  PerfCounterScope(PerfCounterReport *perf_counter_report,
+                   std::string_view phase_name);
+  ~PerfCounterScope();
+
+  PerfCounterScope(const PerfCounterScope &) = delete;
+  PerfCounterScope &operator=(const PerfCounterScope &) = delete;
+
+private:
+  PerfCounterReport *perf_counter_report_ = nullptr;
+  std::string_view phase_name_;
+  const PerfCounters *perf_counters_ = nullptr;
+  PerfCounterValues start_;
+};
+
+// Formats 'perf_counter_report' as a table with the instructions per cycle
+// and the misses and page faults per KB of source code of every phase.
+// Events that could not be counted are shown as '-'.
+std::string
+FormatPerfCounterReport(std::string_view title,
+                        const PerfCounterReport &perf_counter_report);
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct ProgramGeneratorOptions {
+  // The same options and seed always produce the same program, on every
+  // platform.
+  std::uint64_t seed = 1;
+  // Number of functions besides 'main'. When 'target_size' is set, functions
+  // keep being added until the program has at least that many bytes.
+  std::size_t function_count = 16;
+  std::size_t target_size = 0;
+  // Deepest nesting of 'if' and 'while' blocks inside a function body.
+  std::size_t max_nesting_depth = 3;
+  // Largest number of operators in a generated expression.
+  std::size_t max_expression_size = 8;
+  // Number of statements in a function body, before its 'return'.
+  std::size_t statements_per_function = 12;
+  // Probability, from 0 to 1, of using arrays where an 'int' or 'bool' could
+  // have been used instead.
+  double array_usage = 0.3;
+  // Probability, from 0 to 1, that a leaf of an expression is a literal
+  // instead of a variable.
+  double literal_density = 0.3;
+  // Number of interfaces imported with 'use': 0, 1 ('io') or 2 ('io' and
+  // 'conv'). Imported functions are called by the generated code.
+  std::size_t import_count = 2;
+  // Appends functions with very deep nesting, very long lines and huge
+  // literals, meant to expose super-linear behavior in the compiler.
+  bool pathological = false;
+  // Scale of the pathological constructs: nesting depth, number of operands
+  // in a single expression, and so on. The parser rejects code nested more
+  // than 2000 levels deep, so scales close to 2000 and above only suit the
+  // lexer.
+  std::size_t pathological_scale = 1000;
+};
+
+// Generates syntactically valid and well-typed Eta programs. The programs
+// only declare each name once, call functions with arguments of the right
+// types, and end every non-procedure function with a 'return' of the right
+// types, so they are also meant to be accepted by the later phases of the
+// compiler. Functions only call functions defined before them, so the
+// programs contain no recursion.
+class ProgramGenerator {
+public:
+  explicit ProgramGenerator(ProgramGeneratorOptions options);
+
+  std::string Generate();
+
+private:
+  enum class Type { kInt, kBool, kIntArray, kIntMatrix };
+
+  struct Function {
+    std::string name;
+    std::vector<Type> parameter_types;
+    std::vector<Type> return_types;
+  };
+
+  struct Variable {
+    std::string name;
+    Type type;
+    // Loop counters and 'args' are never assigned by the generated code.
+    bool is_assignable = true;
+  };
+
+  // SplitMix64, since the standard distributions are not required to produce
+  // the same values on every implementation.
+  std::uint64_t NextRandom();
+  std::size_t RandomBelow(std::size_t bound);
+  bool RandomChance(double probability);
+
+  static const char *GetTypeName(Type type);
+  Type RandomValueType();
+  std::string FreshName(const char *prefix);
+  void Indent(std::size_t depth);
+  void AddCallableFunction(Function function);
+
+  void GenerateImports();
+  void GenerateGlobals();
+  Function GenerateSignature(std::size_t index);
+  void GenerateFunction(const Function &function);
+  void GenerateMain();
+  void GenerateBlock(std::size_t depth, std::size_t statement_count);
+  void GenerateStatement(std::size_t depth);
+  void GenerateDeclaration(std::size_t depth);
+  void GenerateAssignment(std::size_t depth);
+  void GenerateConditional(std::size_t depth);
+  void GenerateLoop(std::size_t depth);
+  void GenerateCallStatement(std::size_t depth);
+  void GenerateReturn(const Function &function, std::size_t depth);
+
+  void GenerateExpression(Type type, std::size_t budget);
+  void GenerateLeaf(Type type);
+  void GenerateLiteral(Type type);
+  bool GenerateCall(Type type, std::size_t budget);
+  void GenerateArguments(const Function &function, std::size_t budget);
+  const Variable *FindVariable(Type type);
+
+  void GeneratePathologicalFunctions();
+
+  ProgramGeneratorOptions options_;
+  std::uint64_t random_state_;
+  std::string output_;
+  std::size_t name_counter_ = 0;
+  // Every function that can be called from the function being generated:
+  // the imported ones and the ones generated before it.
+  std::vector<Function> callable_functions_;
+  // Indexes into 'callable_functions_' of the functions that can be called as
+  // a statement, that return two values, and that return a single value of
+  // each type, so that picking one does not take time linear in their number.
+  std::vector<std::size_t> statement_function_indexes_;
+  std::vector<std::size_t> pair_function_indexes_;
+  std::array<std::vector<std::size_t>, 4> function_indexes_by_return_type_;
+  // Variables in scope, innermost last. Blocks truncate it back when they end.
+  std::vector<Variable> variables_;
+};
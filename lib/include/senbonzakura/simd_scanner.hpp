@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+
+// Instruction set used by the vectorized scanners. 'kSse2' is the baseline on
+// x86-64, and 'kAvx2' is picked at runtime when the CPU supports it. Other
+// architectures use the scalar implementation.
+enum class SimdLevel {
+  kScalar,
+  kSse2,
+  kAvx2,
+};
+
+// Scanners over the byte range [position, end) of a buffer. Each returns the
+// position of the first byte that does not belong to the run (or 'end'). They
+// never read at or past 'end', so the buffer does not need any padding.
+struct SimdScanner {
+  SimdLevel level;
+  // Position of the first '\n'.
+  std::size_t (*find_newline)(const char *data, std::size_t position,
+                              std::size_t end);
+  // Skips ' ', '\t', '\r' and '\n'.
+  std::size_t (*skip_whitespace)(const char *data, std::size_t position,
+                                 std::size_t end);
+  // Skips letters, digits, '_' and '\''.
+  std::size_t (*skip_identifier_part)(const char *data, std::size_t position,
+                                      std::size_t end);
+  // Skips decimal digits.
+  std::size_t (*skip_digits)(const char *data, std::size_t position,
+                             std::size_t end);
+};
+
+SimdLevel GetSupportedSimdLevel();
+// Returns the scanner for the best instruction set supported by the CPU.
+const SimdScanner &GetSimdScanner();
+// Returns the scanner for 'level', falling back to the best supported level
+// below it. Mostly useful for testing every implementation on the same CPU.
+const SimdScanner &GetSimdScanner(SimdLevel level);
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// Read-only view of the bytes of a source file.
+//
+// Regular files are memory-mapped (and advised for sequential access), so the
+// bytes are read straight from the page cache and never copied into user
+// space. Pipes, character devices and any file that cannot be mapped fall back
+// to plain read() calls into an owned string.
+//
+// Whatever the backing storage, the buffer guarantees that:
+//   - 'Data()[Size()]' is readable and equal to '\0'. The lexer relies on this
+//     sentinel instead of checking bounds on every character.
+//   - No byte past 'Data()[Size()]' may be read. The vectorized scanners only
+//     perform full-width loads below the end of the range they are given, so
+//     they do not need any extra padding.
+class SourceBuffer {
+public:
+  SourceBuffer() = default;
+  SourceBuffer(const SourceBuffer &) = delete;
+  SourceBuffer &operator=(const SourceBuffer &) = delete;
+  SourceBuffer(SourceBuffer &&other) noexcept;
+  SourceBuffer &operator=(SourceBuffer &&other) noexcept;
+  ~SourceBuffer();
+
+  // Loads the file at 'file_path'. Returns false, leaving the buffer empty,
+  // when the file cannot be opened or read.
+  bool Load(const std::string &file_path);
+
+  const char *Data() const;
+  bool IsMapped() const;
+  std::size_t Size() const;
+  std::string_view View() const;
+
+private:
+  bool MapFile(int file_descriptor, std::size_t file_size);
+  bool ReadFile(int file_descriptor);
+  void Release();
+
+  // Start of the mapping when the file is memory-mapped, nullptr otherwise.
+  char *mapping_ = nullptr;
+  std::size_t mapping_size_ = 0;
+  std::size_t size_ = 0;
+  // Storage used by the read() fallback.
+  std::string content_;
+};
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <string_view>
+#include <vector>
+
+// Handle to a string stored in a 'StringInterner'. Two symbols of the same
+// interner are equal if and only if their strings are equal, so names can be
+// compared and hashed as plain integers. A value-initialized symbol ('{}')
+// refers to no string at all. Symbols are trivial so that tokens can carry
+// them.
+struct Symbol {
+  std::uint32_t id;
+
+  bool IsValid() const { return id != 0; }
+  bool operator==(const Symbol &other) const = default;
+};
+
+// Stores a single copy of every distinct string handed to it. The strings live
+// in arena chunks that are never freed nor moved, so the views returned by
+// 'GetString' stay valid for the lifetime of the interner.
+//
+// The interner is safe to use from several threads at once. It is split into
+// shards, selected by the hash of the string, that each own a hash table, an
+// arena and a lock, so that threads interning different names rarely contend.
+class StringInterner {
+public:
+  StringInterner();
+  StringInterner(const StringInterner &) = delete;
+  StringInterner &operator=(const StringInterner &) = delete;
+
+  // Returns the symbol of 'string', adding it to the interner if needed.
+  Symbol Intern(std::string_view string);
+  // Returns the symbol of 'string', or an invalid symbol if it has never been
+  // interned.
+  Symbol Find(std::string_view string) const;
+  std::string_view GetString(Symbol symbol) const;
+  // Number of distinct strings interned so far.
+  std::size_t GetSize() const;
+
+private:
+  static constexpr std::size_t kShardBits = 4;
+  static constexpr std::size_t kShardCount = 1 << kShardBits;
+  static constexpr std::size_t kChunkSize = 64 * 1024;
+
+  // Open addressing slot. 'index' is the position of the string in 'strings'
+  // plus one, so that a zeroed slot is empty.
+  struct Slot {
+    std::uint32_t hash;
+    std::uint32_t index;
+  };
+
+  struct Shard {
+    mutable std::shared_mutex mutex;
+    std::vector<Slot> slots;
+    std::vector<std::string_view> strings;
+    std::vector<std::unique_ptr<char[]>> chunks;
+    char *current_chunk = nullptr;
+    std::size_t chunk_used = kChunkSize;
+  };
+
+  static std::uint64_t Hash(std::string_view string);
+  static std::uint32_t FindIndex(const Shard &shard, std::string_view string,
+                                 std::uint32_t hash);
+  static std::string_view Store(Shard &shard, std::string_view string);
+  static void Grow(Shard &shard);
+
+  std::array<Shard, kShardCount> shards_;
+};
+
+// Interner shared by every stage of the compiler.
+StringInterner &GetStringInterner();
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Fixed set of worker threads that run the submitted tasks in submission
+// order. The destructor waits for every pending task before joining the
+// workers, so the futures returned by 'Submit' are always fulfilled.
+class ThreadPool {
+public:
+  explicit ThreadPool(std::size_t thread_count);
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+  ~ThreadPool();
+
+  std::size_t GetThreadCount() const;
+
+  // Queues 'task' and returns a future holding its result, or the exception
+  // it threw.
+  template <typename Task>
+  std::future<std::invoke_result_t<Task>> Submit(Task task) {
+    using Result = std::invoke_result_t<Task>;
+    // 'std::function' must be copyable, so the task is kept behind a pointer.
+    auto packaged_task =
+        std::make_shared<std::packaged_task<Result()>>(std::move(task));
+    std::future<Result> future = packaged_task->get_future();
+    {
+      std::lock_guard<std::mutex> lock{mutex_};
+      tasks_.emplace_back([packaged_task]() { (*packaged_task)(); });
+    }
+    task_available_.notify_one();
+
+    return future;
+  }
+
+private:
+  void RunWorker();
+
+  std::mutex mutex_;
+  std::condition_variable task_available_;
+  std::deque<std::function<void()>> tasks_;
+  bool is_stopping_ = false;
+  std::vector<std::thread> workers_;
+};
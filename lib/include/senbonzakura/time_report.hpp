@@ -0,0 +1,99 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "senbonzakura/allocation_tracker.hpp"
+
+// Wall time spent in one phase of the compilation, such as "lex", and the heap
+// allocations it made on the thread that ran it.
+struct PhaseTime {
+  std::string phase_name;
+  std::chrono::nanoseconds wall_time{0};
+  AllocationCounters allocations;
+};
+
+// Where the time of compiling one or more files went, phase by phase, along
+// with the amount of work that was done. Phases are measured with a monotonic
+// clock, and are kept in the order in which they first ran, so a new phase
+// shows up in the reports as soon as it is measured.
+class TimeReport {
+public:
+  // Runs 'function', adding the time it took to the phase 'phase_name', and
+  // returns its result.
+  template <typename Function>
+  decltype(auto) MeasurePhase(std::string_view phase_name,
+                              Function &&function) {
+    PhaseTimer phase_timer{*this, phase_name};
+    return std::forward<Function>(function)();
+  }
+
+  // Adds to the phase 'phase_name'. The peak of live bytes is the largest of
+  // the peaks that were added.
+  void AddPhaseTime(std::string_view phase_name,
+                    std::chrono::nanoseconds wall_time,
+                    const AllocationCounters &allocations = {});
+  // Adds the phases and the counts of 'other' to this report. The peak RSS is
+  // the largest of both.
+  void Merge(const TimeReport &other);
+
+  const std::vector<PhaseTime> &GetPhaseTimes() const;
+  // Sum of the time of every phase.
+  std::chrono::nanoseconds GetTotalTime() const;
+
+  std::size_t GetByteCount() const;
+  std::size_t GetTokenCount() const;
+  std::size_t GetPeakResidentSetSize() const;
+  void SetByteCount(std::size_t byte_count);
+  void SetTokenCount(std::size_t token_count);
+  void SetPeakResidentSetSize(std::size_t peak_resident_set_size);
+
+private:
+  class PhaseTimer {
+  public:
+    PhaseTimer(TimeReport &time_report, std::string_view phase_name);
+    ~PhaseTimer();
+
+    PhaseTimer(const PhaseTimer &) = delete;
+    PhaseTimer &operator=(const PhaseTimer &) = delete;
+
+  private:
+    TimeReport &time_report_;
+    std::string_view phase_name_;
+    std::chrono::steady_clock::time_point start_;
+    AllocationScope allocation_scope_;
+  };
+
+  std::vector<PhaseTime> phase_times_;
+  std::size_t byte_count_ = 0;
+  std::size_t token_count_ = 0;
+  std::size_t peak_resident_set_size_ = 0;
+};
+
+// Peak resident set size of the whole process so far, in bytes. Files compiled
+// at the same time share it, so with several jobs the peak of a file also
+// accounts for the files compiled alongside it.
+std::size_t GetPeakResidentSetSize();
+
+// Formats 'time_report' as a table, in the spirit of '-ftime-report', with
+// 'title' naming what was measured. When 'wall_time' is set, it is the time
+// that the throughput is computed against, instead of the sum of the phases,
+// which counts the files compiled at the same time more than once. The
+// allocations of every phase are added with 'has_allocations', which defaults
+// to whether the allocation hooks are installed.
+std::string FormatTimeReport(
+    std::string_view title, const TimeReport &time_report,
+    std::chrono::nanoseconds wall_time = std::chrono::nanoseconds{0},
+    bool has_allocations = AreAllocationHooksInstalled());
+
+// Formats the reports of every file and their aggregate, covering a run that
+// took 'wall_time', as a JSON document. 'has_allocations' is as in
+// 'FormatTimeReport'.
+std::string FormatTimeReportJson(
+    const std::vector<std::pair<std::string, TimeReport>> &file_time_reports,
+    const TimeReport &total_time_report, std::chrono::nanoseconds wall_time,
+    bool has_allocations = AreAllocationHooksInstalled());
@@ -1,21 +1,71 @@
 #pragma once
 
+#include "senbonzakura/line_table.hpp"
+#include "senbonzakura/string_interner.hpp"
 #include "senbonzakura/token_type.hpp"
 
-#include <any>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <string>
+#include <string_view>
 
+// Payload carried by literal and identifier tokens. The active member is
+// determined by the token type: 'kInteger' uses 'integer_value', 'kTrue' and
+// 'kFalse' use 'boolean_value', 'kCharacter' uses 'character_value', and
+// 'kIdentifier' and 'kString' use 'symbol_value', which refers to the name or
+// to the decoded contents of the literal in the global 'StringInterner'.
+//
+// 'integer_value' holds the magnitude of the literal, since a leading '-' is
+// lexed as a separate token. It can therefore be 2^63, which is only valid
+// when the literal is negated.
+union TokenValue {
+  std::uint64_t integer_value;
+  bool boolean_value;
+  char character_value;
+  Symbol symbol_value;
+};
+
+// A token does not own its lexeme. Instead, it stores the position of the
+// lexeme inside the source code it was produced from, which keeps the token
+// trivially copyable and avoids any heap allocation while lexing. Line and
+// column numbers are not stored either: they are recovered from the offset
+// through the 'LineTable' of the source code when they are needed.
 class Token {
 public:
-  Token(int line, int column, TokenType token_type, std::any value,
-        std::string lexeme);
+  Token() = default;
+  Token(TokenType token_type, std::uint32_t offset, std::uint32_t length,
+        TokenValue value = {});
   bool operator==(const Token &other) const;
 
-  friend std::ostream &operator<<(std::ostream &os, const Token &token);
+  std::string_view GetLexeme(std::string_view source_code) const;
+  // Decoded contents of a string literal, with its escape sequences resolved.
+  std::string_view GetStringValue() const;
+
+  // Lexemes longer than this cannot be represented by a token.
+  static constexpr std::uint32_t kMaxLength = (1 << 24) - 1;
+  // Offsets are 32-bit, so larger sources are rejected by the 'FileScanner'.
+  // The 'kFileEnd' token sits at the size of the source, which must fit too.
+  static constexpr std::size_t kMaxSourceSize =
+      std::numeric_limits<std::uint32_t>::max();
 
-  const int line_;
-  const int column_;
-  const TokenType token_type_;
-  const std::any value_;
-  const std::string lexeme_;
+  std::uint32_t offset_;
+  std::uint32_t length_ : 24;
+  TokenType token_type_ : 8;
+  TokenValue value_;
 };
+
+static_assert(sizeof(Token) <= 16);
+static_assert(Token::kMaxSourceSize <=
+              std::numeric_limits<decltype(Token::offset_)>::max());
+
+std::string TokenToString(const Token &token, std::string_view source_code,
+                          const LineTable &line_table);
+
+// Appends the line of the '.lexed' output of 'token', without the trailing
+// '\n', to 'output'. 'position' must be the resolved offset of the token.
+// This is what 'TokenToString' produces, but without any allocation when
+// 'output' has enough capacity, so that it can be called for every token of
+// a large file.
+void AppendTokenString(std::string &output, const Token &token,
+                       std::string_view source_code, LineColumn position);
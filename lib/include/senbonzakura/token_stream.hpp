@@ -0,0 +1,55 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <span>
+
+#include "senbonzakura/token.hpp"
+
+// Producer of tokens that are pulled one at a time. Every stream ends with a
+// 'kFileEnd' token, which keeps being returned once the stream is exhausted.
+class TokenStream {
+public:
+  virtual ~TokenStream() = default;
+  virtual Token NextToken() = 0;
+};
+
+// Token stream over a sequence of tokens that has already been materialized.
+class SpanTokenStream : public TokenStream {
+private:
+  std::span<const Token> tokens_;
+  std::size_t next_ = 0;
+
+public:
+  explicit SpanTokenStream(std::span<const Token> tokens);
+  Token NextToken() override;
+};
+
+// Bounded lookahead over a token stream. Tokens are pulled from the stream
+// only when they are peeked at, and only the lookahead window is kept in
+// memory, so consuming a whole file costs O(lookahead) memory instead of
+// O(file).
+class TokenCursor {
+public:
+  // How many tokens past the current one can be peeked at.
+  static constexpr std::size_t kMaxLookahead = 4;
+
+  explicit TokenCursor(TokenStream &token_stream);
+
+  Token Advance();
+  bool IsAtEnd();
+  const Token &Peek(std::size_t offset = 0);
+
+private:
+  // Ring buffer capacity. Must be a power of two greater than kMaxLookahead.
+  static constexpr std::size_t kCapacity = 8;
+  static_assert((kCapacity & (kCapacity - 1)) == 0 &&
+                kCapacity > kMaxLookahead);
+
+  void Fill(std::size_t count);
+
+  TokenStream &token_stream_;
+  std::array<Token, kCapacity> buffer_{};
+  std::size_t head_ = 0;
+  std::size_t size_ = 0;
+};
@@ -1,9 +1,13 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <format>
 #include <string>
+#include <string_view>
 
-enum class TokenType {
+enum class TokenType : std::uint8_t {
   // Single-Character Tokens.
   kLeftParen,
   kRightParen,
@@ -62,12 +66,35 @@ enum class TokenType {
   kFileEnd
 };
 
+// Names of the token types, indexed by their underlying value.
+inline constexpr std::array<std::string_view,
+                            static_cast<std::size_t>(TokenType::kFileEnd) + 1>
+    kTokenTypeNames = {
+        "kLeftParen", "kRightParen", "kLeftBracket", "kRightBracket",
+        "kLeftSquareBracket", "kRightSquareBracket", "kComma", "kColon",
+        "kSemiColon", "kPlus", "kMinus", "kRemainder", "kStar", "kSlash",
+        "kUnderscore", "kBang", "kBangEqual", "kEqual", "kEqualEqual",
+        "kGreater", "kGreaterEqual", "kLess", "kLessEqual", "kLogicalAnd",
+        "kLogicalOr", "kHighMul", "kIdentifier", "kCharacter", "kInteger",
+        "kString", "kInt", "kBool", "kIf", "kElse", "kWhile", "kReturn",
+        "kTrue", "kFalse", "kLength", "kUse", "kFileEnd"};
+// Fails when a token type is added without a name.
+static_assert(kTokenTypeNames.back() == "kFileEnd");
+
+// Same as 'TokenTypeToString', without allocating.
+constexpr std::string_view GetTokenTypeName(TokenType token_type) {
+  auto index = static_cast<std::size_t>(token_type);
+  return index < kTokenTypeNames.size() ? kTokenTypeNames[index]
+                                        : "Unknown TokenType";
+}
+
 std::string TokenTypeToString(TokenType token_type);
 
 template <>
-struct std::formatter<TokenType, char> : std::formatter<std::string, char> {
+struct std::formatter<TokenType, char>
+    : std::formatter<std::string_view, char> {
   auto format(TokenType token_type, std::format_context &ctx) const {
-    return std::formatter<std::string, char>::format(
-        TokenTypeToString(token_type), ctx);
+    return std::formatter<std::string_view, char>::format(
+        GetTokenTypeName(token_type), ctx);
   }
 };
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Chrome trace events of the compilation, which can be loaded in
+// 'chrome://tracing' or in Perfetto to see what every thread was doing.
+//
+// Every thread records its events in a buffer of its own, so recording never
+// takes a lock nor touches memory shared with other threads. Only the first
+// event of a thread takes a lock, to register its buffer. When tracing was not
+// started, a 'TraceScope' costs a single relaxed atomic load. When the library
+// is built without 'SENBONZAKURA_ENABLE_TRACING', 'TraceScope' is empty and
+// compiles away to nothing.
+
+// Whether the library was built with tracing support.
+bool IsTracingSupported();
+
+// Starts recording the events of every thread. Timestamps are relative to the
+// time it was called.
+void StartTracing();
+bool IsTracingEnabled();
+
+// Formats every event recorded so far as a Chrome trace JSON document. Must
+// only be called once the threads that recorded events are done with their
+// spans, such as after every worker was joined.
+std::string FormatTrace();
+
+#if SENBONZAKURA_ENABLE_TRACING
+
+// Records a complete event, from its construction to its destruction, on the
+// calling thread. 'name' must be a string literal. The byte and token counts
+// are added to the arguments of the event when they are set.
+class TraceScope {
+public:
+  TraceScope(const char *name, std::string_view file_path);
+  ~TraceScope();
+
+  TraceScope(const TraceScope &) = delete;
+  TraceScope &operator=(const TraceScope &) = delete;
+
+  void SetByteCount(std::size_t byte_count);
+  void SetTokenCount(std::size_t token_count);
+
+private:
+  const char *name_ = nullptr;
+  std::string_view file_path_;
+  std::chrono::steady_clock::time_point start_;
+  std::int64_t byte_count_ = -1;
+  std::int64_t token_count_ = -1;
+};
+
+#else
+
+class TraceScope {
+public:
+  TraceScope(const char *, std::string_view) {}
+
+  TraceScope(const TraceScope &) = delete;
+  TraceScope &operator=(const TraceScope &) = delete;
+
+  void SetByteCount(std::size_t) {}
+  void SetTokenCount(std::size_t) {}
+};
+
+#endif
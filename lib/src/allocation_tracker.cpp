@@ -0,0 +1,73 @@
+#include "senbonzakura/allocation_tracker.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+
+struct ThreadAllocationCounters {
+  std::uint64_t allocation_count;
+  std::uint64_t allocated_bytes;
+  std::int64_t live_bytes;
+  std::int64_t peak_live_bytes;
+};
+
+// Constant initialized, so that the hooks can use it at any point of the life
+// of a thread, including before and after its dynamic initialization.
+constinit thread_local ThreadAllocationCounters thread_allocation_counters{};
+
+std::atomic<bool> are_allocation_hooks_installed = false;
+
+} // namespace
+
+void RecordAllocation(std::size_t size) {
+  ThreadAllocationCounters &counters = thread_allocation_counters;
+  counters.allocation_count++;
+  counters.allocated_bytes += size;
+  counters.live_bytes += static_cast<std::int64_t>(size);
+  counters.peak_live_bytes =
+      std::max(counters.peak_live_bytes, counters.live_bytes);
+
+  return;
+}
+
+void RecordDeallocation(std::size_t size) {
+  thread_allocation_counters.live_bytes -= static_cast<std::int64_t>(size);
+
+  return;
+}
+
+void MarkAllocationHooksInstalled() {
+  are_allocation_hooks_installed.store(true, std::memory_order_relaxed);
+
+  return;
+}
+
+bool AreAllocationHooksInstalled() {
+  return are_allocation_hooks_installed.load(std::memory_order_relaxed);
+}
+
+AllocationScope::AllocationScope() {
+  ThreadAllocationCounters &counters = thread_allocation_counters;
+  start_allocation_count_ = counters.allocation_count;
+  start_allocated_bytes_ = counters.allocated_bytes;
+  start_live_bytes_ = counters.live_bytes;
+  enclosing_peak_live_bytes_ = counters.peak_live_bytes;
+  counters.peak_live_bytes = counters.live_bytes;
+}
+
+AllocationCounters AllocationScope::Stop() {
+  ThreadAllocationCounters &counters = thread_allocation_counters;
+  AllocationCounters allocation_counters{
+      .allocation_count = counters.allocation_count - start_allocation_count_,
+      .allocated_bytes = counters.allocated_bytes - start_allocated_bytes_,
+      .peak_live_bytes = static_cast<std::uint64_t>(std::max<std::int64_t>(
+          counters.peak_live_bytes - start_live_bytes_, 0)),
+  };
+  counters.peak_live_bytes =
+      std::max(counters.peak_live_bytes, enclosing_peak_live_bytes_);
+
+  return allocation_counters;
+}
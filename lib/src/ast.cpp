@@ -0,0 +1,118 @@
+#include "senbonzakura/ast.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+void Ast::Reserve(std::size_t token_count) {
+  // Nearly every node has a token of its own, and every node is in at most
+  // one child list.
+  nodes_.reserve(token_count + 1);
+  children_.reserve(token_count);
+
+  return;
+}
+
+AstIndex Ast::AddNode(AstNodeKind kind, std::uint32_t offset) {
+  AstNode node{.kind = kind,
+               .operator_type = TokenType::kFileEnd,
+               .offset = offset,
+               .pair = {kNoAstIndex, kNoAstIndex}};
+  nodes_.push_back(node);
+
+  return static_cast<AstIndex>(nodes_.size() - 1);
+}
+
+AstIndex Ast::AddPairNode(AstNodeKind kind, std::uint32_t offset,
+                          AstIndex first, AstIndex second) {
+  AstIndex index = AddNode(kind, offset);
+  nodes_[index].pair = {first, second};
+
+  return index;
+}
+
+AstIndex Ast::AddRangeNode(AstNodeKind kind, std::uint32_t offset,
+                           std::span<const AstIndex> children) {
+  AstRange range = AddChildren(children);
+  AstIndex index = AddNode(kind, offset);
+  nodes_[index].range = range;
+
+  return index;
+}
+
+AstIndex Ast::AddFunction(std::uint32_t offset, Symbol name,
+                          std::span<const AstIndex> parameters,
+                          std::span<const AstIndex> return_types,
+                          AstIndex body) {
+  functions_.push_back(AstFunction{
+      .name = name,
+      .parameters = AddChildren(parameters),
+      .return_types = AddChildren(return_types),
+      .body = body,
+  });
+
+  return AddPairNode(AstNodeKind::kFunction, offset,
+                     static_cast<AstIndex>(functions_.size() - 1));
+}
+
+AstIndex Ast::AddIf(std::uint32_t offset, AstIndex condition,
+                    AstIndex then_branch, AstIndex else_branch) {
+  if_statements_.push_back(AstIf{condition, then_branch, else_branch});
+
+  return AddPairNode(AstNodeKind::kIf, offset,
+                     static_cast<AstIndex>(if_statements_.size() - 1));
+}
+
+AstIndex Ast::AddAssignment(std::uint32_t offset,
+                            std::span<const AstIndex> targets,
+                            std::span<const AstIndex> values) {
+  assignments_.push_back(AstAssignment{
+      .targets = AddChildren(targets),
+      .values = AddChildren(values),
+  });
+
+  return AddPairNode(AstNodeKind::kAssignment, offset,
+                     static_cast<AstIndex>(assignments_.size() - 1));
+}
+
+AstNode &Ast::GetNode(AstIndex index) { return nodes_[index]; }
+
+void Ast::SetRoot(AstIndex root) {
+  root_ = root;
+
+  return;
+}
+
+const AstNode &Ast::GetNode(AstIndex index) const { return nodes_[index]; }
+
+std::span<const AstIndex> Ast::GetChildren(AstRange range) const {
+  return std::span<const AstIndex>{children_}.subspan(range.begin, range.count);
+}
+
+const AstFunction &Ast::GetFunction(const AstNode &node) const {
+  assert(node.kind == AstNodeKind::kFunction);
+  return functions_[node.pair.first];
+}
+
+const AstIf &Ast::GetIf(const AstNode &node) const {
+  assert(node.kind == AstNodeKind::kIf);
+  return if_statements_[node.pair.first];
+}
+
+const AstAssignment &Ast::GetAssignment(const AstNode &node) const {
+  assert(node.kind == AstNodeKind::kAssignment);
+  return assignments_[node.pair.first];
+}
+
+AstIndex Ast::GetRoot() const { return root_; }
+
+std::size_t Ast::GetNodeCount() const { return nodes_.size(); }
+
+AstRange Ast::AddChildren(std::span<const AstIndex> children) {
+  AstRange range{static_cast<std::uint32_t>(children_.size()),
+                 static_cast<std::uint32_t>(children.size())};
+  children_.insert(children_.end(), children.begin(), children.end());
+
+  return range;
+}
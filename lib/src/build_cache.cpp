@@ -0,0 +1,129 @@
+#include "senbonzakura/build_cache.hpp"
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <format>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "senbonzakura/build_id.hpp"
+#include "senbonzakura/content_hash.hpp"
+#include "senbonzakura/diagnostic_reporter.hpp"
+#include "senbonzakura/lexedb.hpp"
+#include "senbonzakura/token.hpp"
+
+namespace {
+
+// Hash of the library sources, generated by the build.
+constexpr std::string_view kBuildId = SENBONZAKURA_BUILD_ID;
+
+// Distinguishes the temporary files written by the threads of a process.
+std::atomic<std::uint64_t> temporary_file_counter = 0;
+
+bool WriteFile(const std::string &file_path, std::string_view bytes) {
+  int file_descriptor =
+      open(file_path.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+  if (file_descriptor == -1) {
+    return false;
+  }
+
+  while (!bytes.empty()) {
+    ssize_t written = write(file_descriptor, bytes.data(), bytes.size());
+    if (written == -1) {
+      if (errno == EINTR) {
+        continue;
+      }
+      close(file_descriptor);
+      return false;
+    }
+    bytes.remove_prefix(static_cast<std::size_t>(written));
+  }
+
+  return close(file_descriptor) == 0;
+}
+
+} // namespace
+
+BuildCache::BuildCache(std::string directory)
+    : directory_{std::move(directory)} {}
+
+const std::string &BuildCache::GetDirectory() const { return directory_; }
+
+BuildCache::Key BuildCache::ComputeKey(std::string_view source_code) {
+  // The version of every cached format and the identity of the build are part
+  // of the seed, so that entries written by other versions of the compiler are
+  // never found, even when a change forgot to bump 'kBuildCacheVersion'.
+  std::string compiler_identity =
+      std::format("{}-cache-{}-lexedb-{}", kBuildId, kBuildCacheVersion,
+                  kLexedbVersion);
+
+  return Key{HashContent(source_code, HashContent(compiler_identity))};
+}
+
+std::optional<std::vector<Token>>
+BuildCache::LoadTokens(Key key, std::size_t source_size) const {
+  std::string entry_path = GetEntryPath(key, ".lexedb");
+  std::error_code error_code;
+  if (!std::filesystem::exists(entry_path, error_code)) {
+    return std::nullopt;
+  }
+
+  // A damaged entry is treated as a miss, and replaced on the next store.
+  DiagnosticReporter diagnostic_reporter;
+  LexedbReader lexedb_reader;
+  if (!lexedb_reader.Load(entry_path, diagnostic_reporter) ||
+      lexedb_reader.GetSourceSize() != source_size ||
+      lexedb_reader.GetTokenCount() == 0) {
+    return std::nullopt;
+  }
+
+  std::vector<Token> tokens;
+  tokens.reserve(lexedb_reader.GetTokenCount());
+  for (std::size_t i = 0; i < lexedb_reader.GetTokenCount(); i++) {
+    tokens.push_back(lexedb_reader.GetToken(i));
+  }
+
+  return tokens;
+}
+
+bool BuildCache::StoreTokens(Key key, const std::vector<Token> &tokens,
+                             std::string_view source_code) const {
+  std::error_code error_code;
+  std::filesystem::create_directories(directory_, error_code);
+  if (error_code) {
+    return false;
+  }
+
+  std::string entry_path = GetEntryPath(key, ".lexedb");
+  std::string temporary_path =
+      std::format("{}.{}.{}.tmp", entry_path, getpid(),
+                  temporary_file_counter.fetch_add(1));
+  if (!WriteFile(temporary_path, SerializeLexedb(tokens, source_code))) {
+    std::remove(temporary_path.c_str());
+    return false;
+  }
+  // rename() atomically replaces any entry written meanwhile by another
+  // process, which holds the same bytes anyway.
+  if (std::rename(temporary_path.c_str(), entry_path.c_str()) != 0) {
+    std::remove(temporary_path.c_str());
+    return false;
+  }
+
+  return true;
+}
+
+std::string BuildCache::GetEntryPath(Key key,
+                                     std::string_view extension) const {
+  return std::format("{}/{:016x}{}", directory_, key.hash, extension);
+}
@@ -0,0 +1,189 @@
+#include "senbonzakura/compilation_driver.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "senbonzakura/ast.hpp"
+#include "senbonzakura/build_cache.hpp"
+#include "senbonzakura/file_scanner.hpp"
+#include "senbonzakura/parallel_lexer.hpp"
+#include "senbonzakura/parser.hpp"
+#include "senbonzakura/perf_counters.hpp"
+#include "senbonzakura/thread_pool.hpp"
+#include "senbonzakura/time_report.hpp"
+#include "senbonzakura/token.hpp"
+#include "senbonzakura/token_stream.hpp"
+#include "senbonzakura/trace.hpp"
+
+namespace {
+
+// The '.parsed' output of a file with errors is only its first error, as the
+// course tools expect, even though every error is reported.
+void WriteParserOutput(const std::string &file_path, const Ast &ast,
+                       const DiagnosticReporter &diagnostic_reporter,
+                       const FileWriter &file_writer,
+                       const CompilationOptions &options) {
+  for (const CompilerError &compiler_error :
+       diagnostic_reporter.GetCompilerErrors()) {
+    if (compiler_error.severity != Severity::kWarning) {
+      file_writer.WriteParserError(file_path, compiler_error);
+      return;
+    }
+  }
+  // A file that could not be read has neither a tree nor a located error.
+  if (ast.GetRoot() != kNoAstIndex) {
+    file_writer.WriteParserOutput(file_path, ast, options.pretty_print_parsed);
+  }
+
+  return;
+}
+
+} // namespace
+
+bool FileCompilationResult::HasFailed() const {
+  return diagnostic_reporter.HasNormalErrors() ||
+         diagnostic_reporter.HasFatalErrors();
+}
+
+FileCompilationResult CompileFile(const std::string &file_path,
+                                  const FileWriter &file_writer,
+                                  const CompilationOptions &options) {
+  TraceScope trace_scope{"CompileFile", file_path};
+  FileCompilationResult result;
+  result.file_path = file_path;
+  TimeReport &time_report = result.time_report;
+  PerfCounterReport *perf_counter_report =
+      options.measure_perf_counters ? &result.perf_counter_report : nullptr;
+  // Every phase is timed, and has its events counted with
+  // 'options.measure_perf_counters'.
+  auto measure_phase = [&](std::string_view phase_name,
+                           auto &&function) -> decltype(auto) {
+    PerfCounterScope perf_counter_scope{perf_counter_report, phase_name};
+    return time_report.MeasurePhase(phase_name, function);
+  };
+  result.diagnostic_reporter.SetErrorLimit(options.max_error_count);
+  result.diagnostic_reporter.SetSink(options.diagnostic_sink);
+  FileScanner file_scanner{file_path, result.diagnostic_reporter};
+
+  measure_phase("scan", [&]() { file_scanner.ScanFile(); });
+  std::string_view file_content = file_scanner.GetFileContentBytes();
+
+  std::optional<BuildCache> build_cache;
+  BuildCache::Key cache_key{};
+  std::optional<std::vector<Token>> cached_tokens;
+  if (!options.cache_directory.empty() &&
+      !result.diagnostic_reporter.HasFatalErrors()) {
+    build_cache.emplace(options.cache_directory);
+    cached_tokens = measure_phase("cache", [&]() {
+      cache_key = BuildCache::ComputeKey(file_content);
+      return build_cache->LoadTokens(cache_key, file_content.size());
+    });
+  }
+
+  std::vector<Token> tokens;
+  if (cached_tokens) {
+    // Only files without any diagnostic are cached, so there is nothing to
+    // report.
+    tokens = std::move(*cached_tokens);
+    result.is_cached = true;
+  } else {
+    tokens = measure_phase("lex", [&]() {
+      return LexTokensInParallel(file_path, file_content,
+                                 result.diagnostic_reporter,
+                                 options.lex_thread_count);
+    });
+  }
+
+  // The '.lexed' output needs every token, so they are materialized once and
+  // handed to the parser without being copied. A file that could not be read
+  // or lexed has no tokens worth parsing, and a cached file is known to parse
+  // without errors, so it is only parsed again for its '.parsed' output.
+  Ast ast;
+  if (!result.diagnostic_reporter.HasFatalErrors() &&
+      (!result.is_cached || options.emit_parsed)) {
+    measure_phase("parse", [&]() {
+      SpanTokenStream token_stream{tokens};
+      Parser parser{file_path, file_content, token_stream,
+                    result.diagnostic_reporter};
+      parser.Reserve(tokens.size());
+      ast = parser.Parse();
+    });
+  }
+
+  if (!result.is_cached) {
+    if (build_cache && !result.diagnostic_reporter.HasWarnings() &&
+        !result.HasFailed()) {
+      measure_phase("cache", [&]() {
+        build_cache->StoreTokens(cache_key, tokens, file_content);
+      });
+    }
+  }
+
+  measure_phase("write", [&]() {
+    if (options.emit_lexed) {
+      file_writer.WriteLexerOutput(file_path, tokens, file_content);
+    }
+    if (options.emit_lexedb) {
+      file_writer.WriteLexedbOutput(file_path, tokens, file_content);
+    }
+    if (options.emit_parsed) {
+      WriteParserOutput(file_path, ast, result.diagnostic_reporter,
+                        file_writer, options);
+    }
+  });
+
+  time_report.SetByteCount(file_content.size());
+  time_report.SetTokenCount(tokens.size());
+  time_report.SetPeakResidentSetSize(GetPeakResidentSetSize());
+  result.perf_counter_report.SetByteCount(file_content.size());
+  trace_scope.SetByteCount(file_content.size());
+  trace_scope.SetTokenCount(tokens.size());
+  result.diagnostic_reporter.StreamSuppressedErrorCount(file_path);
+
+  return result;
+}
+
+std::size_t CompileFiles(
+    const std::vector<std::string> &file_paths, const FileWriter &file_writer,
+    const CompilationOptions &options,
+    const std::function<void(const FileCompilationResult &)>
+        &on_file_compiled) {
+  std::size_t failed_file_count = 0;
+
+  if (options.job_count <= 1 || file_paths.size() <= 1) {
+    for (const std::string &file_path : file_paths) {
+      FileCompilationResult result =
+          CompileFile(file_path, file_writer, options);
+      failed_file_count += result.HasFailed();
+      on_file_compiled(result);
+    }
+    return failed_file_count;
+  }
+
+  ThreadPool thread_pool{std::min(options.job_count, file_paths.size())};
+  std::vector<std::future<FileCompilationResult>> results;
+  results.reserve(file_paths.size());
+  for (const std::string &file_path : file_paths) {
+    results.push_back(
+        thread_pool.Submit([&file_path, &file_writer, &options]() {
+          return CompileFile(file_path, file_writer, options);
+        }));
+  }
+
+  // Waiting on the futures in order emits the results of the first files while
+  // the following ones are still being compiled.
+  for (std::future<FileCompilationResult> &future : results) {
+    FileCompilationResult result = future.get();
+    failed_file_count += result.HasFailed();
+    on_file_compiled(result);
+  }
+
+  return failed_file_count;
+}
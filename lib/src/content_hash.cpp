@@ -0,0 +1,109 @@
+#include "senbonzakura/content_hash.hpp"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace {
+
+constexpr std::uint64_t kPrime1 = 0x9E3779B185EBCA87;
+constexpr std::uint64_t kPrime2 = 0xC2B2AE3D27D4EB4F;
+constexpr std::uint64_t kPrime3 = 0x165667B19E3779F9;
+constexpr std::uint64_t kPrime4 = 0x85EBCA77C2B2AE63;
+constexpr std::uint64_t kPrime5 = 0x27D4EB2F165667C5;
+
+// The specification reads the input as little-endian words.
+std::uint64_t Read64(const char *data) {
+  std::uint64_t word;
+  std::memcpy(&word, data, sizeof(word));
+  if constexpr (std::endian::native == std::endian::big) {
+    word = __builtin_bswap64(word);
+  }
+
+  return word;
+}
+
+std::uint32_t Read32(const char *data) {
+  std::uint32_t word;
+  std::memcpy(&word, data, sizeof(word));
+  if constexpr (std::endian::native == std::endian::big) {
+    word = __builtin_bswap32(word);
+  }
+
+  return word;
+}
+
+std::uint64_t Round(std::uint64_t accumulator, std::uint64_t input) {
+  accumulator += input * kPrime2;
+  accumulator = std::rotl(accumulator, 31);
+
+  return accumulator * kPrime1;
+}
+
+std::uint64_t MergeRound(std::uint64_t hash, std::uint64_t accumulator) {
+  hash ^= Round(0, accumulator);
+
+  return hash * kPrime1 + kPrime4;
+}
+
+} // namespace
+
+std::uint64_t HashContent(std::string_view bytes, std::uint64_t seed) {
+  const char *position = bytes.data();
+  const char *end = position + bytes.size();
+  std::uint64_t hash;
+
+  if (bytes.size() >= 32) {
+    // Four independent lanes, so that the multiplications of consecutive
+    // words overlap in the pipeline.
+    std::uint64_t lane_1 = seed + kPrime1 + kPrime2;
+    std::uint64_t lane_2 = seed + kPrime2;
+    std::uint64_t lane_3 = seed;
+    std::uint64_t lane_4 = seed - kPrime1;
+    const char *last_stripe = end - 32;
+    while (position <= last_stripe) {
+      lane_1 = Round(lane_1, Read64(position));
+      lane_2 = Round(lane_2, Read64(position + 8));
+      lane_3 = Round(lane_3, Read64(position + 16));
+      lane_4 = Round(lane_4, Read64(position + 24));
+      position += 32;
+    }
+
+    hash = std::rotl(lane_1, 1) + std::rotl(lane_2, 7) +
+           std::rotl(lane_3, 12) + std::rotl(lane_4, 18);
+    hash = MergeRound(hash, lane_1);
+    hash = MergeRound(hash, lane_2);
+    hash = MergeRound(hash, lane_3);
+    hash = MergeRound(hash, lane_4);
+  } else {
+    hash = seed + kPrime5;
+  }
+
+  hash += static_cast<std::uint64_t>(bytes.size());
+
+  while (end - position >= 8) {
+    hash ^= Round(0, Read64(position));
+    hash = std::rotl(hash, 27) * kPrime1 + kPrime4;
+    position += 8;
+  }
+  if (end - position >= 4) {
+    hash ^= static_cast<std::uint64_t>(Read32(position)) * kPrime1;
+    hash = std::rotl(hash, 23) * kPrime2 + kPrime3;
+    position += 4;
+  }
+  while (position < end) {
+    hash ^= static_cast<unsigned char>(*position) * kPrime5;
+    hash = std::rotl(hash, 11) * kPrime1;
+    position++;
+  }
+
+  hash ^= hash >> 33;
+  hash *= kPrime2;
+  hash ^= hash >> 29;
+  hash *= kPrime3;
+  hash ^= hash >> 32;
+
+  return hash;
+}
@@ -2,7 +2,22 @@
 
 #include <format>
 #include <iostream>
+#include <iterator>
 #include <string>
+#include <string_view>
+#include <utility>
+
+#include "senbonzakura/diagnostic_sink.hpp"
+#include "senbonzakura/string_interner.hpp"
+
+std::string_view StripSeverityTag(std::string_view message) {
+  if (message.size() >= 5 && message[0] == '[' && message[2] == ']' &&
+      message[3] == ':' && message[4] == ' ') {
+    message.remove_prefix(5);
+  }
+
+  return message;
+}
 
 std::string SeverityToString(Severity severity) {
   static const std::string severity_strings[] = {"Warning", "Error", "Fatal"};
@@ -10,32 +25,69 @@ std::string SeverityToString(Severity severity) {
   return severity_strings[static_cast<int>(severity)];
 }
 
+namespace {
+
+void AppendLocation(std::string &output, const SourceCodeLocation &loc) {
+  std::format_to(std::back_inserter(output),
+                 "[Source File: '{}' - Line: {} - Column: {}]",
+                 GetStringInterner().GetString(loc.file), loc.line,
+                 loc.column);
+
+  return;
+}
+
+void AppendCompilerError(std::string &output,
+                         const CompilerError &compiler_error) {
+  std::format_to(std::back_inserter(output),
+                 "[{}] - [Location]:", compiler_error.severity);
+  AppendLocation(output, compiler_error.location);
+  output += " - [Message]:";
+  compiler_error.message.FormatTo(output);
+
+  return;
+}
+
+void AppendSystemError(std::string &output, const SystemError &system_error) {
+  std::format_to(std::back_inserter(output),
+                 "[{}] - [Message]:", system_error.severity);
+  system_error.message.FormatTo(output);
+
+  return;
+}
+
+} // namespace
+
 std::ostream &operator<<(std::ostream &os,
                          const SourceCodeLocation &source_code_location) {
-  os << std::format("[Source File: '{}' - Line: {} - Column: {}]",
-                    source_code_location.source_name, source_code_location.line,
-                    source_code_location.column);
+  std::string output;
+  AppendLocation(output, source_code_location);
+  os << output;
   return os;
 }
 
+void DiagnosticMessage::FormatTo(std::string &output) const {
+  std::vformat_to(std::back_inserter(output), format,
+                  std::make_format_args(argument));
+
+  return;
+}
+
 std::ostream &operator<<(std::ostream &os,
                          const CompilerError &compiler_error) {
-  os << std::format("[{}] - [Location]:{} - [Message]:{}",
-                    compiler_error.compiler_error_severity,
-                    compiler_error.source_code_location,
-                    compiler_error.compiler_error_message);
+  std::string output;
+  AppendCompilerError(output, compiler_error);
+  os << output;
   return os;
 }
 
 std::ostream &operator<<(std::ostream &os, const SystemError &system_error) {
-  os << std::format("[{}] - [Message]:{}", system_error.system_error_severity,
-                    system_error.system_error_message);
+  std::string output;
+  AppendSystemError(output, system_error);
+  os << output;
   return os;
 }
 
-void DiagnosticReporter::ReportCompilerError(SourceCodeLocation loc,
-                                             Severity sev, std::string msg) {
-  compiler_errors_.emplace_back(CompilerError(std::move(msg), loc, sev));
+void DiagnosticReporter::CountDiagnostic(Severity sev) {
   if (sev == Severity::kWarning) {
     warning_count_++;
   } else if (sev == Severity::kError) {
@@ -47,23 +99,121 @@ void DiagnosticReporter::ReportCompilerError(SourceCodeLocation loc,
   return;
 }
 
+void DiagnosticReporter::KeepCompilerError(CompilerError compiler_error) {
+  if (compiler_error.severity != Severity::kWarning) {
+    if (HasReachedErrorLimit()) {
+      suppressed_error_count_++;
+      return;
+    }
+    kept_error_count_++;
+  }
+  if (sink_ != nullptr) {
+    sink_->Emit(compiler_error);
+  }
+  compiler_errors_.push_back(std::move(compiler_error));
+
+  return;
+}
+
+void DiagnosticReporter::SetErrorLimit(std::size_t error_limit) {
+  error_limit_ = error_limit;
+
+  return;
+}
+
+bool DiagnosticReporter::HasReachedErrorLimit() const {
+  return error_limit_ != 0 && kept_error_count_ >= error_limit_;
+}
+
+std::size_t DiagnosticReporter::GetSuppressedErrorCount() const {
+  return suppressed_error_count_;
+}
+
+void DiagnosticReporter::SetSink(DiagnosticSink *sink) {
+  sink_ = sink;
+
+  return;
+}
+
+void DiagnosticReporter::StreamSuppressedErrorCount(
+    std::string_view file_path) const {
+  if (sink_ == nullptr || suppressed_error_count_ == 0) {
+    return;
+  }
+  // A system error has no location, so the message names the file.
+  sink_->Emit(SystemError{
+      DiagnosticMessage{
+          .argument = std::format("[E]: {} more errors were found in '{}' but "
+                                  "not shown, since the limit of errors per "
+                                  "file was reached.",
+                                  suppressed_error_count_, file_path)},
+      Severity::kError});
+
+  return;
+}
+
+void DiagnosticReporter::ReportCompilerError(SourceCodeLocation loc,
+                                             Severity sev, std::string msg) {
+  ReportCompilerError(loc, sev, DiagnosticMessage{.argument = std::move(msg)});
+
+  return;
+}
+
+void DiagnosticReporter::ReportCompilerError(SourceCodeLocation loc,
+                                             Severity sev,
+                                             DiagnosticMessage msg) {
+  CountDiagnostic(sev);
+  KeepCompilerError(CompilerError{std::move(msg), loc, sev});
+
+  return;
+}
+
 void DiagnosticReporter::ReportSystemError(Severity sev, std::string msg) {
-  system_errors_.emplace_back(SystemError(std::move(msg), sev));
-  if (sev == Severity::kWarning) {
-    warning_count_++;
-  } else if (sev == Severity::kError) {
-    normal_error_count_++;
-  } else {
-    fatal_error_count_++;
+  ReportSystemError(sev, DiagnosticMessage{.argument = std::move(msg)});
+
+  return;
+}
+
+void DiagnosticReporter::ReportSystemError(Severity sev,
+                                           DiagnosticMessage msg) {
+  // System errors are about the files rather than their contents, so there
+  // are too few of them to be limited.
+  CountDiagnostic(sev);
+  system_errors_.push_back(SystemError{std::move(msg), sev});
+  if (sink_ != nullptr) {
+    sink_->Emit(system_errors_.back());
   }
 
   return;
 }
 
+void DiagnosticReporter::Merge(const DiagnosticReporter &other) {
+  for (const CompilerError &compiler_error : other.compiler_errors_) {
+    KeepCompilerError(compiler_error);
+  }
+  for (const SystemError &system_error : other.system_errors_) {
+    system_errors_.push_back(system_error);
+    if (sink_ != nullptr) {
+      sink_->Emit(system_error);
+    }
+  }
+  warning_count_ += other.warning_count_;
+  normal_error_count_ += other.normal_error_count_;
+  fatal_error_count_ += other.fatal_error_count_;
+  suppressed_error_count_ += other.suppressed_error_count_;
+
+  return;
+}
+
 bool DiagnosticReporter::HasFatalErrors() const {
   return fatal_error_count_ > 0;
 }
 
+const std::vector<CompilerError> &
+DiagnosticReporter::GetCompilerErrors() const {
+  return compiler_errors_;
+}
+
 bool DiagnosticReporter::HasNormalErrors() const {
   return normal_error_count_ > 0;
 }
@@ -71,17 +221,38 @@ bool DiagnosticReporter::HasNormalErrors() const {
 bool DiagnosticReporter::HasWarnings() const { return warning_count_ > 0; }
 
 void DiagnosticReporter::OutputCompilerErrors() const {
+  // The whole batch is written at once, instead of flushing every line.
+  std::string output;
   for (const CompilerError &curr_compiler_error : compiler_errors_) {
-    std::cout << kAnsiRed << curr_compiler_error << kAnsiReset << std::endl;
+    output += kAnsiRed;
+    AppendCompilerError(output, curr_compiler_error);
+    output += kAnsiReset + '\n';
+  }
+  if (suppressed_error_count_ > 0) {
+    output += kAnsiRed;
+    AppendSystemError(
+        output, SystemError{DiagnosticMessage{
+                                .format = "[E]: {} more errors were found but "
+                                          "not shown, since the limit of "
+                                          "errors per file was reached.",
+                                .argument =
+                                    std::to_string(suppressed_error_count_)},
+                            Severity::kError});
+    output += kAnsiReset + '\n';
   }
+  std::cout << output;
 
   return;
 }
 
 void DiagnosticReporter::OutputSystemErrors() const {
+  std::string output;
   for (const SystemError &curr_system_error : system_errors_) {
-    std::cout << kAnsiRed << curr_system_error << kAnsiReset << std::endl;
+    output += kAnsiRed;
+    AppendSystemError(output, curr_system_error);
+    output += kAnsiReset + '\n';
   }
+  std::cout << output;
 
   return;
 }
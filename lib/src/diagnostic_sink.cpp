@@ -0,0 +1,172 @@
+#include "senbonzakura/diagnostic_sink.hpp"
+
+#include <cerrno>
+#include <cstddef>
+#include <format>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include <unistd.h>
+
+#include "senbonzakura/diagnostic_reporter.hpp"
+#include "senbonzakura/json.hpp"
+#include "senbonzakura/string_interner.hpp"
+
+namespace {
+
+std::string_view GetJsonSeverity(Severity severity) {
+  switch (severity) {
+  case Severity::kWarning:
+    return "warning";
+  case Severity::kError:
+    return "error";
+  case Severity::kFatal:
+    break;
+  }
+
+  return "fatal";
+}
+
+} // namespace
+
+DiagnosticSink::DiagnosticSink(int fd) : fd_(fd) {}
+
+void DiagnosticSink::Emit(const CompilerError &compiler_error) {
+  std::lock_guard lock{mutex_};
+  message_.clear();
+  compiler_error.message.FormatTo(message_);
+  AppendRecord(compiler_error, StripSeverityTag(message_));
+  WriteRecord();
+
+  return;
+}
+
+void DiagnosticSink::Emit(const SystemError &system_error) {
+  std::lock_guard lock{mutex_};
+  message_.clear();
+  system_error.message.FormatTo(message_);
+  AppendRecord(system_error, StripSeverityTag(message_));
+  WriteRecord();
+
+  return;
+}
+
+void DiagnosticSink::Finish() {
+  std::lock_guard lock{mutex_};
+  AppendEnd();
+  WriteRecord();
+
+  return;
+}
+
+bool DiagnosticSink::HasWriteError() const { return has_write_error_; }
+
+void DiagnosticSink::AppendEnd() { return; }
+
+void DiagnosticSink::WriteRecord() {
+  std::size_t written = 0;
+  while (!has_write_error_ && written < record_.size()) {
+    ssize_t result =
+        write(fd_, record_.data() + written, record_.size() - written);
+    if (result < 0 && errno != EINTR) {
+      has_write_error_ = true;
+    } else if (result > 0) {
+      written += result;
+    }
+  }
+  record_.clear();
+
+  return;
+}
+
+JsonLinesDiagnosticSink::JsonLinesDiagnosticSink(int fd)
+    : DiagnosticSink(fd) {}
+
+void JsonLinesDiagnosticSink::AppendRecord(const CompilerError &compiler_error,
+                                           std::string_view message) {
+  const SourceCodeLocation &location = compiler_error.location;
+  std::format_to(std::back_inserter(record_), "{{\"severity\":\"{}\",\"file\":",
+                 GetJsonSeverity(compiler_error.severity));
+  AppendJsonString(record_, GetStringInterner().GetString(location.file));
+  std::format_to(std::back_inserter(record_),
+                 ",\"line\":{},\"column\":{},\"offset\":{},\"length\":{},"
+                 "\"message\":",
+                 location.line, location.column, location.offset,
+                 location.length);
+  AppendJsonString(record_, message);
+  record_ += "}\n";
+
+  return;
+}
+
+void JsonLinesDiagnosticSink::AppendRecord(const SystemError &system_error,
+                                           std::string_view message) {
+  std::format_to(std::back_inserter(record_),
+                 "{{\"severity\":\"{}\",\"message\":",
+                 GetJsonSeverity(system_error.severity));
+  AppendJsonString(record_, message);
+  record_ += "}\n";
+
+  return;
+}
+
+SarifDiagnosticSink::SarifDiagnosticSink(int fd) : DiagnosticSink(fd) {
+  // Columns count bytes, like 'LineTable'. SARIF has no such unit, and Eta
+  // source files are ASCII, where code points and bytes are the same.
+  record_ = "{\"version\":\"2.1.0\",\"$schema\":"
+            "\"https://json.schemastore.org/sarif-2.1.0.json\","
+            "\"runs\":[{\"tool\":{\"driver\":{\"name\":\"senbonzakura\"}},"
+            "\"columnKind\":\"unicodeCodePoints\",\"results\":[";
+  WriteRecord();
+}
+
+void SarifDiagnosticSink::AppendResultStart(Severity severity,
+                                            std::string_view message) {
+  if (has_results_) {
+    record_ += ",";
+  }
+  has_results_ = true;
+  // SARIF has no fatal level. Fatal errors are still told apart by the
+  // 'severity' property.
+  std::format_to(std::back_inserter(record_),
+                 "\n{{\"level\":\"{}\",\"properties\":{{\"severity\":\"{}\"}},"
+                 "\"message\":{{\"text\":",
+                 severity == Severity::kWarning ? "warning" : "error",
+                 GetJsonSeverity(severity));
+  AppendJsonString(record_, message);
+  record_ += "}";
+
+  return;
+}
+
+void SarifDiagnosticSink::AppendRecord(const CompilerError &compiler_error,
+                                       std::string_view message) {
+  const SourceCodeLocation &location = compiler_error.location;
+  AppendResultStart(compiler_error.severity, message);
+  record_ += ",\"locations\":[{\"physicalLocation\":{\"artifactLocation\":"
+             "{\"uri\":";
+  AppendJsonString(record_, GetStringInterner().GetString(location.file));
+  std::format_to(std::back_inserter(record_),
+                 "}},\"region\":{{\"startLine\":{},\"startColumn\":{},"
+                 "\"byteOffset\":{},\"byteLength\":{}}}}}}}]}}",
+                 location.line, location.column, location.offset,
+                 location.length);
+
+  return;
+}
+
+void SarifDiagnosticSink::AppendRecord(const SystemError &system_error,
+                                       std::string_view message) {
+  AppendResultStart(system_error.severity, message);
+  record_ += "}";
+
+  return;
+}
+
+void SarifDiagnosticSink::AppendEnd() {
+  record_ += "\n]}]}\n";
+
+  return;
+}
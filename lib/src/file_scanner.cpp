@@ -1,10 +1,13 @@
 #include "senbonzakura/file_scanner.hpp"
 #include "senbonzakura/diagnostic_reporter.hpp"
 
+#include <cstdint>
 #include <filesystem>
-#include <format>
-#include <fstream>
 #include <iostream>
+#include <system_error>
+
+#include "senbonzakura/token.hpp"
+#include "senbonzakura/trace.hpp"
 
 FileScanner::FileScanner(std::string file_path,
                          DiagnosticReporter &diagnostic_reporter)
@@ -15,37 +18,58 @@ const DiagnosticReporter &FileScanner::GetDiagnosticReporter() const {
   return diagnostic_reporter_;
 }
 
-const std::string &FileScanner::GetFileContentBytes() const {
-  return file_content_bytes_;
+std::string_view FileScanner::GetFileContentBytes() const {
+  return source_buffer_.View();
 }
 
 const std::string &FileScanner::GetFilePath() const { return file_path_; }
 
 void FileScanner::ScanFile() {
+  TraceScope trace_scope{"FileScanner::ScanFile", file_path_};
   std::filesystem::path path{file_path_};
   if (path.extension() != ".eta") {
     diagnostic_reporter_.ReportSystemError(
         Severity::kFatal,
-        std::format(
-            "[E]: Could not read the provided file '{}' because it is not an "
-            "Eta file. Eta files must have the '.eta' extension.",
-            file_path_));
+        DiagnosticMessage{
+            .format = "[E]: Could not read the provided file '{}' because it "
+                      "is not an Eta file. Eta files must have the '.eta' "
+                      "extension.",
+            .argument = file_path_});
     return;
   }
 
-  std::ifstream file{file_path_,
-                     std::ios::in | std::ios::binary | std::ios::ate};
-  if (!file) {
+  // Regular files are checked before being mapped, and anything else, such as
+  // a pipe, once it has been read.
+  auto report_too_large_file = [&]() {
     diagnostic_reporter_.ReportSystemError(
         Severity::kFatal,
-        std::format("[E]: Could not open the provided file '{}'.", file_path_));
+        DiagnosticMessage{
+            .format = "[E]: Could not read the provided file '{}' because it "
+                      "is larger than 4 GiB, the largest size that token "
+                      "offsets can represent.",
+            .argument = file_path_});
+  };
+  std::error_code error_code;
+  std::uintmax_t file_size = std::filesystem::file_size(path, error_code);
+  if (!error_code && file_size > Token::kMaxSourceSize) {
+    report_too_large_file();
     return;
   }
 
-  file_content_bytes_.resize(file.tellg());
-  file.seekg(0, std::ios::beg);
-  file.read(file_content_bytes_.data(), file_content_bytes_.size());
-  file.close();
+  if (!source_buffer_.Load(file_path_)) {
+    diagnostic_reporter_.ReportSystemError(
+        Severity::kFatal,
+        DiagnosticMessage{
+            .format = "[E]: Could not open the provided file '{}'.",
+            .argument = file_path_});
+    return;
+  }
+  if (source_buffer_.Size() > Token::kMaxSourceSize) {
+    source_buffer_ = SourceBuffer{};
+    report_too_large_file();
+    return;
+  }
+  trace_scope.SetByteCount(source_buffer_.Size());
 
   return;
 }
@@ -1,9 +1,483 @@
 #include "senbonzakura/file_writer.hpp"
 
+#include <cerrno>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <filesystem>
 #include <format>
-#include <fstream>
+#include <iterator>
+#include <limits>
+#include <span>
 #include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "senbonzakura/ast.hpp"
+#include "senbonzakura/diagnostic_reporter.hpp"
+#include "senbonzakura/lexedb.hpp"
+#include "senbonzakura/line_table.hpp"
+#include "senbonzakura/literal_decoder.hpp"
+#include "senbonzakura/string_interner.hpp"
+#include "senbonzakura/token_type.hpp"
+#include "senbonzakura/trace.hpp"
+
+namespace {
+
+// The buffer is written out once it holds this many bytes.
+constexpr std::size_t kOutputBufferSize = 1 << 20;
+// Extra capacity, so that the line that crosses 'kOutputBufferSize' does not
+// make the buffer grow unless it is unusually long.
+constexpr std::size_t kOutputLineReserve = 4096;
+
+void WriteAll(int file_descriptor, std::string_view bytes,
+              const std::string &file_path) {
+  while (!bytes.empty()) {
+    ssize_t written = write(file_descriptor, bytes.data(), bytes.size());
+    if (written == -1) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw std::runtime_error{
+          std::format("The file '{}' could not be written: {}.", file_path,
+                      std::strerror(errno))};
+    }
+    bytes.remove_prefix(static_cast<std::size_t>(written));
+  }
+
+  return;
+}
+
+int CreateOutputFile(const std::string &file_path) {
+  int file_descriptor = open(file_path.c_str(),
+                             O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (file_descriptor == -1) {
+    throw std::runtime_error{
+        std::format("The file '{}' could not be created: {}.", file_path,
+                    std::strerror(errno))};
+  }
+
+  return file_descriptor;
+}
+
+std::string_view GetOperatorLexeme(TokenType token_type) {
+  switch (token_type) {
+  case TokenType::kLogicalOr:
+    return "|";
+  case TokenType::kLogicalAnd:
+    return "&";
+  case TokenType::kEqualEqual:
+    return "==";
+  case TokenType::kBangEqual:
+    return "!=";
+  case TokenType::kLess:
+    return "<";
+  case TokenType::kLessEqual:
+    return "<=";
+  case TokenType::kGreater:
+    return ">";
+  case TokenType::kGreaterEqual:
+    return ">=";
+  case TokenType::kPlus:
+    return "+";
+  case TokenType::kMinus:
+    return "-";
+  case TokenType::kStar:
+    return "*";
+  case TokenType::kHighMul:
+    return "*>>";
+  case TokenType::kSlash:
+    return "/";
+  case TokenType::kRemainder:
+    return "%";
+  case TokenType::kBang:
+    return "!";
+  default:
+    return GetTokenTypeName(token_type);
+  }
+}
+
+// Pending work of 'SExpressionWriter'.
+struct SExpressionItem {
+  enum class Action : std::uint8_t {
+    // Writes 'node'.
+    kNode,
+    // Writes 'node', an integer or character literal, with a minus sign.
+    kNegatedLiteral,
+    // Writes the nodes of 'range' as a list.
+    kList,
+    // Closes the innermost list.
+    kClose,
+  };
+
+  Action action;
+  // Whether the item starts on its own line, when pretty-printing.
+  bool starts_line = false;
+  // Whether the nodes of 'range' start on their own lines.
+  bool elements_start_lines = false;
+  AstIndex node = kNoAstIndex;
+  AstRange range = {};
+};
+
+// Writes the S-expression of a tree in the format of the '.parsed' output.
+// Instead of recursing, items are pushed to an explicit stack, children in
+// reverse order, so the depth of the tree is only bounded by memory. The
+// buffer and the stack are owned by the caller, so that they can be reused
+// for every file, and writing a node never allocates once they are large
+// enough.
+class SExpressionWriter {
+public:
+  SExpressionWriter(const Ast &ast, bool is_pretty_printed,
+                    std::string &buffer, std::vector<SExpressionItem> &stack,
+                    int file_descriptor, const std::string &file_path)
+      : ast_{ast}, is_pretty_printed_{is_pretty_printed}, buffer_{buffer},
+        stack_{stack}, file_descriptor_{file_descriptor},
+        file_path_{file_path} {}
+
+  void Write(AstIndex root) {
+    PushNode(root);
+    while (!stack_.empty()) {
+      SExpressionItem item = stack_.back();
+      stack_.pop_back();
+      switch (item.action) {
+      case SExpressionItem::Action::kNode:
+        WriteNode(item.node, item.starts_line);
+        break;
+      case SExpressionItem::Action::kNegatedLiteral:
+        AppendSeparator(item.starts_line);
+        buffer_ += '-';
+        AppendLiteral(ast_.GetNode(item.node));
+        break;
+      case SExpressionItem::Action::kList:
+        OpenList({}, item.starts_line);
+        PushClose();
+        PushElements(item.range, item.elements_start_lines);
+        break;
+      case SExpressionItem::Action::kClose:
+        buffer_ += ')';
+        depth_--;
+        is_at_list_start_ = false;
+        break;
+      }
+
+      if (buffer_.size() >= kOutputBufferSize) {
+        WriteAll(file_descriptor_, buffer_, file_path_);
+        buffer_.clear();
+      }
+    }
+    buffer_ += '\n';
+    WriteAll(file_descriptor_, buffer_, file_path_);
+    buffer_.clear();
+
+    return;
+  }
+
+private:
+  void PushNode(AstIndex node, bool starts_line = false) {
+    stack_.push_back(SExpressionItem{.action = SExpressionItem::Action::kNode,
+                                     .starts_line = starts_line,
+                                     .node = node});
+
+    return;
+  }
+
+  void PushList(AstRange range, bool starts_line = false,
+                bool elements_start_lines = false) {
+    stack_.push_back(
+        SExpressionItem{.action = SExpressionItem::Action::kList,
+                        .starts_line = starts_line,
+                        .elements_start_lines = elements_start_lines,
+                        .range = range});
+
+    return;
+  }
+
+  // A single node is written on its own, and several of them as a list.
+  void PushNodeOrList(AstRange range) {
+    if (range.count == 1) {
+      PushNode(ast_.GetChildren(range).front());
+    } else {
+      PushList(range);
+    }
+
+    return;
+  }
+
+  void PushElements(AstRange range, bool start_lines) {
+    std::span<const AstIndex> children = ast_.GetChildren(range);
+    for (auto child = children.rbegin(); child != children.rend(); child++) {
+      PushNode(*child, start_lines);
+    }
+
+    return;
+  }
+
+  void PushClose() {
+    stack_.push_back(
+        SExpressionItem{.action = SExpressionItem::Action::kClose});
+
+    return;
+  }
+
+  // The first element of a list stays on the line of its '(' even when it
+  // starts a line, as in '((use io)'.
+  void AppendSeparator(bool starts_line) {
+    if (!is_at_list_start_ && is_pretty_printed_ && starts_line) {
+      buffer_ += '\n';
+      buffer_.append(2 * depth_, ' ');
+    } else if (!is_at_list_start_) {
+      buffer_ += ' ';
+    }
+    is_at_list_start_ = false;
+
+    return;
+  }
+
+  // Opens a list whose first element is the atom 'head', if any.
+  void OpenList(std::string_view head, bool starts_line) {
+    AppendSeparator(starts_line);
+    buffer_ += '(';
+    buffer_ += head;
+    depth_++;
+    is_at_list_start_ = head.empty();
+
+    return;
+  }
+
+  // Appends 'value' between 'quote' characters, escaping them within it.
+  void AppendQuoted(std::string_view value, char quote) {
+    buffer_ += quote;
+    for (std::size_t quote_position = value.find(quote);
+         quote_position != std::string_view::npos;
+         quote_position = value.find(quote)) {
+      AppendEscapedLiteral(buffer_, value.substr(0, quote_position));
+      buffer_ += '\\';
+      buffer_ += quote;
+      value.remove_prefix(quote_position + 1);
+    }
+    AppendEscapedLiteral(buffer_, value);
+    buffer_ += quote;
+
+    return;
+  }
+
+  void AppendLiteral(const AstNode &node) {
+    switch (node.kind) {
+    case AstNodeKind::kIdentifier:
+      buffer_ += string_interner_.GetString(node.symbol);
+      break;
+    case AstNodeKind::kInteger: {
+      char digits[std::numeric_limits<std::uint64_t>::digits10 + 1];
+      char *digits_end =
+          std::to_chars(std::begin(digits), std::end(digits),
+                        node.integer_value)
+              .ptr;
+      buffer_.append(digits, digits_end);
+      break;
+    }
+    case AstNodeKind::kCharacter:
+      AppendQuoted(std::string_view{&node.character_value, 1}, '\'');
+      break;
+    case AstNodeKind::kString:
+      AppendQuoted(string_interner_.GetString(node.symbol), '"');
+      break;
+    case AstNodeKind::kBoolean:
+      buffer_ += node.boolean_value ? "true" : "false";
+      break;
+    default:
+      break;
+    }
+
+    return;
+  }
+
+  void WriteNode(AstIndex index, bool starts_line) {
+    const AstNode &node = ast_.GetNode(index);
+
+    switch (node.kind) {
+    case AstNodeKind::kProgram: {
+      // '((use*) (definition*))'. Every 'use' precedes the definitions.
+      std::span<const AstIndex> children = ast_.GetChildren(node.range);
+      std::uint32_t use_count = 0;
+      while (use_count < children.size() &&
+             ast_.GetNode(children[use_count]).kind == AstNodeKind::kUse) {
+        use_count++;
+      }
+      OpenList({}, starts_line);
+      PushClose();
+      PushList({node.range.begin + use_count, node.range.count - use_count},
+               true, true);
+      PushList({node.range.begin, use_count});
+      break;
+    }
+    case AstNodeKind::kUse:
+      OpenList("use", starts_line);
+      AppendSeparator(false);
+      buffer_ += string_interner_.GetString(node.symbol);
+      buffer_ += ')';
+      depth_--;
+      break;
+    case AstNodeKind::kFunction: {
+      const AstFunction &function = ast_.GetFunction(node);
+      OpenList(string_interner_.GetString(function.name), starts_line);
+      PushClose();
+      PushNode(function.body, true);
+      PushList(function.return_types);
+      PushList(function.parameters);
+      break;
+    }
+    case AstNodeKind::kGlobalDeclaration: {
+      const AstNode &declaration = ast_.GetNode(node.pair.first);
+      OpenList(":global", starts_line);
+      PushClose();
+      if (node.pair.second != kNoAstIndex) {
+        const AstNode &value = ast_.GetNode(node.pair.second);
+        // Global values are literals, so '-3' is written as one.
+        if (value.kind == AstNodeKind::kUnary) {
+          stack_.push_back(SExpressionItem{
+              .action = SExpressionItem::Action::kNegatedLiteral,
+              .node = value.pair.first});
+        } else {
+          PushNode(node.pair.second);
+        }
+      }
+      PushNode(declaration.pair.second);
+      PushNode(declaration.pair.first);
+      break;
+    }
+    case AstNodeKind::kDeclaration:
+      OpenList({}, starts_line);
+      PushClose();
+      PushNode(node.pair.second);
+      PushNode(node.pair.first);
+      break;
+    case AstNodeKind::kIntType:
+      AppendSeparator(starts_line);
+      buffer_ += "int";
+      break;
+    case AstNodeKind::kBoolType:
+      AppendSeparator(starts_line);
+      buffer_ += "bool";
+      break;
+    case AstNodeKind::kArrayType:
+      OpenList("[]", starts_line);
+      PushClose();
+      if (node.pair.second != kNoAstIndex) {
+        PushNode(node.pair.second);
+      }
+      PushNode(node.pair.first);
+      break;
+    case AstNodeKind::kBlock:
+      OpenList({}, starts_line);
+      PushClose();
+      PushElements(node.range, true);
+      break;
+    case AstNodeKind::kIf: {
+      const AstIf &if_statement = ast_.GetIf(node);
+      OpenList("if", starts_line);
+      PushClose();
+      if (if_statement.else_branch != kNoAstIndex) {
+        PushNode(if_statement.else_branch, true);
+      }
+      PushNode(if_statement.then_branch, true);
+      PushNode(if_statement.condition);
+      break;
+    }
+    case AstNodeKind::kWhile:
+      OpenList("while", starts_line);
+      PushClose();
+      PushNode(node.pair.second, true);
+      PushNode(node.pair.first);
+      break;
+    case AstNodeKind::kReturn:
+      OpenList("return", starts_line);
+      PushClose();
+      PushElements(node.range, false);
+      break;
+    case AstNodeKind::kAssignment: {
+      const AstAssignment &assignment = ast_.GetAssignment(node);
+      // Declarations of several variables without values are written as
+      // one statement per variable.
+      if (assignment.values.count == 0) {
+        PushElements(assignment.targets, starts_line);
+        break;
+      }
+      OpenList("=", starts_line);
+      PushClose();
+      PushNodeOrList(assignment.values);
+      PushNodeOrList(assignment.targets);
+      break;
+    }
+    case AstNodeKind::kDiscard:
+      AppendSeparator(starts_line);
+      buffer_ += '_';
+      break;
+    case AstNodeKind::kIdentifier:
+    case AstNodeKind::kInteger:
+    case AstNodeKind::kCharacter:
+    case AstNodeKind::kString:
+    case AstNodeKind::kBoolean:
+      AppendSeparator(starts_line);
+      AppendLiteral(node);
+      break;
+    case AstNodeKind::kArrayLiteral:
+    case AstNodeKind::kCall:
+      // A call is the list of the function followed by its arguments.
+      OpenList({}, starts_line);
+      PushClose();
+      PushElements(node.range, false);
+      break;
+    case AstNodeKind::kUnary:
+      OpenList(GetOperatorLexeme(node.operator_type), starts_line);
+      PushClose();
+      PushNode(node.pair.first);
+      break;
+    case AstNodeKind::kBinary:
+      OpenList(GetOperatorLexeme(node.operator_type), starts_line);
+      PushClose();
+      PushNode(node.pair.second);
+      PushNode(node.pair.first);
+      break;
+    case AstNodeKind::kIndex:
+      OpenList("[]", starts_line);
+      PushClose();
+      PushNode(node.pair.second);
+      PushNode(node.pair.first);
+      break;
+    case AstNodeKind::kLength:
+      OpenList("length", starts_line);
+      PushClose();
+      PushNode(node.pair.first);
+      break;
+    case AstNodeKind::kError:
+      AppendSeparator(starts_line);
+      buffer_ += "error";
+      break;
+    }
+
+    return;
+  }
+
+  const Ast &ast_;
+  const bool is_pretty_printed_;
+  std::string &buffer_;
+  std::vector<SExpressionItem> &stack_;
+  const int file_descriptor_;
+  const std::string &file_path_;
+  StringInterner &string_interner_ = GetStringInterner();
+  // Number of lists that are open, which is the indentation level.
+  std::size_t depth_ = 0;
+  // Whether nothing was written since the innermost list was opened, so the
+  // next element needs no separator.
+  bool is_at_list_start_ = true;
+};
+
+} // namespace
 
 FileWriter::FileWriter(const std::vector<std::string> &eta_programs_filepaths,
                        const std::string output_directory)
@@ -19,23 +493,148 @@ const std::string &FileWriter::GetOutputDirectory() const {
 }
 
 void FileWriter::WriteLexerOutput(const std::string &current_eta_filepath_str,
-                                  std::vector<Token> tokens) const {
-  std::filesystem::path current_eta_file_path{current_eta_filepath_str};
-  std::filesystem::path output_directory_path{output_directory_};
+                                  const std::vector<Token> &tokens,
+                                  std::string_view source_code) const {
+  TraceScope trace_scope{"FileWriter::WriteLexerOutput",
+                         current_eta_filepath_str};
+  trace_scope.SetByteCount(source_code.size());
+  trace_scope.SetTokenCount(tokens.size());
+  std::string output_file_path =
+      GetOutputFilePath(current_eta_filepath_str, ".lexed");
+  int file_descriptor = CreateOutputFile(output_file_path);
+
+  // Lines are formatted into a buffer that is handed to the kernel in large
+  // blocks, instead of going through a stream flushed after every token. Every
+  // thread keeps the buffer from one file to the next, so it is only allocated
+  // by the first file that it writes.
+  thread_local std::string buffer;
+  buffer.clear();
+  buffer.reserve(kOutputBufferSize + kOutputLineReserve);
+  LineTable line_table{source_code};
+  // Tokens are sorted by offset, so their line is found by moving forward
+  // from the line of the previous token instead of searching the whole table.
+  std::size_t line = 1;
 
-  if (std::filesystem::exists(output_directory_path) &&
-      std::filesystem::is_directory(output_directory_path)) {
-    std::ofstream output_file_stream{
-        std::format("{}/{}.lexed", output_directory_,
-                    current_eta_file_path.filename().string())};
+  try {
     for (const Token &token : tokens) {
-      output_file_stream << token << std::endl;
+      while (line < line_table.GetLineCount() &&
+             line_table.GetLineStart(line + 1) <= token.offset_) {
+        line++;
+      }
+      LineColumn position{
+          .line = static_cast<std::uint32_t>(line),
+          .column = static_cast<std::uint32_t>(
+              token.offset_ - line_table.GetLineStart(line) + 1)};
+      AppendTokenString(buffer, token, source_code, position);
+      buffer += '\n';
+
+      if (buffer.size() >= kOutputBufferSize) {
+        WriteAll(file_descriptor, buffer, output_file_path);
+        buffer.clear();
+      }
     }
-  } else {
+    WriteAll(file_descriptor, buffer, output_file_path);
+  } catch (...) {
+    close(file_descriptor);
+    throw;
+  }
+
+  close(file_descriptor);
+
+  return;
+}
+
+void FileWriter::WriteLexedbOutput(const std::string &current_eta_filepath_str,
+                                   const std::vector<Token> &tokens,
+                                   std::string_view source_code) const {
+  TraceScope trace_scope{"FileWriter::WriteLexedbOutput",
+                         current_eta_filepath_str};
+  trace_scope.SetByteCount(source_code.size());
+  trace_scope.SetTokenCount(tokens.size());
+  std::string output_file_path =
+      GetOutputFilePath(current_eta_filepath_str, ".lexedb");
+  std::string lexedb = SerializeLexedb(tokens, source_code);
+  int file_descriptor = CreateOutputFile(output_file_path);
+
+  try {
+    WriteAll(file_descriptor, lexedb, output_file_path);
+  } catch (...) {
+    close(file_descriptor);
+    throw;
+  }
+
+  close(file_descriptor);
+
+  return;
+}
+
+void FileWriter::WriteParserOutput(const std::string &current_eta_filepath_str,
+                                   const Ast &ast,
+                                   bool is_pretty_printed) const {
+  TraceScope trace_scope{"FileWriter::WriteParserOutput",
+                         current_eta_filepath_str};
+  std::string output_file_path =
+      GetOutputFilePath(current_eta_filepath_str, ".parsed");
+  int file_descriptor = CreateOutputFile(output_file_path);
+
+  // Every thread keeps its buffer and stack from one file to the next, so
+  // they are only allocated by the first files that it writes.
+  thread_local std::string buffer;
+  thread_local std::vector<SExpressionItem> stack;
+  buffer.clear();
+  buffer.reserve(kOutputBufferSize + kOutputLineReserve);
+  stack.clear();
+
+  try {
+    SExpressionWriter{ast, is_pretty_printed, buffer,
+                      stack, file_descriptor, output_file_path}
+        .Write(ast.GetRoot());
+  } catch (...) {
+    close(file_descriptor);
+    throw;
+  }
+
+  close(file_descriptor);
+
+  return;
+}
+
+void FileWriter::WriteParserError(const std::string &current_eta_filepath_str,
+                                  const CompilerError &compiler_error) const {
+  std::string output_file_path =
+      GetOutputFilePath(current_eta_filepath_str, ".parsed");
+  std::string message;
+  compiler_error.message.FormatTo(message);
+  std::string output = std::format(
+      "{}:{} error:{}\n", compiler_error.location.line,
+      compiler_error.location.column, StripSeverityTag(message));
+  int file_descriptor = CreateOutputFile(output_file_path);
+
+  try {
+    WriteAll(file_descriptor, output, output_file_path);
+  } catch (...) {
+    close(file_descriptor);
+    throw;
+  }
+
+  close(file_descriptor);
+
+  return;
+}
+
+std::string
+FileWriter::GetOutputFilePath(const std::string &current_eta_filepath_str,
+                              std::string_view extension) const {
+  std::filesystem::path current_eta_file_path{current_eta_filepath_str};
+  std::filesystem::path output_directory_path{output_directory_};
+
+  if (!std::filesystem::exists(output_directory_path) ||
+      !std::filesystem::is_directory(output_directory_path)) {
     throw std::runtime_error{std::format(
-        "The path '' does not exists or does not represent a directory.",
+        "The path '{}' does not exists or does not represent a directory.",
         output_directory_)};
   }
 
-  return;
+  return std::format("{}/{}{}", output_directory_,
+                     current_eta_file_path.filename().string(), extension);
 }
@@ -0,0 +1,40 @@
+#include "senbonzakura/json.hpp"
+
+#include <format>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+void AppendJsonString(std::string &output, std::string_view string) {
+  output += '"';
+  for (char character : string) {
+    switch (character) {
+    case ('"'):
+      output += "\\\"";
+      break;
+    case ('\\'):
+      output += "\\\\";
+      break;
+    case ('\n'):
+      output += "\\n";
+      break;
+    case ('\r'):
+      output += "\\r";
+      break;
+    case ('\t'):
+      output += "\\t";
+      break;
+    default:
+      if (static_cast<unsigned char>(character) < 0x20) {
+        std::format_to(std::back_inserter(output), "\\u{:04x}",
+                       static_cast<unsigned char>(character));
+      } else {
+        output += character;
+      }
+      break;
+    }
+  }
+  output += '"';
+
+  return;
+}
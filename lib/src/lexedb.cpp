@@ -0,0 +1,359 @@
+#include "senbonzakura/lexedb.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "senbonzakura/diagnostic_reporter.hpp"
+#include "senbonzakura/line_table.hpp"
+#include "senbonzakura/string_interner.hpp"
+#include "senbonzakura/token.hpp"
+#include "senbonzakura/token_type.hpp"
+
+namespace {
+
+constexpr std::size_t kSectionAlignment = 8;
+
+std::size_t AlignSection(std::size_t size) {
+  return (size + kSectionAlignment - 1) & ~(kSectionAlignment - 1);
+}
+
+// Offsets of the sections described by 'header', and the size of the file.
+struct LexedbLayout {
+  std::size_t token_records;
+  std::size_t line_starts;
+  std::size_t string_records;
+  std::size_t string_pool;
+  std::size_t file_size;
+};
+
+LexedbLayout GetLexedbLayout(const LexedbHeader &header) {
+  LexedbLayout layout;
+  layout.token_records = AlignSection(sizeof(LexedbHeader));
+  layout.line_starts = AlignSection(
+      layout.token_records +
+      std::size_t{header.token_count} * sizeof(LexedbTokenRecord));
+  layout.string_records = AlignSection(
+      layout.line_starts +
+      std::size_t{header.line_count} * sizeof(std::uint32_t));
+  layout.string_pool = AlignSection(
+      layout.string_records +
+      std::size_t{header.string_count} * sizeof(LexedbStringRecord));
+  layout.file_size = layout.string_pool + header.string_pool_size;
+
+  return layout;
+}
+
+template <typename T>
+void WriteAt(std::string &output, std::size_t offset, const T &value) {
+  std::memcpy(output.data() + offset, &value, sizeof(T));
+
+  return;
+}
+
+template <typename T>
+T ReadAt(const char *data, std::size_t index) {
+  T value;
+  std::memcpy(&value, data + index * sizeof(T), sizeof(T));
+
+  return value;
+}
+
+} // namespace
+
+std::string SerializeLexedb(const std::vector<Token> &tokens,
+                            std::string_view source_code) {
+  LineTable line_table{source_code};
+
+  // Every distinct symbol is stored once in the pool, in order of appearance.
+  std::unordered_map<std::uint32_t, std::uint32_t> string_indexes;
+  std::vector<LexedbStringRecord> string_records;
+  std::string string_pool;
+  std::vector<LexedbTokenRecord> token_records;
+  token_records.reserve(tokens.size() + 1);
+
+  for (const Token &token : tokens) {
+    LexedbTokenRecord record{
+        .offset = token.offset_,
+        .length = token.length_,
+        .token_type = static_cast<std::uint8_t>(token.token_type_),
+        .padding = {},
+        .value = 0,
+    };
+
+    switch (token.token_type_) {
+    case (TokenType::kInteger):
+      record.value = token.value_.integer_value;
+      break;
+    case (TokenType::kTrue):
+    case (TokenType::kFalse):
+      record.value = token.value_.boolean_value ? 1 : 0;
+      break;
+    case (TokenType::kCharacter):
+      record.value = static_cast<unsigned char>(token.value_.character_value);
+      break;
+    case (TokenType::kIdentifier):
+    case (TokenType::kString): {
+      auto [it, inserted] = string_indexes.try_emplace(
+          token.value_.symbol_value.id,
+          static_cast<std::uint32_t>(string_records.size()));
+      if (inserted) {
+        std::string_view string = token.GetStringValue();
+        string_records.push_back(LexedbStringRecord{
+            .offset = static_cast<std::uint32_t>(string_pool.size()),
+            .length = static_cast<std::uint32_t>(string.size()),
+        });
+        string_pool += string;
+      }
+      record.value = it->second;
+      break;
+    }
+    default:
+      break;
+    }
+
+    token_records.push_back(record);
+  }
+  // A lexical error cuts the tokens short before their 'kFileEnd' token. The
+  // stream is closed right after its last token, as 'SpanTokenStream' does,
+  // so that every file ends with a 'kFileEnd' record.
+  if (tokens.empty() || tokens.back().token_type_ != TokenType::kFileEnd) {
+    std::uint32_t end_offset =
+        tokens.empty() ? 0 : tokens.back().offset_ + tokens.back().length_;
+    token_records.push_back(LexedbTokenRecord{
+        .offset = end_offset,
+        .length = 0,
+        .token_type = static_cast<std::uint8_t>(TokenType::kFileEnd),
+        .padding = {},
+        .value = 0,
+    });
+  }
+
+  LexedbHeader header{
+      .magic = kLexedbMagic,
+      .version = kLexedbVersion,
+      .byte_order_mark = kLexedbByteOrderMark,
+      .source_size = static_cast<std::uint32_t>(source_code.size()),
+      .token_count = static_cast<std::uint32_t>(token_records.size()),
+      .line_count = static_cast<std::uint32_t>(line_table.GetLineCount()),
+      .string_count = static_cast<std::uint32_t>(string_records.size()),
+      .string_pool_size = static_cast<std::uint32_t>(string_pool.size()),
+      .reserved = 0,
+  };
+  LexedbLayout layout = GetLexedbLayout(header);
+
+  std::string output(layout.file_size, '\0');
+  WriteAt(output, 0, header);
+  std::memcpy(output.data() + layout.token_records, token_records.data(),
+              token_records.size() * sizeof(LexedbTokenRecord));
+  for (std::size_t line = 1; line <= line_table.GetLineCount(); line++) {
+    WriteAt(output, layout.line_starts + (line - 1) * sizeof(std::uint32_t),
+            static_cast<std::uint32_t>(line_table.GetLineStart(line)));
+  }
+  std::memcpy(output.data() + layout.string_records, string_records.data(),
+              string_records.size() * sizeof(LexedbStringRecord));
+  std::memcpy(output.data() + layout.string_pool, string_pool.data(),
+              string_pool.size());
+
+  return output;
+}
+
+bool LexedbReader::Load(const std::string &file_path,
+                        DiagnosticReporter &diagnostic_reporter) {
+  if (!source_buffer_.Load(file_path)) {
+    diagnostic_reporter.ReportSystemError(
+        Severity::kFatal,
+        std::format("[E]: Could not open the provided file '{}'.", file_path));
+    return false;
+  }
+
+  auto report_invalid_file = [&](std::string_view reason) {
+    diagnostic_reporter.ReportSystemError(
+        Severity::kFatal,
+        std::format("[E]: The file '{}' is not a valid '.lexedb' file: {}.",
+                    file_path, reason));
+    return false;
+  };
+
+  if (source_buffer_.Size() < sizeof(LexedbHeader)) {
+    return report_invalid_file("it is too small to hold a header");
+  }
+  std::memcpy(&header_, source_buffer_.Data(), sizeof(LexedbHeader));
+  if (header_.magic != kLexedbMagic) {
+    return report_invalid_file("its header does not start with 'ETALEXDB'");
+  }
+  if (header_.byte_order_mark != kLexedbByteOrderMark) {
+    return report_invalid_file(
+        "it was written on a machine with a different byte order");
+  }
+  if (header_.version != kLexedbVersion) {
+    return report_invalid_file(std::format(
+        "its version is {}, but only version {} is supported", header_.version,
+        kLexedbVersion));
+  }
+
+  LexedbLayout layout = GetLexedbLayout(header_);
+  if (source_buffer_.Size() != layout.file_size) {
+    return report_invalid_file(
+        std::format("its header describes {} bytes, but it has {}",
+                    layout.file_size, source_buffer_.Size()));
+  }
+
+  const char *data = source_buffer_.Data();
+  token_records_ = data + layout.token_records;
+  line_starts_ = data + layout.line_starts;
+  string_records_ = data + layout.string_records;
+  string_pool_ = data + layout.string_pool;
+
+  // String records are the only ones pointing into another section, so they
+  // are the only ones that need to be checked before being used.
+  for (std::size_t index = 0; index < header_.string_count; index++) {
+    auto string_record = ReadAt<LexedbStringRecord>(string_records_, index);
+    if (std::size_t{string_record.offset} + string_record.length >
+        header_.string_pool_size) {
+      return report_invalid_file(
+          std::format("its string {} ends past the string pool", index));
+    }
+  }
+  if (header_.line_count == 0 || GetLineStart(0) != 0) {
+    return report_invalid_file("its line table does not start at offset 0");
+  }
+  // Tokens are checked once here, so that 'GetToken' can hand them out
+  // without any check: a damaged file must never produce a token whose lexeme
+  // lies outside of the source, or whose type has no name.
+  for (std::size_t index = 0; index < header_.token_count; index++) {
+    LexedbTokenRecord record = GetTokenRecord(index);
+    if (std::size_t{record.offset} + record.length > header_.source_size) {
+      return report_invalid_file(
+          std::format("its token {} ends past the source code", index));
+    }
+    if (record.token_type > static_cast<std::uint8_t>(TokenType::kFileEnd)) {
+      return report_invalid_file(std::format(
+          "its token {} has the unknown type {}", index, record.token_type));
+    }
+    auto token_type = static_cast<TokenType>(record.token_type);
+    if ((token_type == TokenType::kIdentifier ||
+         token_type == TokenType::kString) &&
+        record.value >= header_.string_count) {
+      return report_invalid_file(
+          std::format("its token {} refers to a missing string", index));
+    }
+  }
+  if (header_.token_count == 0 ||
+      GetTokenRecord(header_.token_count - 1).token_type !=
+          static_cast<std::uint8_t>(TokenType::kFileEnd)) {
+    return report_invalid_file("its tokens do not end with 'kFileEnd'");
+  }
+
+  symbols_.assign(header_.string_count, Symbol{});
+
+  return true;
+}
+
+std::size_t LexedbReader::GetSourceSize() const { return header_.source_size; }
+
+std::size_t LexedbReader::GetTokenCount() const { return header_.token_count; }
+
+Token LexedbReader::GetToken(std::size_t index) {
+  LexedbTokenRecord record = GetTokenRecord(index);
+  auto token_type = static_cast<TokenType>(record.token_type);
+  TokenValue value{};
+
+  switch (token_type) {
+  case (TokenType::kInteger):
+    value.integer_value = record.value;
+    break;
+  case (TokenType::kTrue):
+  case (TokenType::kFalse):
+    value.boolean_value = record.value != 0;
+    break;
+  case (TokenType::kCharacter):
+    value.character_value = static_cast<char>(record.value);
+    break;
+  case (TokenType::kIdentifier):
+  case (TokenType::kString):
+    if (record.value < symbols_.size()) {
+      Symbol &symbol = symbols_[record.value];
+      if (!symbol.IsValid()) {
+        symbol = GetStringInterner().Intern(GetString(record.value));
+      }
+      value.symbol_value = symbol;
+    }
+    break;
+  default:
+    break;
+  }
+
+  return Token{token_type, record.offset,
+               std::min(record.length, Token::kMaxLength), value};
+}
+
+std::size_t LexedbReader::GetLineCount() const { return header_.line_count; }
+
+LineColumn LexedbReader::Resolve(std::size_t offset) const {
+  // The line of 'offset' is the last one starting at or before it.
+  std::size_t low = 0;
+  std::size_t high = header_.line_count;
+  while (high - low > 1) {
+    std::size_t middle = low + (high - low) / 2;
+    if (GetLineStart(middle) <= offset) {
+      low = middle;
+    } else {
+      high = middle;
+    }
+  }
+
+  return LineColumn{
+      .line = static_cast<std::uint32_t>(low + 1),
+      .column = static_cast<std::uint32_t>(offset - GetLineStart(low) + 1),
+  };
+}
+
+std::size_t LexedbReader::GetStringCount() const {
+  return header_.string_count;
+}
+
+std::string_view LexedbReader::GetString(std::size_t index) const {
+  auto string_record = ReadAt<LexedbStringRecord>(string_records_, index);
+
+  return std::string_view{string_pool_ + string_record.offset,
+                          string_record.length};
+}
+
+LexedbTokenRecord LexedbReader::GetTokenRecord(std::size_t index) const {
+  return ReadAt<LexedbTokenRecord>(token_records_, index);
+}
+
+std::uint32_t LexedbReader::GetLineStart(std::size_t index) const {
+  return ReadAt<std::uint32_t>(line_starts_, index);
+}
+
+LexedbTokenStream::LexedbTokenStream(LexedbReader &lexedb_reader)
+    : lexedb_reader_{lexedb_reader} {}
+
+Token LexedbTokenStream::NextToken() {
+  std::size_t token_count = lexedb_reader_.GetTokenCount();
+  if (token_count == 0) {
+    return Token{TokenType::kFileEnd,
+                 static_cast<std::uint32_t>(lexedb_reader_.GetSourceSize()), 0};
+  }
+  if (next_ < token_count) {
+    return lexedb_reader_.GetToken(next_++);
+  }
+
+  // 'LexedbReader::Load' only accepts files ending with a 'kFileEnd' record,
+  // but the stream must still end if it is ever handed one that does not.
+  Token last_token = lexedb_reader_.GetToken(token_count - 1);
+  if (last_token.token_type_ == TokenType::kFileEnd) {
+    return last_token;
+  }
+
+  return Token{TokenType::kFileEnd,
+               static_cast<std::uint32_t>(lexedb_reader_.GetSourceSize()), 0};
+}
@@ -1,27 +1,41 @@
 #include "senbonzakura/lexer.hpp"
 
-#include <any>
-#include <format>
+#include <cstdint>
 #include <string>
+#include <string_view>
 
 #include "senbonzakura/diagnostic_reporter.hpp"
+#include "senbonzakura/keywords.hpp"
+#include "senbonzakura/lexer_tables.hpp"
+#include "senbonzakura/literal_decoder.hpp"
+#include "senbonzakura/string_interner.hpp"
 #include "senbonzakura/token.hpp"
 #include "senbonzakura/token_type.hpp"
+#include "senbonzakura/trace.hpp"
 
-Lexer::Lexer(const std::string &file_path, const std::string &source_code,
+Lexer::Lexer(const std::string &file_path, std::string_view source_code,
              DiagnosticReporter &diagnostic_reporter)
-    : file_path_(file_path), source_code_(source_code),
-      diagnostic_reporter_(diagnostic_reporter) {}
+    : Lexer(file_path, source_code, 0, source_code.length(),
+            diagnostic_reporter) {}
 
-void Lexer::AddToken(TokenType token_type) {
-  AddToken(token_type, {});
-
-  return;
-}
+Lexer::Lexer(const std::string &file_path, std::string_view source_code,
+             std::size_t begin, std::size_t end,
+             DiagnosticReporter &diagnostic_reporter)
+    : current_(begin), start_(begin), end_(end), file_path_(file_path),
+      source_code_(source_code), diagnostic_reporter_(diagnostic_reporter) {}
 
-void Lexer::AddToken(TokenType token_type, std::any value) {
-  std::string lexeme{source_code_.substr(start_, current_ - start_)};
-  tokens_.emplace_back(Token(line_, column_, token_type, value, lexeme));
+void Lexer::AddToken(TokenType token_type, TokenValue value) {
+  if (current_ - start_ > Token::kMaxLength) {
+    diagnostic_reporter_.ReportCompilerError(
+        GetSourceCodeLocation(start_, current_), Severity::kFatal,
+        DiagnosticMessage{
+            .format = "[E]: A token longer than {} bytes was found within the "
+                      "source file.",
+            .argument = std::to_string(Token::kMaxLength)});
+    return;
+  }
+  pending_token_ = Token(token_type, start_, current_ - start_, value);
+  has_pending_token_ = true;
 
   return;
 }
@@ -32,335 +46,337 @@ char Lexer::Advance() {
   return source_code_[current_ - 1];
 }
 
+SourceCodeLocation Lexer::GetSourceCodeLocation(std::size_t begin,
+                                                std::size_t end) {
+  if (!line_table_) {
+    line_table_.emplace(source_code_);
+    file_symbol_ = string_interner_.Intern(file_path_);
+  }
+  LineColumn position = line_table_->Resolve(begin);
+
+  // Sources never exceed 'Token::kMaxSourceSize', so the offsets fit.
+  return SourceCodeLocation{
+      .file = file_symbol_,
+      .line = position.line,
+      .column = position.column,
+      .offset = static_cast<std::uint32_t>(begin),
+      .length = static_cast<std::uint32_t>(end - begin),
+  };
+}
+
 void Lexer::Character() {
   if (IsAtEnd()) {
     diagnostic_reporter_.ReportCompilerError(
-        SourceCodeLocation{
-            .source_name = file_path_,
-            .line = line_,
-            .column = column_,
-        },
-        Severity::kFatal,
-        std::format(
-            "[E]: An unterminated character literal was found within the "
-            "source file."));
+        GetSourceCodeLocation(start_, current_), Severity::kFatal,
+        DiagnosticMessage{
+            .format = "[E]: An unterminated character literal was found "
+                      "within the source file.",
+            .argument = {}});
     return;
   }
 
   if (Peek(0) == '\'') {
     diagnostic_reporter_.ReportCompilerError(
-        SourceCodeLocation{
-            .source_name = file_path_,
-            .line = line_,
-            .column = column_,
-        },
-        Severity::kFatal,
-        std::format("[E]: An empty character literal ('') was found within the "
-                    "source file. This is not a valid ASCII character."));
+        GetSourceCodeLocation(start_, current_), Severity::kFatal,
+        DiagnosticMessage{
+            .format = "[E]: An empty character literal ('') was found within "
+                      "the source file. This is not a valid ASCII "
+                      "character.",
+            .argument = {}});
     return;
   }
 
   char current_char = Advance();
+  if (current_char == '\\' && !EscapeSequence(current_char)) {
+    return;
+  }
 
   // Verifies if the character literal has been correctly terminated.
   if (IsAtEnd() || Peek(0) != '\'') {
     diagnostic_reporter_.ReportCompilerError(
-        std::move(SourceCodeLocation{
-            .source_name = file_path_, .line = line_, .column = column_}),
-        Severity::kFatal,
-        std::format("[E]: A character literal that does not follow the Eta "
-                    "Specification Document was found within the "
-                    "source file."));
+        GetSourceCodeLocation(start_, current_), Severity::kFatal,
+        DiagnosticMessage{
+            .format = "[E]: A character literal that does not follow the Eta "
+                      "Specification Document was found within the source "
+                      "file.",
+            .argument = {}});
     return;
   }
 
   // Consumes the enclosing single-quote character: '\''.
   Advance();
-  AddToken(TokenType::kCharacter, current_char);
-  column_delta_ = current_ - start_;
+  AddToken(TokenType::kCharacter, TokenValue{.character_value = current_char});
 
   return;
 }
 
-void Lexer::Comment() {
-  while (!IsAtEnd() && Peek(0) != '\n') {
-    column_delta_++;
-    Advance();
+bool Lexer::EscapeSequence(char &value) {
+  // The leading '\' has already been consumed.
+  std::size_t escape_start = current_ - 1;
+  DecodedEscape escape =
+      DecodeEscapeSequence(source_code_.substr(escape_start));
+  if (escape.status == EscapeStatus::kValid) {
+    current_ = escape_start + escape.length;
+    value = escape.value;
+    return true;
+  }
+
+  DiagnosticMessage message{
+      .argument = std::string{source_code_.substr(escape_start, escape.length)},
+  };
+  if (escape.status == EscapeStatus::kOutOfRange) {
+    message.format = "[E]: The escape sequence '{}' denotes a character "
+                     "outside of the ASCII range.";
+  } else if (escape.status == EscapeStatus::kMalformed) {
+    message.format = "[E]: A malformed escape sequence was found within the "
+                     "source file. Hexadecimal escapes must have the form "
+                     "'\\x{{HHHHHH}}', with 1 to 6 digits.";
+  } else {
+    message.format = "[E]: An unknown escape sequence ('{}') was found within "
+                     "the source file.";
   }
+  diagnostic_reporter_.ReportCompilerError(
+      GetSourceCodeLocation(escape_start, escape_start + escape.length),
+      Severity::kFatal, std::move(message));
+
+  return false;
+}
+
+void Lexer::Comment() {
+  current_ = simd_scanner_.find_newline(source_code_.data(), current_, end_);
 
   return;
 }
 
 void Lexer::Identifier() {
-  while (IsAlphaNumeric(Peek(0))) {
-    Advance();
-  }
+  current_ =
+      simd_scanner_.skip_identifier_part(source_code_.data(), current_, end_);
 
-  std::string lexeme{source_code_.substr(start_, current_ - start_)};
-  TokenType token_type = TokenType::kIdentifier;
-
-  if (keywords_to_tokentypes_.contains(lexeme)) {
-    token_type = keywords_to_tokentypes_[lexeme];
-  }
+  std::string_view lexeme{source_code_.data() + start_, current_ - start_};
+  TokenType token_type = LookupKeyword(lexeme);
 
   if (token_type == TokenType::kFalse) {
-    AddToken(token_type, false);
+    AddToken(token_type, TokenValue{.boolean_value = false});
   } else if (token_type == TokenType::kTrue) {
-    AddToken(token_type, true);
+    AddToken(token_type, TokenValue{.boolean_value = true});
+  } else if (token_type == TokenType::kIdentifier) {
+    Symbol symbol = string_interner_.Intern(lexeme);
+    AddToken(token_type, TokenValue{.symbol_value = symbol});
   } else {
     AddToken(token_type);
   }
 
-  column_delta_ = current_ - start_;
-
   return;
 }
 
 void Lexer::Integer() {
-  while (IsDigit(Peek(0))) {
-    Advance();
-  }
+  current_ = simd_scanner_.skip_digits(source_code_.data(), current_, end_);
 
-  std::string int_as_str{source_code_.substr(start_, current_ - start_)};
-  std::any value = std::stoi(int_as_str);
-
-  AddToken(TokenType::kInteger, value);
+  std::string_view digits = source_code_.substr(start_, current_ - start_);
+  std::uint64_t magnitude = 0;
+  if (!DecodeIntegerLiteral(digits, magnitude)) {
+    diagnostic_reporter_.ReportCompilerError(
+        GetSourceCodeLocation(start_, current_), Severity::kFatal,
+        DiagnosticMessage{
+            .format = "[E]: The integer literal '{}' is too large. Eta "
+                      "integers are 64-bit values, from -9223372036854775808 "
+                      "to 9223372036854775807.",
+            .argument = std::string{digits}});
+    return;
+  }
 
-  column_delta_ = current_ - start_;
+  AddToken(TokenType::kInteger, TokenValue{.integer_value = magnitude});
 
   return;
 }
 
-bool Lexer::IsAlpha(char c) {
-  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
-}
-
-bool Lexer::IsAlphaNumeric(char c) {
-  return (IsAlpha(c) || IsDigit(c) || c == '_' || c == '\'');
-}
-
-bool Lexer::IsAtEnd() { return current_ >= source_code_.length(); }
-
-bool Lexer::IsDigit(char c) { return (c >= '0' && c <= '9'); }
-
-bool Lexer::IsHexDigit(char c) {
-  return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') ||
-         (c >= 'A' && c <= 'F');
-}
+bool Lexer::IsAtEnd() { return current_ >= end_; }
 
 void Lexer::LexToken() {
-  char current_char = Advance();
-  column_delta_ = 1;
+  char current_char = Peek(0);
 
-  switch (current_char) {
-  case ('('):
-    AddToken(TokenType::kLeftParen);
-    break;
-  case (')'):
-    AddToken(TokenType::kRightParen);
-    break;
-  case ('{'):
-    AddToken(TokenType::kLeftBracket);
-    break;
-  case ('}'):
-    AddToken(TokenType::kRightBracket);
-    break;
-  case ('['):
-    AddToken(TokenType::kLeftSquareBracket);
-    break;
-  case (']'):
-    AddToken(TokenType::kRightSquareBracket);
-    break;
-  case (','):
-    AddToken(TokenType::kComma);
-    break;
-  case (':'):
-    AddToken(TokenType::kColon);
-    break;
-  case (';'):
-    AddToken(TokenType::kSemiColon);
-    break;
-  case ('+'):
-    AddToken(TokenType::kPlus);
-    break;
-  case ('-'):
-    AddToken(TokenType::kMinus);
-    break;
-  case ('%'):
-    AddToken(TokenType::kRemainder);
-    break;
-  case ('*'):
-    if (Peek(0) == '>' && Peek(1) == '>') {
-      Advance();
-      Advance();
-      AddToken(TokenType::kHighMul);
-      column_delta_ = current_ - start_;
-    } else {
-      AddToken(TokenType::kStar);
-    }
-    break;
-  case ('/'):
-    if (Match('/')) {
-      column_delta_ = 2;
-      Comment();
-    } else {
-      AddToken(TokenType::kSlash);
-    }
-    break;
-  case ('_'):
-    AddToken(TokenType::kUnderscore);
-    break;
-  case ('!'):
-    if (Peek(0) == '=') {
-      Advance();
-      AddToken(TokenType::kBangEqual);
-      column_delta_ = 2;
-    } else {
-      AddToken(TokenType::kBang);
-    }
-    break;
-  case ('='):
-    if (Peek(0) == '=') {
-      Advance();
-      AddToken(TokenType::kEqualEqual);
-      column_delta_ = 2;
-    } else {
-      AddToken(TokenType::kEqual);
-    }
-    break;
-  case ('>'):
-    if (Peek(0) == '=') {
-      Advance();
-      AddToken(TokenType::kGreaterEqual);
-      column_delta_ = 2;
-    } else {
-      AddToken(TokenType::kGreater);
-    }
-    break;
-  case ('<'):
-    if (Peek(0) == '=') {
-      Advance();
-      AddToken(TokenType::kLessEqual);
-      column_delta_ = 2;
-    } else {
-      AddToken(TokenType::kLess);
-    }
-    break;
-  case ('&'):
-    AddToken(TokenType::kLogicalAnd);
-    break;
-  case ('|'):
-    AddToken(TokenType::kLogicalOr);
-    break;
-  case (' '):
-  case ('\r'):
-  case ('\t'):
+  switch (kCharClassTable[static_cast<unsigned char>(current_char)]) {
+  case (CharClass::kWhitespace):
+  case (CharClass::kNewline):
+    Whitespace();
+    return;
+  case (CharClass::kAlpha):
+    Advance();
+    Identifier();
     break;
-  case ('\n'):
-    line_++;
-    column_ = 1;
-    column_delta_ = 0;
+  case (CharClass::kDigit):
+    Advance();
+    Integer();
     break;
-  case ('\"'):
+  case (CharClass::kDoubleQuote):
+    Advance();
     String();
     break;
-  case ('\''):
+  case (CharClass::kSingleQuote):
+    Advance();
     Character();
     break;
-  default:
-    if (IsAlpha(current_char)) {
-      Identifier();
-    } else if (IsDigit(current_char)) {
-      Integer();
-    } else {
-      diagnostic_reporter_.ReportCompilerError(
-          std::move(SourceCodeLocation{
-              .source_name = file_path_, .line = line_, .column = column_}),
-          Severity::kFatal,
-          std::format(
-              "[E]: Unrecgonized character present inside the source file: {}.",
-              std::string(1, current_char)));
-    }
+  case (CharClass::kPunctuator):
+    Operator();
+    break;
+  case (CharClass::kSentinel):
+  case (CharClass::kInvalid):
+    Advance();
+    diagnostic_reporter_.ReportCompilerError(
+        GetSourceCodeLocation(start_, current_), Severity::kFatal,
+        DiagnosticMessage{
+            .format = "[E]: Unrecgonized character present inside the source "
+                      "file: {}.",
+            .argument = std::string(1, current_char)});
+    break;
   }
 
-  UpdateColumnNumber();
-
   return;
 }
 
-bool Lexer::Match(char expected) {
-  if (IsAtEnd() || (source_code_[current_] != expected)) {
-    return false;
+void Lexer::Operator() {
+  // Runs the punctuator DFA until it rejects, remembering the last state that
+  // recognized a complete punctuator. Every punctuator character is accepted
+  // on its own, so there is always such a state.
+  std::uint8_t state = PunctuatorDfa::kStartState;
+  std::uint8_t accepted_state = PunctuatorDfa::kRejectState;
+  std::size_t accepted_end = current_;
+
+  for (std::size_t position = current_;; position++) {
+    state = kPunctuatorDfa.Next(state, source_code_[position]);
+    if (state == PunctuatorDfa::kRejectState) {
+      break;
+    }
+    if (kPunctuatorDfa.actions[state] != PunctuatorAction::kNone) {
+      accepted_state = state;
+      accepted_end = position + 1;
+    }
+  }
+
+  current_ = accepted_end;
+
+  if (kPunctuatorDfa.actions[accepted_state] == PunctuatorAction::kComment) {
+    Comment();
   } else {
-    Advance();
-    return true;
+    AddToken(kPunctuatorDfa.token_types[accepted_state]);
   }
+
+  return;
 }
 
 char Lexer::Peek(std::size_t offset) {
-  if ((current_ + offset) >= source_code_.length()) {
-    return '\0';
-  }
+  // 'std::string' guarantees a '\0' right after its last character, which the
+  // lexer uses as a sentinel instead of checking bounds on every read.
   return source_code_[current_ + offset];
 }
 
 void Lexer::String() {
-  std::string literal_content;
-
-  while (!IsAtEnd() && Peek(0) != '\"') {
+  // Literals without escape sequences are interned straight from the source
+  // code. The first escape sequence switches to decoding the literal into
+  // 'string_buffer_', which is reused by every literal of the file.
+  bool has_escapes = false;
+  while (Peek(0) != '\"') {
+    if (Peek(0) == '\0' && IsAtEnd()) {
+      break;
+    }
     char current_char = Advance();
 
     if (current_char == '\n') {
-      line_++;
-      column_ = 1;
       diagnostic_reporter_.ReportCompilerError(
-          std::move(SourceCodeLocation{
-              .source_name = file_path_, .line = line_, .column = column_}),
-          Severity::kFatal,
-          std::format("[E]: A string literal cannot span multiple lines in a "
-                      "source file."));
+          GetSourceCodeLocation(current_, current_), Severity::kFatal,
+          DiagnosticMessage{
+              .format = "[E]: A string literal cannot span multiple lines in "
+                        "a source file.",
+              .argument = {}});
       return;
-    } else {
-      literal_content += current_char;
+    }
+
+    if (current_char == '\\') {
+      if (!has_escapes) {
+        has_escapes = true;
+        string_buffer_.assign(
+            source_code_.substr(start_ + 1, current_ - start_ - 2));
+      }
+      if (!EscapeSequence(current_char)) {
+        return;
+      }
+      string_buffer_ += current_char;
+    } else if (has_escapes) {
+      string_buffer_ += current_char;
     }
   }
 
   // Verifies if the string literal has been correctly terminated.
   if (IsAtEnd() || Peek(0) != '\"') {
     diagnostic_reporter_.ReportCompilerError(
-        std::move(SourceCodeLocation{
-            .source_name = file_path_, .line = line_, .column = column_}),
-        Severity::kFatal,
-        std::format("[E]: An unterminated string literal was found within the "
-                    "source file."));
+        GetSourceCodeLocation(start_, current_), Severity::kFatal,
+        DiagnosticMessage{
+            .format = "[E]: An unterminated string literal was found within "
+                      "the source file.",
+            .argument = {}});
     return;
   }
 
   // Consumes the enclosing double-quote character: '"'.
   Advance();
-  AddToken(TokenType::kString, literal_content);
-  column_delta_ = current_ - start_;
+  std::string_view contents =
+      has_escapes ? std::string_view{string_buffer_}
+                  : source_code_.substr(start_ + 1, current_ - start_ - 2);
+  Symbol symbol = string_interner_.Intern(contents);
+  AddToken(TokenType::kString, TokenValue{.symbol_value = symbol});
 
   return;
 }
 
-void Lexer::UpdateColumnNumber() {
-  column_ += column_delta_;
+void Lexer::Whitespace() {
+  // Consumes the whole run of blanks and newlines at once. Line numbers are
+  // recovered from the offsets of the tokens, so newlines need no bookkeeping.
+  current_ = simd_scanner_.skip_whitespace(source_code_.data(), current_, end_);
 
   return;
 }
 
+std::string_view Lexer::GetSourceCode() const { return source_code_; }
+
 const std::vector<Token> &Lexer::LexTokens() {
-  while (!IsAtEnd()) {
+  LexTokens(tokens_);
+
+  return tokens_;
+}
+
+void Lexer::LexTokens(std::vector<Token> &tokens) {
+  TraceScope trace_scope{"Lexer::LexTokens", file_path_};
+  trace_scope.SetByteCount(end_ - current_);
+  std::size_t initial_token_count = tokens.size();
+
+  while (true) {
+    Token token = NextToken();
+    if (has_fatal_error_) {
+      trace_scope.SetTokenCount(tokens.size() - initial_token_count);
+      return;
+    }
+    tokens.push_back(token);
+    // The file end token at the end of the token sequence makes the parsing
+    // stage easier.
+    if (token.token_type_ == TokenType::kFileEnd) {
+      trace_scope.SetTokenCount(tokens.size() - initial_token_count);
+      return;
+    }
+  }
+}
+
+Token Lexer::NextToken() {
+  // Whitespace and comments do not produce tokens, so it can take several
+  // calls to 'LexToken' to get to the next one.
+  while (!has_fatal_error_ && !IsAtEnd()) {
     start_ = current_;
     LexToken();
-    if (diagnostic_reporter_.HasFatalErrors()) {
-      return tokens_;
+    has_fatal_error_ = diagnostic_reporter_.HasFatalErrors();
+    if (has_pending_token_) {
+      has_pending_token_ = false;
+      return pending_token_;
     }
   }
-  // Add a file end token at the end of the token sequence in order to make the
-  // parsing stage easier.
-  tokens_.emplace_back(Token(line_, column_, TokenType::kFileEnd, {}, ""));
 
-  return tokens_;
+  return Token(TokenType::kFileEnd, current_, 0);
 }
@@ -0,0 +1,42 @@
+#include "senbonzakura/line_table.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "senbonzakura/simd_scanner.hpp"
+
+LineTable::LineTable(std::string_view source_code) {
+  const SimdScanner &simd_scanner = GetSimdScanner();
+
+  line_starts_.push_back(0);
+  std::size_t position = 0;
+  while (true) {
+    position = simd_scanner.find_newline(source_code.data(), position,
+                                         source_code.length());
+    if (position == source_code.length()) {
+      break;
+    }
+    position++;
+    line_starts_.push_back(static_cast<std::uint32_t>(position));
+  }
+}
+
+std::size_t LineTable::GetLineCount() const { return line_starts_.size(); }
+
+std::size_t LineTable::GetLineStart(std::size_t line) const {
+  return line_starts_[line - 1];
+}
+
+LineColumn LineTable::Resolve(std::size_t offset) const {
+  // The line of 'offset' is the last one starting at or before it.
+  auto line_start = std::upper_bound(line_starts_.begin(), line_starts_.end(),
+                                     static_cast<std::uint32_t>(offset)) -
+                    1;
+
+  return LineColumn{
+      .line = static_cast<std::uint32_t>(line_start - line_starts_.begin() + 1),
+      .column = static_cast<std::uint32_t>(offset - *line_start + 1),
+  };
+}
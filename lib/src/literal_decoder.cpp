@@ -0,0 +1,97 @@
+#include "senbonzakura/literal_decoder.hpp"
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+bool DecodeIntegerLiteral(std::string_view digits, std::uint64_t &magnitude) {
+  std::from_chars_result result = std::from_chars(
+      digits.data(), digits.data() + digits.length(), magnitude);
+
+  return result.ec == std::errc{} && magnitude <= kMaxIntegerLiteralMagnitude;
+}
+
+DecodedEscape DecodeEscapeSequence(std::string_view text) {
+  if (text.length() < 2) {
+    return DecodedEscape{EscapeStatus::kUnknown, '\0', text.length()};
+  }
+
+  switch (text[1]) {
+  case ('\\'):
+    return DecodedEscape{EscapeStatus::kValid, '\\', 2};
+  case ('\''):
+    return DecodedEscape{EscapeStatus::kValid, '\'', 2};
+  case ('\"'):
+    return DecodedEscape{EscapeStatus::kValid, '\"', 2};
+  case ('n'):
+    return DecodedEscape{EscapeStatus::kValid, '\n', 2};
+  case ('t'):
+    return DecodedEscape{EscapeStatus::kValid, '\t', 2};
+  case ('r'):
+    return DecodedEscape{EscapeStatus::kValid, '\r', 2};
+  case ('x'):
+    break;
+  default:
+    return DecodedEscape{EscapeStatus::kUnknown, '\0', 2};
+  }
+
+  // Handles '\x{HHHHHH}'.
+  constexpr std::size_t kMaxHexDigits = 6;
+  std::size_t closing_brace =
+      text.substr(0, 3 + kMaxHexDigits + 1).find('}', 3);
+  if (text.length() < 3 || text[2] != '{' ||
+      closing_brace == std::string_view::npos || closing_brace == 3 ||
+      closing_brace - 3 > kMaxHexDigits) {
+    return DecodedEscape{EscapeStatus::kMalformed, '\0', 2};
+  }
+
+  std::uint32_t code_point = 0;
+  const char *hex_end = text.data() + closing_brace;
+  std::from_chars_result result =
+      std::from_chars(text.data() + 3, hex_end, code_point, 16);
+  if (result.ec != std::errc{} || result.ptr != hex_end) {
+    return DecodedEscape{EscapeStatus::kMalformed, '\0', 2};
+  }
+  if (code_point > 0x7F) {
+    return DecodedEscape{EscapeStatus::kOutOfRange, '\0', closing_brace + 1};
+  }
+
+  return DecodedEscape{EscapeStatus::kValid, static_cast<char>(code_point),
+                       closing_brace + 1};
+}
+
+void AppendEscapedLiteral(std::string &output, std::string_view value) {
+  constexpr char kHexDigits[] = "0123456789abcdef";
+
+  for (char c : value) {
+    switch (c) {
+    case ('\\'):
+      output += "\\\\";
+      break;
+    case ('\n'):
+      output += "\\n";
+      break;
+    case ('\t'):
+      output += "\\t";
+      break;
+    case ('\r'):
+      output += "\\r";
+      break;
+    default:
+      if (static_cast<unsigned char>(c) < 0x20 || c == 0x7F) {
+        output += "\\x{";
+        output += kHexDigits[(c >> 4) & 0xF];
+        output += kHexDigits[c & 0xF];
+        output += '}';
+      } else {
+        output += c;
+      }
+      break;
+    }
+  }
+
+  return;
+}
@@ -0,0 +1,121 @@
+#include "senbonzakura/parallel_lexer.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "senbonzakura/diagnostic_reporter.hpp"
+#include "senbonzakura/lexer.hpp"
+#include "senbonzakura/simd_scanner.hpp"
+#include "senbonzakura/token.hpp"
+#include "senbonzakura/token_type.hpp"
+#include "senbonzakura/trace.hpp"
+
+namespace {
+
+struct ChunkResult {
+  std::vector<Token> tokens;
+  DiagnosticReporter diagnostic_reporter;
+};
+
+} // namespace
+
+std::vector<std::size_t> SplitAtNewlines(std::string_view source_code,
+                                         std::size_t chunk_count) {
+  const SimdScanner &simd_scanner = GetSimdScanner();
+  std::vector<std::size_t> boundaries{0};
+  chunk_count = std::max<std::size_t>(chunk_count, 1);
+
+  for (std::size_t chunk = 1; chunk < chunk_count; chunk++) {
+    std::size_t target = std::max(source_code.length() * chunk / chunk_count,
+                                  boundaries.back());
+    std::size_t newline =
+        simd_scanner.find_newline(source_code.data(), target,
+                                  source_code.length());
+    // Skips the newline of a character literal such as '\n' written with a
+    // raw newline, which is the only token that spans two lines.
+    while (newline < source_code.length() && newline > 0 &&
+           source_code[newline - 1] == '\'' &&
+           newline + 1 < source_code.length() &&
+           source_code[newline + 1] == '\'') {
+      newline = simd_scanner.find_newline(source_code.data(), newline + 1,
+                                          source_code.length());
+    }
+    if (newline + 1 >= source_code.length()) {
+      break;
+    }
+    if (newline + 1 > boundaries.back()) {
+      boundaries.push_back(newline + 1);
+    }
+  }
+  boundaries.push_back(source_code.length());
+
+  return boundaries;
+}
+
+std::vector<Token> LexTokensInParallel(const std::string &file_path,
+                                       std::string_view source_code,
+                                       DiagnosticReporter &diagnostic_reporter,
+                                       std::size_t thread_count) {
+  std::size_t chunk_count =
+      std::min(thread_count,
+               source_code.length() / kMinParallelLexingChunkSize);
+  if (chunk_count <= 1) {
+    std::vector<Token> tokens;
+    Lexer lexer{file_path, source_code, diagnostic_reporter};
+    lexer.LexTokens(tokens);
+    return tokens;
+  }
+
+  // Spans the chunks lexed on the other threads, and the merge of their
+  // tokens.
+  TraceScope trace_scope{"LexTokensInParallel", file_path};
+  trace_scope.SetByteCount(source_code.length());
+  std::vector<std::size_t> boundaries =
+      SplitAtNewlines(source_code, chunk_count);
+  std::vector<ChunkResult> results(boundaries.size() - 1);
+
+  {
+    std::vector<std::jthread> workers;
+    for (std::size_t chunk = 0; chunk < results.size(); chunk++) {
+      workers.emplace_back([&, chunk]() {
+        ChunkResult &result = results[chunk];
+        Lexer lexer{file_path, source_code, boundaries[chunk],
+                    boundaries[chunk + 1], result.diagnostic_reporter};
+        lexer.LexTokens(result.tokens);
+      });
+    }
+  }
+
+  std::size_t token_count = 0;
+  for (const ChunkResult &result : results) {
+    token_count += result.tokens.size();
+  }
+  std::vector<Token> tokens;
+  tokens.reserve(token_count);
+
+  for (std::size_t chunk = 0; chunk < results.size(); chunk++) {
+    ChunkResult &result = results[chunk];
+    bool is_last_chunk = chunk + 1 == results.size();
+    diagnostic_reporter.Merge(result.diagnostic_reporter);
+
+    // Only the last chunk ends at the end of the file, so the 'kFileEnd' of
+    // the others is dropped.
+    auto tokens_end = result.tokens.end();
+    if (!is_last_chunk && !result.tokens.empty() &&
+        result.tokens.back().token_type_ == TokenType::kFileEnd) {
+      tokens_end--;
+    }
+    tokens.insert(tokens.end(), result.tokens.begin(), tokens_end);
+
+    if (result.diagnostic_reporter.HasFatalErrors()) {
+      break;
+    }
+  }
+  trace_scope.SetTokenCount(tokens.size());
+
+  return tokens;
+}
@@ -1,8 +1,825 @@
 #include "senbonzakura/parser.hpp"
 
-Parser::Parser(const std::string &file_path, const std::vector<Token> &tokens,
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "senbonzakura/ast.hpp"
+#include "senbonzakura/diagnostic_reporter.hpp"
+#include "senbonzakura/literal_decoder.hpp"
+#include "senbonzakura/token.hpp"
+#include "senbonzakura/token_type.hpp"
+#include "senbonzakura/trace.hpp"
+
+namespace {
+
+// Binding power of the binary operators, from the precedence table of the
+// Eta Language Specification. Every binary operator is left-associative. 0
+// means that the token is not a binary operator, which ends an expression.
+int GetBindingPower(TokenType token_type) {
+  switch (token_type) {
+  case TokenType::kLogicalOr:
+    return 1;
+  case TokenType::kLogicalAnd:
+    return 2;
+  case TokenType::kEqualEqual:
+  case TokenType::kBangEqual:
+    return 3;
+  case TokenType::kLess:
+  case TokenType::kLessEqual:
+  case TokenType::kGreater:
+  case TokenType::kGreaterEqual:
+    return 4;
+  case TokenType::kPlus:
+  case TokenType::kMinus:
+    return 5;
+  case TokenType::kStar:
+  case TokenType::kHighMul:
+  case TokenType::kSlash:
+  case TokenType::kRemainder:
+    return 6;
+  default:
+    return 0;
+  }
+}
+
+} // namespace
+
+Parser::NestingScope::NestingScope(Parser &parser) : parser_{parser} {
+  parser_.nesting_depth_++;
+  if (parser_.nesting_depth_ > kMaxNestingDepth) {
+    const Token &token = parser_.Peek();
+    parser_.ReportError(token.offset_, token.length_,
+                        "[E]: The code is nested more than {} levels deep, "
+                        "which is not supported.",
+                        std::to_string(kMaxNestingDepth));
+  }
+}
+
+Parser::NestingScope::~NestingScope() { parser_.nesting_depth_--; }
+
+Parser::Parser(const std::string &file_path, std::string_view source_code,
+               TokenStream &token_stream,
                DiagnosticReporter &diagnostic_reporter)
-    : file_path_{file_path}, tokens_{tokens},
-      diagnostic_reporter_{diagnostic_reporter} {}
+    : file_path_{file_path}, source_code_{source_code},
+      token_cursor_{token_stream}, diagnostic_reporter_{diagnostic_reporter} {}
+
+void Parser::Reserve(std::size_t token_count) {
+  ast_.Reserve(token_count);
+
+  return;
+}
+
+Ast Parser::Parse() {
+  TraceScope trace_scope{"Parser::Parse", file_path_};
+  ast_.SetRoot(Program());
+
+  return std::move(ast_);
+}
+
+std::size_t Parser::GetSyntaxErrorCount() const { return syntax_error_count_; }
+
+const Token &Parser::Peek(std::size_t offset) {
+  return token_cursor_.Peek(offset);
+}
+
+bool Parser::Check(TokenType token_type) {
+  return Peek().token_type_ == token_type;
+}
+
+bool Parser::Match(TokenType token_type) {
+  if (!Check(token_type)) {
+    return false;
+  }
+  token_cursor_.Advance();
+
+  return true;
+}
+
+bool Parser::Expect(TokenType token_type, std::string_view expectation) {
+  if (Match(token_type)) {
+    return true;
+  }
+  const Token &token = Peek();
+  std::string found = token.token_type_ == TokenType::kFileEnd
+                          ? std::string{"the end of the file"}
+                          : std::format("'{}'", token.GetLexeme(source_code_));
+  ReportError(token.offset_, token.length_, "[E]: Expected {}.",
+              std::format("{}, but found {}", expectation, found));
+
+  return false;
+}
+
+void Parser::ReportUnexpectedToken(std::string_view format) {
+  const Token &token = Peek();
+  std::string found = token.token_type_ == TokenType::kFileEnd
+                          ? std::string{"the end of the file"}
+                          : std::format("'{}'", token.GetLexeme(source_code_));
+  ReportError(token.offset_, token.length_, format, std::move(found));
+
+  return;
+}
+
+void Parser::ReportError(std::uint32_t offset, std::uint32_t length,
+                         std::string_view format, std::string argument) {
+  // Errors found while unwinding are most likely caused by the first one.
+  if (is_panicking_) {
+    return;
+  }
+  ReportInvalidConstruct(offset, length, format, std::move(argument));
+  is_panicking_ = true;
+
+  return;
+}
+
+void Parser::ReportInvalidConstruct(std::uint32_t offset, std::uint32_t length,
+                                    std::string_view format,
+                                    std::string argument) {
+  syntax_error_count_++;
+  if (!line_table_) {
+    line_table_.emplace(source_code_);
+    file_symbol_ = string_interner_.Intern(file_path_);
+  }
+  LineColumn position = line_table_->Resolve(offset);
+  diagnostic_reporter_.ReportCompilerError(
+      SourceCodeLocation{
+          .file = file_symbol_,
+          .line = position.line,
+          .column = position.column,
+          .offset = offset,
+          .length = length,
+      },
+      Severity::kError,
+      DiagnosticMessage{.format = format, .argument = std::move(argument)});
+
+  return;
+}
+
+bool Parser::HasFailed() const { return is_panicking_; }
+
+void Parser::SynchronizeStatement(std::uint32_t statement_offset) {
+  // Once the reporter drops errors, parsing the rest of the file is wasted
+  // work, so the parser stays in panic mode and unwinds completely.
+  if (diagnostic_reporter_.HasReachedErrorLimit()) {
+    return;
+  }
+  // A statement that failed on its first token would otherwise be parsed
+  // again from the same token.
+  if (Peek().offset_ == statement_offset && !Check(TokenType::kRightBracket) &&
+      !token_cursor_.IsAtEnd()) {
+    token_cursor_.Advance();
+  }
+
+  std::size_t brace_depth = 0;
+  while (!token_cursor_.IsAtEnd()) {
+    TokenType token_type = Peek().token_type_;
+    if (brace_depth == 0) {
+      if (token_type == TokenType::kSemiColon) {
+        token_cursor_.Advance();
+        break;
+      }
+      if (token_type == TokenType::kRightBracket ||
+          token_type == TokenType::kIf || token_type == TokenType::kWhile ||
+          token_type == TokenType::kReturn) {
+        break;
+      }
+    }
+    if (token_type == TokenType::kLeftBracket) {
+      brace_depth++;
+    } else if (token_type == TokenType::kRightBracket) {
+      brace_depth--;
+    }
+    token_cursor_.Advance();
+  }
+  is_panicking_ = false;
+
+  return;
+}
+
+void Parser::SynchronizeDefinition(std::uint32_t definition_offset) {
+  if (diagnostic_reporter_.HasReachedErrorLimit()) {
+    return;
+  }
+  if (Peek().offset_ == definition_offset && !token_cursor_.IsAtEnd()) {
+    token_cursor_.Advance();
+  }
+
+  std::size_t brace_depth = 0;
+  while (!token_cursor_.IsAtEnd()) {
+    const Token &token = Peek();
+    if (brace_depth == 0 && IsAtLineStart(token) &&
+        (token.token_type_ == TokenType::kUse ||
+         (token.token_type_ == TokenType::kIdentifier &&
+          (Peek(1).token_type_ == TokenType::kLeftParen ||
+           Peek(1).token_type_ == TokenType::kColon)))) {
+      break;
+    }
+    if (token.token_type_ == TokenType::kLeftBracket) {
+      brace_depth++;
+    } else if (token.token_type_ == TokenType::kRightBracket &&
+               brace_depth > 0) {
+      brace_depth--;
+    }
+    token_cursor_.Advance();
+  }
+  is_panicking_ = false;
+
+  return;
+}
+
+bool Parser::IsAtLineStart(const Token &token) const {
+  std::size_t position = token.offset_;
+  while (position > 0 && (source_code_[position - 1] == ' ' ||
+                          source_code_[position - 1] == '\t' ||
+                          source_code_[position - 1] == '\r')) {
+    position--;
+  }
+
+  return position == 0 || source_code_[position - 1] == '\n';
+}
+
+AstIndex Parser::AddErrorNode() {
+  return ast_.AddNode(AstNodeKind::kError, Peek().offset_);
+}
+
+void Parser::CheckIntegerLiteral(const Token &token, bool is_negated) {
+  if (is_negated || token.value_.integer_value < kMaxIntegerLiteralMagnitude) {
+    return;
+  }
+  ReportError(token.offset_, token.length_,
+              "[E]: The integer literal '{}' is too large. Eta integers are "
+              "64-bit values, from -9223372036854775808 to "
+              "9223372036854775807.",
+              std::string{token.GetLexeme(source_code_)});
+
+  return;
+}
+
+AstIndex Parser::Program() {
+  std::size_t scratch_begin = scratch_.size();
+  bool has_definitions = false;
+
+  while (!token_cursor_.IsAtEnd() && !HasFailed()) {
+    std::uint32_t definition_offset = Peek().offset_;
+    AstIndex definition = kNoAstIndex;
+    if (Check(TokenType::kUse)) {
+      if (has_definitions) {
+        const Token &token = Peek();
+        ReportInvalidConstruct(token.offset_, token.length_,
+                               "[E]: 'use' declarations must precede every "
+                               "function and global variable definition.");
+      }
+      definition = Use();
+    } else if (Check(TokenType::kIdentifier) &&
+               Peek(1).token_type_ == TokenType::kLeftParen) {
+      definition = Function();
+      has_definitions = true;
+    } else if (Check(TokenType::kIdentifier) &&
+               Peek(1).token_type_ == TokenType::kColon) {
+      definition = GlobalDeclaration();
+      has_definitions = true;
+    } else {
+      ReportUnexpectedToken("[E]: Expected a 'use' declaration, a function "
+                            "definition or a global variable declaration, "
+                            "but found {}.");
+      definition = AddErrorNode();
+    }
+    scratch_.push_back(definition);
+    if (HasFailed()) {
+      SynchronizeDefinition(definition_offset);
+    }
+  }
+
+  AstIndex program = ast_.AddRangeNode(
+      AstNodeKind::kProgram, 0, std::span{scratch_}.subspan(scratch_begin));
+  scratch_.resize(scratch_begin);
+
+  return program;
+}
+
+AstIndex Parser::Use() {
+  Token use_token = token_cursor_.Advance();
+  if (!Check(TokenType::kIdentifier)) {
+    ReportUnexpectedToken("[E]: Expected the name of an interface after "
+                          "'use', but found {}.");
+    return AddErrorNode();
+  }
+  AstIndex use = ast_.AddNode(AstNodeKind::kUse, use_token.offset_);
+  ast_.GetNode(use).symbol = token_cursor_.Advance().value_.symbol_value;
+  Match(TokenType::kSemiColon);
+
+  return use;
+}
+
+AstIndex Parser::Function() {
+  Token name_token = token_cursor_.Advance();
+  std::size_t scratch_begin = scratch_.size();
+  token_cursor_.Advance(); // '('
+
+  if (!Check(TokenType::kRightParen)) {
+    do {
+      scratch_.push_back(Declaration(false));
+    } while (!HasFailed() && Match(TokenType::kComma));
+  }
+  Expect(TokenType::kRightParen, "')' to close the parameter list");
+  std::size_t parameter_count = scratch_.size() - scratch_begin;
+
+  if (!HasFailed() && Match(TokenType::kColon)) {
+    do {
+      scratch_.push_back(Type(false));
+    } while (!HasFailed() && Match(TokenType::kComma));
+  }
+
+  AstIndex body = HasFailed() ? AddErrorNode() : Block();
+  std::span<const AstIndex> lists = std::span{scratch_}.subspan(scratch_begin);
+  AstIndex function = ast_.AddFunction(
+      name_token.offset_, name_token.value_.symbol_value,
+      lists.first(parameter_count), lists.subspan(parameter_count), body);
+  scratch_.resize(scratch_begin);
+
+  return function;
+}
+
+AstIndex Parser::GlobalDeclaration() {
+  std::uint32_t offset = Peek().offset_;
+  AstIndex declaration = Declaration(false);
+  AstIndex value = kNoAstIndex;
+  if (!HasFailed() && Match(TokenType::kEqual)) {
+    value = GlobalValue();
+  }
+  Match(TokenType::kSemiColon);
+
+  return ast_.AddPairNode(AstNodeKind::kGlobalDeclaration, offset, declaration,
+                          value);
+}
+
+AstIndex Parser::GlobalValue() {
+  const Token &token = Peek();
+  std::uint32_t offset = token.offset_;
+  if (token.token_type_ == TokenType::kTrue ||
+      token.token_type_ == TokenType::kFalse) {
+    AstIndex value = ast_.AddNode(AstNodeKind::kBoolean, offset);
+    ast_.GetNode(value).boolean_value =
+        token_cursor_.Advance().value_.boolean_value;
+    return value;
+  }
+
+  bool is_negated = Match(TokenType::kMinus);
+  AstIndex value = kNoAstIndex;
+  if (Check(TokenType::kInteger)) {
+    CheckIntegerLiteral(Peek(), is_negated);
+    value = ast_.AddNode(AstNodeKind::kInteger, Peek().offset_);
+    ast_.GetNode(value).integer_value =
+        token_cursor_.Advance().value_.integer_value;
+  } else if (Check(TokenType::kCharacter)) {
+    value = ast_.AddNode(AstNodeKind::kCharacter, Peek().offset_);
+    ast_.GetNode(value).character_value =
+        token_cursor_.Advance().value_.character_value;
+  } else {
+    ReportUnexpectedToken("[E]: A global variable can only be initialized "
+                          "with an integer, character or boolean literal, "
+                          "but found {}.");
+    return AddErrorNode();
+  }
+
+  if (is_negated) {
+    value = ast_.AddPairNode(AstNodeKind::kUnary, offset, value);
+    ast_.GetNode(value).operator_type = TokenType::kMinus;
+  }
+
+  return value;
+}
+
+AstIndex Parser::Declaration(bool allows_lengths) {
+  if (!Check(TokenType::kIdentifier)) {
+    ReportUnexpectedToken("[E]: Expected the name of a variable, but found "
+                          "{}.");
+    return AddErrorNode();
+  }
+  Token name_token = token_cursor_.Advance();
+  AstIndex name = AddIdentifier(name_token);
+  if (!Expect(TokenType::kColon, "':' after the name of the variable")) {
+    return AddErrorNode();
+  }
+  AstIndex type = Type(allows_lengths);
+
+  return ast_.AddPairNode(AstNodeKind::kDeclaration, name_token.offset_, name,
+                          type);
+}
+
+AstIndex Parser::Type(bool allows_lengths) {
+  std::uint32_t offset = Peek().offset_;
+  AstIndex type = kNoAstIndex;
+  if (Match(TokenType::kInt)) {
+    type = ast_.AddNode(AstNodeKind::kIntType, offset);
+  } else if (Match(TokenType::kBool)) {
+    type = ast_.AddNode(AstNodeKind::kBoolType, offset);
+  } else {
+    ReportUnexpectedToken("[E]: Expected a type, 'int' or 'bool', but found "
+                          "{}.");
+    return AddErrorNode();
+  }
+
+  // The lengths of the dimensions, or 'kNoAstIndex' for the ones without
+  // length, from the outermost to the innermost.
+  std::size_t scratch_begin = scratch_.size();
+  while (!HasFailed() && Check(TokenType::kLeftSquareBracket)) {
+    Token bracket_token = token_cursor_.Advance();
+    AstIndex length = kNoAstIndex;
+    if (!Check(TokenType::kRightSquareBracket)) {
+      if (!allows_lengths) {
+        ReportInvalidConstruct(bracket_token.offset_, bracket_token.length_,
+                               "[E]: The length of an array can only be "
+                               "given in the declaration of a local "
+                               "variable.");
+      } else if (scratch_.size() > scratch_begin &&
+                 scratch_.back() == kNoAstIndex) {
+        ReportInvalidConstruct(bracket_token.offset_, bracket_token.length_,
+                               "[E]: The length of an array dimension cannot "
+                               "be given after a dimension without length.");
+      }
+      length = Expression();
+    }
+    scratch_.push_back(length);
+    Expect(TokenType::kRightSquareBracket,
+           "']' to close the dimension of the array type");
+  }
+
+  // 'int[3][4]' is an array of 3 arrays of 4 integers, so the type is built
+  // from the innermost dimension outwards.
+  for (std::size_t dimension = scratch_.size(); dimension > scratch_begin;
+       dimension--) {
+    type = ast_.AddPairNode(AstNodeKind::kArrayType, offset, type,
+                            scratch_[dimension - 1]);
+  }
+  scratch_.resize(scratch_begin);
+
+  return type;
+}
+
+AstIndex Parser::Block() {
+  std::uint32_t offset = Peek().offset_;
+  if (!Expect(TokenType::kLeftBracket, "'{' to open a block")) {
+    return AddErrorNode();
+  }
+
+  std::size_t scratch_begin = scratch_.size();
+  bool follows_return = false;
+  while (!HasFailed() && !Check(TokenType::kRightBracket) &&
+         !token_cursor_.IsAtEnd()) {
+    const Token &token = Peek();
+    std::uint32_t statement_offset = token.offset_;
+    if (follows_return) {
+      ReportInvalidConstruct(token.offset_, token.length_,
+                             "[E]: A 'return' statement must be the last "
+                             "statement of its block, but it is followed by "
+                             "'{}'.",
+                             std::string{token.GetLexeme(source_code_)});
+      follows_return = false;
+    }
+    if (Check(TokenType::kReturn)) {
+      scratch_.push_back(Return());
+      follows_return = true;
+    } else {
+      scratch_.push_back(Statement());
+    }
+    // Semicolons are optional, even between statements on the same line.
+    if (HasFailed()) {
+      SynchronizeStatement(statement_offset);
+    } else {
+      Match(TokenType::kSemiColon);
+    }
+  }
+  Expect(TokenType::kRightBracket, "'}' to close the block");
+
+  AstIndex block = ast_.AddRangeNode(
+      AstNodeKind::kBlock, offset, std::span{scratch_}.subspan(scratch_begin));
+  scratch_.resize(scratch_begin);
+
+  return block;
+}
+
+AstIndex Parser::Statement() {
+  NestingScope nesting_scope{*this};
+  if (HasFailed()) {
+    return AddErrorNode();
+  }
+
+  switch (Peek().token_type_) {
+  case TokenType::kLeftBracket:
+    return Block();
+  case TokenType::kIf:
+    return If();
+  case TokenType::kWhile:
+    return While();
+  case TokenType::kIdentifier:
+  case TokenType::kUnderscore:
+    return SimpleStatement();
+  case TokenType::kReturn: {
+    const Token &token = Peek();
+    ReportInvalidConstruct(token.offset_, token.length_,
+                           "[E]: A 'return' statement can only be the last "
+                           "statement of a block, but it was found where a "
+                           "single statement was expected.");
+    return Return();
+  }
+  default:
+    ReportUnexpectedToken("[E]: Expected a statement, but found {}.");
+    return AddErrorNode();
+  }
+}
+
+AstIndex Parser::Branch() {
+  // A block is parsed directly rather than as a statement of its own, which
+  // would count as another level of nesting.
+  if (!HasFailed() && Check(TokenType::kLeftBracket)) {
+    return Block();
+  }
+
+  return Statement();
+}
+
+AstIndex Parser::If() {
+  std::uint32_t offset = token_cursor_.Advance().offset_;
+  // Guards need no parentheses, since a parenthesized guard is just a
+  // parenthesized expression.
+  AstIndex condition = Expression();
+  AstIndex then_branch = Branch();
+  AstIndex else_branch = kNoAstIndex;
+  if (!HasFailed() && Match(TokenType::kElse)) {
+    else_branch = Branch();
+  }
+
+  return ast_.AddIf(offset, condition, then_branch, else_branch);
+}
+
+AstIndex Parser::While() {
+  std::uint32_t offset = token_cursor_.Advance().offset_;
+  AstIndex condition = Expression();
+  AstIndex body = Branch();
+
+  return ast_.AddPairNode(AstNodeKind::kWhile, offset, condition, body);
+}
+
+AstIndex Parser::Return() {
+  std::uint32_t offset = token_cursor_.Advance().offset_;
+  std::size_t scratch_begin = scratch_.size();
+  // Since 'return' is the last statement of its block, it returns nothing
+  // when the block ends right after it.
+  if (!Check(TokenType::kSemiColon) && !Check(TokenType::kRightBracket)) {
+    do {
+      scratch_.push_back(Expression());
+    } while (!HasFailed() && Match(TokenType::kComma));
+  }
+
+  AstIndex return_statement = ast_.AddRangeNode(
+      AstNodeKind::kReturn, offset, std::span{scratch_}.subspan(scratch_begin));
+  scratch_.resize(scratch_begin);
+
+  return return_statement;
+}
+
+AstIndex Parser::SimpleStatement() {
+  std::uint32_t offset = Peek().offset_;
+  AstIndex first_target = AssignmentTarget();
+  if (HasFailed()) {
+    return first_target;
+  }
+
+  AstNodeKind first_kind = ast_.GetNode(first_target).kind;
+  if (!Check(TokenType::kComma) && !Check(TokenType::kEqual)) {
+    if (first_kind == AstNodeKind::kDeclaration ||
+        first_kind == AstNodeKind::kCall) {
+      return first_target;
+    }
+    ReportInvalidConstruct(offset, Peek().offset_ - offset,
+                           "[E]: Expected a statement, but found an "
+                           "expression that is neither a procedure call nor "
+                           "assigned to.");
+    return ast_.AddNode(AstNodeKind::kError, offset);
+  }
+
+  std::size_t scratch_begin = scratch_.size();
+  scratch_.push_back(first_target);
+  while (!HasFailed() && Match(TokenType::kComma)) {
+    scratch_.push_back(AssignmentTarget());
+  }
+  std::size_t target_count = scratch_.size() - scratch_begin;
+
+  bool has_values = !HasFailed() && Match(TokenType::kEqual);
+  if (has_values) {
+    do {
+      scratch_.push_back(Expression());
+    } while (!HasFailed() && Match(TokenType::kComma));
+  }
+
+  std::span<const AstIndex> lists = std::span{scratch_}.subspan(scratch_begin);
+  std::span<const AstIndex> targets = lists.first(target_count);
+  for (AstIndex target : targets) {
+    if (HasFailed()) {
+      break;
+    }
+    const AstNode &node = ast_.GetNode(target);
+    if (node.kind == AstNodeKind::kDeclaration) {
+      // Only the outermost dimension can have a length, so checking it is
+      // enough.
+      const AstNode &type = ast_.GetNode(node.pair.second);
+      if (has_values && type.kind == AstNodeKind::kArrayType &&
+          type.pair.second != kNoAstIndex) {
+        ReportInvalidConstruct(node.offset, 0,
+                               "[E]: An array declared with a length cannot "
+                               "also be initialized.");
+      }
+    } else if (!has_values) {
+      ReportUnexpectedToken("[E]: Expected '=' after the left-hand side of "
+                            "the assignment, but found {}.");
+    } else if (node.kind != AstNodeKind::kDiscard &&
+               node.kind != AstNodeKind::kIdentifier &&
+               node.kind != AstNodeKind::kIndex) {
+      ReportInvalidConstruct(node.offset, 0,
+                             "[E]: Only variables, array elements, "
+                             "declarations and '_' can be assigned to.");
+    }
+  }
+
+  AstIndex assignment =
+      ast_.AddAssignment(offset, targets, lists.subspan(target_count));
+  scratch_.resize(scratch_begin);
+
+  return assignment;
+}
+
+AstIndex Parser::AssignmentTarget() {
+  if (Check(TokenType::kUnderscore)) {
+    return ast_.AddNode(AstNodeKind::kDiscard, token_cursor_.Advance().offset_);
+  }
+  if (Check(TokenType::kIdentifier) &&
+      Peek(1).token_type_ == TokenType::kColon) {
+    return Declaration(true);
+  }
+
+  return Expression();
+}
+
+AstIndex Parser::Expression(int min_binding_power) {
+  AstIndex left = PrefixExpression();
+
+  while (!HasFailed()) {
+    int binding_power = GetBindingPower(Peek().token_type_);
+    if (binding_power <= min_binding_power) {
+      break;
+    }
+    Token operator_token = token_cursor_.Advance();
+    // Parsing the right operand with the binding power of the operator makes
+    // it stop at the next operator of the same precedence, which is then
+    // applied to the result: every operator is left-associative.
+    AstIndex right = Expression(binding_power);
+    std::uint32_t offset = ast_.GetNode(left).offset;
+    left = ast_.AddPairNode(AstNodeKind::kBinary, offset, left, right);
+    ast_.GetNode(left).operator_type = operator_token.token_type_;
+  }
+
+  return left;
+}
+
+AstIndex Parser::PrefixExpression(bool is_negated) {
+  NestingScope nesting_scope{*this};
+  if (HasFailed()) {
+    return AddErrorNode();
+  }
+
+  // Negations bind tighter than every binary operator, but looser than calls
+  // and array indexing.
+  if (Check(TokenType::kMinus) || Check(TokenType::kBang)) {
+    Token operator_token = token_cursor_.Advance();
+    AstIndex operand =
+        PrefixExpression(operator_token.token_type_ == TokenType::kMinus);
+    AstIndex unary =
+        ast_.AddPairNode(AstNodeKind::kUnary, operator_token.offset_, operand);
+    ast_.GetNode(unary).operator_type = operator_token.token_type_;
+    return unary;
+  }
+
+  if (Check(TokenType::kInteger)) {
+    // An indexed literal is not the operand of the minus, the indexing is.
+    bool is_indexed = Peek(1).token_type_ == TokenType::kLeftSquareBracket;
+    CheckIntegerLiteral(Peek(), is_negated && !is_indexed);
+  }
+  AstIndex expression = PrimaryExpression();
+  while (!HasFailed() && Check(TokenType::kLeftSquareBracket)) {
+    token_cursor_.Advance();
+    AstIndex index = Expression();
+    Expect(TokenType::kRightSquareBracket, "']' to close the array index");
+    std::uint32_t offset = ast_.GetNode(expression).offset;
+    expression =
+        ast_.AddPairNode(AstNodeKind::kIndex, offset, expression, index);
+  }
+
+  return expression;
+}
+
+AstIndex Parser::PrimaryExpression() {
+  const Token &token = Peek();
+  std::uint32_t offset = token.offset_;
+
+  switch (token.token_type_) {
+  case TokenType::kInteger: {
+    AstIndex literal = ast_.AddNode(AstNodeKind::kInteger, offset);
+    ast_.GetNode(literal).integer_value =
+        token_cursor_.Advance().value_.integer_value;
+    return literal;
+  }
+  case TokenType::kCharacter: {
+    AstIndex literal = ast_.AddNode(AstNodeKind::kCharacter, offset);
+    ast_.GetNode(literal).character_value =
+        token_cursor_.Advance().value_.character_value;
+    return literal;
+  }
+  case TokenType::kString: {
+    AstIndex literal = ast_.AddNode(AstNodeKind::kString, offset);
+    ast_.GetNode(literal).symbol = token_cursor_.Advance().value_.symbol_value;
+    return literal;
+  }
+  case TokenType::kTrue:
+  case TokenType::kFalse: {
+    AstIndex literal = ast_.AddNode(AstNodeKind::kBoolean, offset);
+    ast_.GetNode(literal).boolean_value =
+        token_cursor_.Advance().value_.boolean_value;
+    return literal;
+  }
+  case TokenType::kIdentifier: {
+    AstIndex identifier = AddIdentifier(token_cursor_.Advance());
+    if (!Match(TokenType::kLeftParen)) {
+      return identifier;
+    }
+    std::size_t scratch_begin = scratch_.size();
+    scratch_.push_back(identifier);
+    ExpressionList(TokenType::kRightParen, false,
+                   "')' to close the argument list");
+    AstIndex call = ast_.AddRangeNode(
+        AstNodeKind::kCall, offset, std::span{scratch_}.subspan(scratch_begin));
+    scratch_.resize(scratch_begin);
+    return call;
+  }
+  case TokenType::kLength: {
+    token_cursor_.Advance();
+    if (!Expect(TokenType::kLeftParen, "'(' after 'length'")) {
+      return AddErrorNode();
+    }
+    AstIndex array = Expression();
+    Expect(TokenType::kRightParen, "')' to close the argument of 'length'");
+    return ast_.AddPairNode(AstNodeKind::kLength, offset, array);
+  }
+  case TokenType::kLeftParen: {
+    token_cursor_.Advance();
+    AstIndex expression = Expression();
+    Expect(TokenType::kRightParen, "')' to close the parenthesized "
+                                   "expression");
+    return expression;
+  }
+  case TokenType::kLeftBracket: {
+    token_cursor_.Advance();
+    std::size_t scratch_begin = scratch_.size();
+    // As in C and Java, the last element can be followed by a comma.
+    ExpressionList(TokenType::kRightBracket, true,
+                   "'}' to close the array constructor");
+    AstIndex array =
+        ast_.AddRangeNode(AstNodeKind::kArrayLiteral, offset,
+                          std::span{scratch_}.subspan(scratch_begin));
+    scratch_.resize(scratch_begin);
+    return array;
+  }
+  default:
+    ReportUnexpectedToken("[E]: Expected an expression, but found {}.");
+    return AddErrorNode();
+  }
+}
+
+bool Parser::ExpressionList(TokenType closing_type, bool allows_trailing_comma,
+                            std::string_view expectation) {
+  if (Match(closing_type)) {
+    return true;
+  }
+
+  do {
+    scratch_.push_back(Expression());
+    if (allows_trailing_comma && Check(TokenType::kComma) &&
+        Peek(1).token_type_ == closing_type) {
+      token_cursor_.Advance();
+      break;
+    }
+  } while (!HasFailed() && Match(TokenType::kComma));
+
+  return Expect(closing_type, expectation);
+}
+
+AstIndex Parser::AddIdentifier(const Token &token) {
+  AstIndex identifier = ast_.AddNode(AstNodeKind::kIdentifier, token.offset_);
+  ast_.GetNode(identifier).symbol = token.value_.symbol_value;
 
-void Parser::Parse() {}
+  return identifier;
+}
@@ -0,0 +1,289 @@
+#include "senbonzakura/perf_counters.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace {
+
+struct PerfEventDescription {
+  std::string_view name;
+  std::uint32_t type;
+  std::uint64_t config;
+};
+
+constexpr std::uint64_t GetCacheMissConfig(std::uint64_t cache) {
+  return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+         (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+
+// Indexed by 'PerfEvent'.
+constexpr std::array<PerfEventDescription, kPerfEventCount>
+    kPerfEventDescriptions{{
+        {"cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {"instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {"branch-misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+        {"L1D-misses", PERF_TYPE_HW_CACHE,
+         GetCacheMissConfig(PERF_COUNT_HW_CACHE_L1D)},
+        {"LLC-misses", PERF_TYPE_HW_CACHE,
+         GetCacheMissConfig(PERF_COUNT_HW_CACHE_LL)},
+        {"page-faults", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS},
+    }};
+
+int OpenPerfEvent(const PerfEventDescription &description) {
+  perf_event_attr attributes{};
+  attributes.size = sizeof(perf_event_attr);
+  attributes.type = description.type;
+  attributes.config = description.config;
+  // Only the compiler itself is measured, which is also all that an
+  // unprivileged process is allowed to count.
+  attributes.exclude_kernel = 1;
+  attributes.exclude_hv = 1;
+  // The counts of the threads started afterwards are added to these counters
+  // when they exit.
+  attributes.inherit = 1;
+  attributes.read_format =
+      PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+  return static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, -1,
+                                  PERF_FLAG_FD_CLOEXEC));
+}
+
+// Rate of 'count' per KB of 'byte_count', or '-' when it was not counted.
+std::string FormatPerKilobyte(const PerfCounterValues &values,
+                              PerfEvent perf_event, std::size_t byte_count) {
+  if (!values.IsAvailable(perf_event) || byte_count == 0) {
+    return "-";
+  }
+
+  return std::format("{:.2f}", static_cast<double>(values.Get(perf_event)) *
+                                   1024 / static_cast<double>(byte_count));
+}
+
+std::string FormatCount(const PerfCounterValues &values,
+                        PerfEvent perf_event) {
+  if (!values.IsAvailable(perf_event)) {
+    return "-";
+  }
+
+  return std::format("{}", values.Get(perf_event));
+}
+
+void AppendPerfCounterRow(std::string &output, std::string_view row_name,
+                          const PerfCounterValues &values,
+                          std::size_t byte_count) {
+  std::string instructions_per_cycle = "-";
+  if (values.IsAvailable(PerfEvent::kCycles) &&
+      values.IsAvailable(PerfEvent::kInstructions) &&
+      values.Get(PerfEvent::kCycles) != 0) {
+    instructions_per_cycle = std::format(
+        "{:.2f}", static_cast<double>(values.Get(PerfEvent::kInstructions)) /
+                      static_cast<double>(values.Get(PerfEvent::kCycles)));
+  }
+
+  std::format_to(std::back_inserter(output),
+                 "  {:<12} {:>14} {:>14} {:>6} {:>14} {:>14} {:>14} {:>14}\n",
+                 row_name, FormatCount(values, PerfEvent::kCycles),
+                 FormatCount(values, PerfEvent::kInstructions),
+                 instructions_per_cycle,
+                 FormatPerKilobyte(values, PerfEvent::kBranchMisses,
+                                   byte_count),
+                 FormatPerKilobyte(values, PerfEvent::kL1dMisses, byte_count),
+                 FormatPerKilobyte(values, PerfEvent::kLlcMisses, byte_count),
+                 FormatPerKilobyte(values, PerfEvent::kPageFaults,
+                                   byte_count));
+
+  return;
+}
+
+} // namespace
+
+std::string_view GetPerfEventName(PerfEvent perf_event) {
+  return kPerfEventDescriptions[static_cast<std::size_t>(perf_event)].name;
+}
+
+std::uint64_t PerfCounterValues::Get(PerfEvent perf_event) const {
+  return counts[static_cast<std::size_t>(perf_event)];
+}
+
+bool PerfCounterValues::IsAvailable(PerfEvent perf_event) const {
+  return is_available[static_cast<std::size_t>(perf_event)];
+}
+
+PerfCounterValues &
+PerfCounterValues::operator+=(const PerfCounterValues &other) {
+  for (std::size_t i = 0; i < kPerfEventCount; i++) {
+    counts[i] += other.counts[i];
+    is_available[i] = is_available[i] && other.is_available[i];
+  }
+
+  return *this;
+}
+
+PerfCounters::PerfCounters() {
+  for (std::size_t i = 0; i < kPerfEventCount; i++) {
+    file_descriptors_[i] = OpenPerfEvent(kPerfEventDescriptions[i]);
+    open_errors_[i] = file_descriptors_[i] == -1 ? errno : 0;
+  }
+}
+
+PerfCounters::~PerfCounters() {
+  for (int file_descriptor : file_descriptors_) {
+    if (file_descriptor != -1) {
+      close(file_descriptor);
+    }
+  }
+}
+
+bool PerfCounters::HasAnyEvent() const {
+  return std::ranges::any_of(file_descriptors_, [](int file_descriptor) {
+    return file_descriptor != -1;
+  });
+}
+
+std::string PerfCounters::DescribeUnavailableEvents() const {
+  std::string description;
+  for (std::size_t i = 0; i < kPerfEventCount; i++) {
+    if (file_descriptors_[i] == -1) {
+      std::format_to(std::back_inserter(description), "{}{} ({})",
+                     description.empty() ? "" : ", ",
+                     kPerfEventDescriptions[i].name,
+                     std::strerror(open_errors_[i]));
+    }
+  }
+
+  return description;
+}
+
+PerfCounterValues PerfCounters::Read() const {
+  PerfCounterValues values;
+  for (std::size_t i = 0; i < kPerfEventCount; i++) {
+    // The count, followed by the times the counter was enabled and running.
+    std::array<std::uint64_t, 3> read_values{};
+    if (file_descriptors_[i] == -1 ||
+        read(file_descriptors_[i], read_values.data(), sizeof(read_values)) !=
+            static_cast<ssize_t>(sizeof(read_values))) {
+      continue;
+    }
+
+    auto [count, time_enabled, time_running] = read_values;
+    if (time_running != 0 && time_running < time_enabled) {
+      count = static_cast<std::uint64_t>(static_cast<double>(count) *
+                                         static_cast<double>(time_enabled) /
+                                         static_cast<double>(time_running));
+    }
+    values.counts[i] = count;
+    values.is_available[i] = true;
+  }
+
+  return values;
+}
+
+const PerfCounters *GetThreadPerfCounters() {
+  thread_local std::unique_ptr<PerfCounters> perf_counters =
+      std::make_unique<PerfCounters>();
+
+  return perf_counters->HasAnyEvent() ? perf_counters.get() : nullptr;
+}
+
+void PerfCounterReport::AddPhaseCounters(std::string_view phase_name,
+                                         const PerfCounterValues &values) {
+  auto it = std::ranges::find(phase_counters_, phase_name,
+                              &PhasePerfCounters::phase_name);
+  if (it == phase_counters_.end()) {
+    phase_counters_.push_back(
+        PhasePerfCounters{std::string{phase_name}, values});
+  } else {
+    it->values += values;
+  }
+
+  return;
+}
+
+void PerfCounterReport::Merge(const PerfCounterReport &other) {
+  for (const PhasePerfCounters &phase_counters : other.phase_counters_) {
+    AddPhaseCounters(phase_counters.phase_name, phase_counters.values);
+  }
+  byte_count_ += other.byte_count_;
+
+  return;
+}
+
+const std::vector<PhasePerfCounters> &
+PerfCounterReport::GetPhaseCounters() const {
+  return phase_counters_;
+}
+
+std::size_t PerfCounterReport::GetByteCount() const { return byte_count_; }
+
+void PerfCounterReport::SetByteCount(std::size_t byte_count) {
+  byte_count_ = byte_count;
+
+  return;
+}
+
+PerfCounterScope::PerfCounterScope(PerfCounterReport *perf_counter_report,
+                                   std::string_view phase_name)
+    : perf_counter_report_{perf_counter_report}, phase_name_{phase_name} {
+  if (perf_counter_report_ != nullptr) {
+    perf_counters_ = GetThreadPerfCounters();
+  }
+  if (perf_counters_ != nullptr) {
+    start_ = perf_counters_->Read();
+  }
+}
+
+PerfCounterScope::~PerfCounterScope() {
+  if (perf_counters_ == nullptr) {
+    return;
+  }
+
+  PerfCounterValues values = perf_counters_->Read();
+  for (std::size_t i = 0; i < kPerfEventCount; i++) {
+    values.counts[i] -= std::min(values.counts[i], start_.counts[i]);
+    values.is_available[i] = values.is_available[i] && start_.is_available[i];
+  }
+  perf_counter_report_->AddPhaseCounters(phase_name_, values);
+}
+
+std::string
+FormatPerfCounterReport(std::string_view title,
+                        const PerfCounterReport &perf_counter_report) {
+  std::string output = std::format(
+      "===-- Performance counters for {} --===\n"
+      "  {} bytes, misses and page faults per KB of source code\n"
+      "  {:<12} {:>14} {:>14} {:>6} {:>14} {:>14} {:>14} {:>14}\n",
+      title, perf_counter_report.GetByteCount(), "phase", "cycles",
+      "instructions", "IPC", "branch-misses", "L1D-misses", "LLC-misses",
+      "page-faults");
+
+  PerfCounterValues total;
+  total.is_available.fill(true);
+  for (const PhasePerfCounters &phase_counters :
+       perf_counter_report.GetPhaseCounters()) {
+    AppendPerfCounterRow(output, phase_counters.phase_name,
+                         phase_counters.values,
+                         perf_counter_report.GetByteCount());
+    total += phase_counters.values;
+  }
+  if (perf_counter_report.GetPhaseCounters().empty()) {
+    total.is_available.fill(false);
+  }
+  AppendPerfCounterRow(output, "total", total,
+                       perf_counter_report.GetByteCount());
+
+  return output;
+}
@@ -0,0 +1,742 @@
+#include "senbonzakura/program_generator.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Indentation stops growing past this depth, so that deeply nested programs
+// are not dominated by leading spaces.
+constexpr std::size_t kMaxIndentationDepth = 32;
+
+// Printable characters used in string and character literals. Quotes and
+// backslashes are produced as escapes instead.
+constexpr std::string_view kLiteralCharacters =
+    "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789 .,;:!?-+*/"
+    "=<>()[]{}_#@$%&|~^";
+
+constexpr std::string_view kEscapes[] = {"\\n", "\\\\", "\\'", "\\\"",
+                                         "\\x{41}", "\\x{7e}", "\\x{0A}"};
+
+constexpr std::string_view kArithmeticOperators[] = {"+", "-", "*", "*>>"};
+constexpr std::string_view kComparisonOperators[] = {"<", "<=", ">", ">=",
+                                                     "==", "!="};
+
+} // namespace
+
+ProgramGenerator::ProgramGenerator(ProgramGeneratorOptions options)
+    : options_{std::move(options)}, random_state_{options_.seed} {}
+
+std::string ProgramGenerator::Generate() {
+  output_.clear();
+  name_counter_ = 0;
+  callable_functions_.clear();
+  statement_function_indexes_.clear();
+  pair_function_indexes_.clear();
+  for (std::vector<std::size_t> &indexes : function_indexes_by_return_type_) {
+    indexes.clear();
+  }
+  variables_.clear();
+  random_state_ = options_.seed;
+
+  output_ += std::format("// Generated by senbonzakura_gen with seed {}.\n",
+                         options_.seed);
+  GenerateImports();
+  GenerateGlobals();
+
+  for (std::size_t index = 0;
+       index < options_.function_count ||
+       (options_.target_size != 0 && output_.size() < options_.target_size);
+       index++) {
+    Function function = GenerateSignature(index);
+    GenerateFunction(function);
+    AddCallableFunction(std::move(function));
+  }
+
+  if (options_.pathological) {
+    GeneratePathologicalFunctions();
+  }
+  GenerateMain();
+
+  return std::move(output_);
+}
+
+std::uint64_t ProgramGenerator::NextRandom() {
+  random_state_ += 0x9E3779B97F4A7C15;
+  std::uint64_t value = random_state_;
+  value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9;
+  value = (value ^ (value >> 27)) * 0x94D049BB133111EB;
+
+  return value ^ (value >> 31);
+}
+
+std::size_t ProgramGenerator::RandomBelow(std::size_t bound) {
+  return bound == 0 ? 0 : static_cast<std::size_t>(NextRandom() % bound);
+}
+
+bool ProgramGenerator::RandomChance(double probability) {
+  return static_cast<double>(NextRandom() >> 11) * 0x1.0p-53 < probability;
+}
+
+const char *ProgramGenerator::GetTypeName(Type type) {
+  switch (type) {
+  case (Type::kInt):
+    return "int";
+  case (Type::kBool):
+    return "bool";
+  case (Type::kIntArray):
+    return "int[]";
+  case (Type::kIntMatrix):
+    return "int[][]";
+  }
+
+  return "int";
+}
+
+ProgramGenerator::Type ProgramGenerator::RandomValueType() {
+  if (RandomChance(options_.array_usage)) {
+    return Type::kIntArray;
+  }
+
+  return RandomChance(0.7) ? Type::kInt : Type::kBool;
+}
+
+std::string ProgramGenerator::FreshName(const char *prefix) {
+  // Primes are valid in identifiers, and are rare enough in real code to be
+  // worth exercising.
+  return std::format("{}{}{}", prefix, name_counter_++,
+                     RandomChance(0.1) ? "'" : "");
+}
+
+void ProgramGenerator::Indent(std::size_t depth) {
+  output_.append(2 * std::min(depth, kMaxIndentationDepth), ' ');
+
+  return;
+}
+
+void ProgramGenerator::AddCallableFunction(Function function) {
+  std::size_t index = callable_functions_.size();
+  if (function.return_types.size() <= 1) {
+    statement_function_indexes_.push_back(index);
+  }
+  if (function.return_types.size() == 1) {
+    function_indexes_by_return_type_[static_cast<std::size_t>(
+                                         function.return_types[0])]
+        .push_back(index);
+  }
+  if (function.return_types.size() == 2) {
+    pair_function_indexes_.push_back(index);
+  }
+  callable_functions_.push_back(std::move(function));
+
+  return;
+}
+
+void ProgramGenerator::GenerateImports() {
+  // Functions reading from the standard input are left out, so that the
+  // generated programs never block.
+  if (options_.import_count >= 1) {
+    output_ += "use io\n";
+    AddCallableFunction({"print", {Type::kIntArray}, {}});
+    AddCallableFunction({"println", {Type::kIntArray}, {}});
+  }
+  if (options_.import_count >= 2) {
+    output_ += "use conv;\n";
+    AddCallableFunction(
+        {"parseInt", {Type::kIntArray}, {Type::kInt, Type::kBool}});
+    AddCallableFunction({"unparseInt", {Type::kInt}, {Type::kIntArray}});
+  }
+  output_ += '\n';
+
+  return;
+}
+
+void ProgramGenerator::GenerateGlobals() {
+  // Global integers and booleans may only be initialized with literals.
+  std::size_t global_count = 1 + RandomBelow(4);
+  for (std::size_t i = 0; i < global_count; i++) {
+    Type type = RandomChance(0.6) ? Type::kInt : Type::kBool;
+    Variable global{FreshName("global_"), type};
+    output_ += std::format("{}: {} = ", global.name, GetTypeName(type));
+    if (type == Type::kInt) {
+      output_ += std::format("{}{}", RandomChance(0.3) ? "-" : "",
+                             RandomBelow(1000000));
+    } else {
+      GenerateLiteral(type);
+    }
+    output_ += '\n';
+    variables_.push_back(std::move(global));
+  }
+  output_ += '\n';
+
+  return;
+}
+
+ProgramGenerator::Function
+ProgramGenerator::GenerateSignature(std::size_t index) {
+  Function function{std::format("function_{}", index), {}, {}};
+  std::size_t parameter_count = RandomBelow(4);
+  for (std::size_t i = 0; i < parameter_count; i++) {
+    function.parameter_types.push_back(RandomValueType());
+  }
+  // One in four functions is a procedure, and a few return two values.
+  std::size_t return_count = RandomChance(0.25) ? 0 : RandomChance(0.2) ? 2 : 1;
+  for (std::size_t i = 0; i < return_count; i++) {
+    function.return_types.push_back(RandomValueType());
+  }
+
+  return function;
+}
+
+void ProgramGenerator::GenerateFunction(const Function &function) {
+  std::size_t global_count = variables_.size();
+
+  output_ += function.name;
+  output_ += '(';
+  for (std::size_t i = 0; i < function.parameter_types.size(); i++) {
+    Variable parameter{FreshName("param_"), function.parameter_types[i]};
+    output_ += std::format("{}{}: {}", i == 0 ? "" : ", ", parameter.name,
+                           GetTypeName(parameter.type));
+    variables_.push_back(std::move(parameter));
+  }
+  output_ += ')';
+  for (std::size_t i = 0; i < function.return_types.size(); i++) {
+    output_ += i == 0 ? ": " : ", ";
+    output_ += GetTypeName(function.return_types[i]);
+  }
+  output_ += " {\n";
+
+  GenerateBlock(1, options_.statements_per_function);
+  GenerateReturn(function, 1);
+  output_ += "}\n\n";
+
+  variables_.resize(global_count);
+
+  return;
+}
+
+void ProgramGenerator::GenerateMain() {
+  std::size_t global_count = variables_.size();
+  variables_.push_back({"args", Type::kIntMatrix, false});
+
+  output_ += "main(args: int[][]) {\n";
+  GenerateBlock(1, options_.statements_per_function);
+  // Every function is called once, so that none of them is dead code.
+  for (const Function &function : callable_functions_) {
+    if (function.name.starts_with("function_") ||
+        function.name.starts_with("pathological_")) {
+      Indent(1);
+      output_ += function.return_types.empty()         ? ""
+                 : function.return_types.size() == 1 ? "_ = "
+                                                       : "_, _ = ";
+      output_ += function.name;
+      GenerateArguments(function, options_.max_expression_size / 2);
+      output_ += '\n';
+    }
+  }
+  output_ += "}\n";
+
+  variables_.resize(global_count);
+
+  return;
+}
+
+void ProgramGenerator::GenerateBlock(std::size_t depth,
+                                     std::size_t statement_count) {
+  std::size_t outer_variable_count = variables_.size();
+  for (std::size_t i = 0; i < statement_count; i++) {
+    GenerateStatement(depth);
+  }
+  variables_.resize(outer_variable_count);
+
+  return;
+}
+
+void ProgramGenerator::GenerateStatement(std::size_t depth) {
+  std::size_t kind = RandomBelow(10);
+  if (depth > options_.max_nesting_depth && (kind == 6 || kind == 7)) {
+    kind = 0;
+  }
+
+  switch (kind) {
+  case (0):
+  case (1):
+  case (2):
+    GenerateDeclaration(depth);
+    break;
+  case (3):
+  case (4):
+  case (5):
+    GenerateAssignment(depth);
+    break;
+  case (6):
+    GenerateConditional(depth);
+    break;
+  case (7):
+    GenerateLoop(depth);
+    break;
+  default:
+    GenerateCallStatement(depth);
+    break;
+  }
+
+  return;
+}
+
+void ProgramGenerator::GenerateDeclaration(std::size_t depth) {
+  Indent(depth);
+
+  // A declaration of an array with a length, which leaves its cells
+  // uninitialized, so they are assigned right away.
+  if (RandomChance(options_.array_usage / 2)) {
+    Variable array{FreshName("array_"), Type::kIntArray};
+    std::size_t length = 1 + RandomBelow(8);
+    output_ += std::format("{}: int[{}]\n", array.name, length);
+    for (std::size_t i = 0; i < length; i++) {
+      Indent(depth);
+      output_ += std::format("{}[{}] = ", array.name, i);
+      GenerateExpression(Type::kInt, options_.max_expression_size / 2);
+      output_ += RandomChance(0.2) ? ";\n" : "\n";
+    }
+    variables_.push_back(std::move(array));
+    return;
+  }
+
+  // A declaration initialized by a function returning two values.
+  if (!pair_function_indexes_.empty() && RandomChance(0.1)) {
+    const Function &function =
+        callable_functions_[pair_function_indexes_[RandomBelow(
+            pair_function_indexes_.size())]];
+    Variable first{FreshName("first_"), function.return_types[0]};
+    Variable second{FreshName("second_"), function.return_types[1]};
+    if (RandomChance(0.3)) {
+      output_ += std::format("_, {}: {} = {}", second.name,
+                             GetTypeName(second.type), function.name);
+    } else {
+      output_ += std::format("{}: {}, {}: {} = {}", first.name,
+                             GetTypeName(first.type), second.name,
+                             GetTypeName(second.type), function.name);
+      variables_.push_back(std::move(first));
+    }
+    GenerateArguments(function, options_.max_expression_size / 2);
+    output_ += '\n';
+    variables_.push_back(std::move(second));
+    return;
+  }
+
+  Variable variable{FreshName("local_"), RandomValueType()};
+  output_ += std::format("{}: {} = ", variable.name,
+                         GetTypeName(variable.type));
+  GenerateExpression(variable.type, options_.max_expression_size);
+  output_ += RandomChance(0.2) ? ";\n" : "\n";
+  variables_.push_back(std::move(variable));
+
+  return;
+}
+
+void ProgramGenerator::GenerateAssignment(std::size_t depth) {
+  Type type = RandomValueType();
+  const Variable *variable = FindVariable(type);
+  if (variable == nullptr || !variable->is_assignable) {
+    GenerateDeclaration(depth);
+    return;
+  }
+
+  Indent(depth);
+  if (type == Type::kIntArray && RandomChance(0.5)) {
+    // Assignment to an array cell.
+    output_ += std::format("{}[", variable->name);
+    GenerateExpression(Type::kInt, options_.max_expression_size / 4);
+    output_ += "] = ";
+    GenerateExpression(Type::kInt, options_.max_expression_size);
+  } else if (const Variable *other = FindVariable(type);
+             other != nullptr && other != variable && other->is_assignable &&
+             RandomChance(0.2)) {
+    // Multiple assignment, which swaps both variables.
+    output_ += std::format("{}, {} = {}, {}", variable->name, other->name,
+                           other->name, variable->name);
+  } else {
+    output_ += std::format("{} = ", variable->name);
+    GenerateExpression(type, options_.max_expression_size);
+  }
+  output_ += RandomChance(0.2) ? ";\n" : "\n";
+
+  return;
+}
+
+void ProgramGenerator::GenerateConditional(std::size_t depth) {
+  Indent(depth);
+  bool has_parentheses = RandomChance(0.5);
+  output_ += has_parentheses ? "if (" : "if ";
+  GenerateExpression(Type::kBool, options_.max_expression_size / 2);
+  output_ += has_parentheses ? ") {\n" : " {\n";
+  GenerateBlock(depth + 1, 1 + RandomBelow(4));
+  Indent(depth);
+  output_ += '}';
+
+  if (RandomChance(0.5)) {
+    output_ += " else {\n";
+    GenerateBlock(depth + 1, 1 + RandomBelow(4));
+    Indent(depth);
+    output_ += '}';
+  }
+  output_ += '\n';
+
+  return;
+}
+
+void ProgramGenerator::GenerateLoop(std::size_t depth) {
+  // Loops count up to a small bound, so that the programs terminate.
+  Variable counter{FreshName("counter_"), Type::kInt, false};
+  Indent(depth);
+  output_ += std::format("{}: int = 0\n", counter.name);
+  Indent(depth);
+  output_ += std::format("while {} < {} {{\n", counter.name,
+                         1 + RandomBelow(16));
+  variables_.push_back(counter);
+
+  GenerateBlock(depth + 1, 1 + RandomBelow(4));
+  Indent(depth + 1);
+  output_ += std::format("{0} = {0} + 1\n", counter.name);
+  Indent(depth);
+  output_ += "}\n";
+
+  return;
+}
+
+void ProgramGenerator::GenerateCallStatement(std::size_t depth) {
+  if (statement_function_indexes_.empty()) {
+    GenerateAssignment(depth);
+    return;
+  }
+
+  // Procedures are called directly, and the result of a function with a
+  // single return value is discarded through '_'.
+  const Function &function =
+      callable_functions_[statement_function_indexes_[RandomBelow(
+          statement_function_indexes_.size())]];
+  Indent(depth);
+  if (!function.return_types.empty()) {
+    output_ += "_ = ";
+  }
+  output_ += function.name;
+  GenerateArguments(function, options_.max_expression_size / 2);
+  output_ += RandomChance(0.2) ? ";\n" : "\n";
+
+  return;
+}
+
+void ProgramGenerator::GenerateReturn(const Function &function,
+                                      std::size_t depth) {
+  if (function.return_types.empty()) {
+    if (RandomChance(0.5)) {
+      Indent(depth);
+      output_ += "return\n";
+    }
+    return;
+  }
+
+  Indent(depth);
+  output_ += "return ";
+  for (std::size_t i = 0; i < function.return_types.size(); i++) {
+    if (i != 0) {
+      output_ += ", ";
+    }
+    GenerateExpression(function.return_types[i],
+                       options_.max_expression_size);
+  }
+  output_ += '\n';
+
+  return;
+}
+
+void ProgramGenerator::GenerateExpression(Type type, std::size_t budget) {
+  if (budget == 0 || RandomChance(0.25)) {
+    GenerateLeaf(type);
+    return;
+  }
+  if (RandomChance(0.15) && GenerateCall(type, budget - 1)) {
+    return;
+  }
+
+  // Compound operands are always parenthesized, so that the generated
+  // expressions never depend on the precedence rules.
+  std::size_t left_budget = RandomBelow(budget);
+  std::size_t right_budget = budget - 1 - left_budget;
+  const Variable *array =
+      type == Type::kInt ? FindVariable(Type::kIntArray) : nullptr;
+  switch (type) {
+  case (Type::kInt):
+    switch (RandomBelow(6)) {
+    case (0):
+      output_ += "-(";
+      GenerateExpression(Type::kInt, budget - 1);
+      output_ += ')';
+      break;
+    case (1):
+      // Divisors are non-zero literals.
+      output_ += '(';
+      GenerateExpression(Type::kInt, budget - 1);
+      output_ += std::format(" {} {})", RandomChance(0.5) ? "/" : "%",
+                             1 + RandomBelow(100));
+      break;
+    case (2):
+      output_ += "length(";
+      GenerateExpression(Type::kIntArray, budget - 1);
+      output_ += ')';
+      break;
+    case (3):
+      if (array != nullptr) {
+        output_ += std::format("{}[", array->name);
+        GenerateExpression(Type::kInt, budget - 1);
+        output_ += ']';
+        break;
+      }
+      output_ += "length(";
+      GenerateExpression(Type::kIntArray, budget - 1);
+      output_ += ')';
+      break;
+    default:
+      output_ += '(';
+      GenerateExpression(Type::kInt, left_budget);
+      output_ += std::format(
+          " {} ",
+          kArithmeticOperators[RandomBelow(std::size(kArithmeticOperators))]);
+      GenerateExpression(Type::kInt, right_budget);
+      output_ += ')';
+      break;
+    }
+    break;
+  case (Type::kBool):
+    switch (RandomBelow(4)) {
+    case (0):
+      output_ += "!(";
+      GenerateExpression(Type::kBool, budget - 1);
+      output_ += ')';
+      break;
+    case (1):
+      output_ += '(';
+      GenerateExpression(Type::kBool, left_budget);
+      output_ += RandomChance(0.5) ? " & " : " | ";
+      GenerateExpression(Type::kBool, right_budget);
+      output_ += ')';
+      break;
+    default:
+      output_ += '(';
+      GenerateExpression(Type::kInt, left_budget);
+      output_ += std::format(
+          " {} ",
+          kComparisonOperators[RandomBelow(std::size(kComparisonOperators))]);
+      GenerateExpression(Type::kInt, right_budget);
+      output_ += ')';
+      break;
+    }
+    break;
+  case (Type::kIntArray):
+    if (RandomChance(0.5)) {
+      output_ += '(';
+      GenerateExpression(Type::kIntArray, left_budget);
+      output_ += " + ";
+      GenerateExpression(Type::kIntArray, right_budget);
+      output_ += ')';
+    } else {
+      // Array constructor, possibly with a trailing comma.
+      std::size_t element_count = RandomBelow(4);
+      output_ += '{';
+      for (std::size_t i = 0; i < element_count; i++) {
+        if (i != 0) {
+          output_ += ", ";
+        }
+        GenerateExpression(Type::kInt, budget / (element_count + 1));
+      }
+      output_ += element_count != 0 && RandomChance(0.2) ? ",}" : "}";
+    }
+    break;
+  case (Type::kIntMatrix):
+    GenerateLeaf(type);
+    break;
+  }
+
+  return;
+}
+
+void ProgramGenerator::GenerateLeaf(Type type) {
+  const Variable *variable = nullptr;
+  if (!RandomChance(options_.literal_density)) {
+    variable = FindVariable(type);
+  }
+
+  if (variable != nullptr) {
+    output_ += variable->name;
+  } else {
+    GenerateLiteral(type);
+  }
+
+  return;
+}
+
+void ProgramGenerator::GenerateLiteral(Type type) {
+  switch (type) {
+  case (Type::kInt):
+    switch (RandomBelow(8)) {
+    case (0):
+      output_ += '\'';
+      if (RandomChance(0.3)) {
+        output_ += kEscapes[RandomBelow(std::size(kEscapes))];
+      } else {
+        char character =
+            kLiteralCharacters[RandomBelow(kLiteralCharacters.size())];
+        output_ += character;
+      }
+      output_ += '\'';
+      break;
+    case (1):
+      output_ += std::format("{}", NextRandom() >> 1);
+      break;
+    default:
+      output_ += std::format("{}", RandomBelow(1000));
+      break;
+    }
+    break;
+  case (Type::kBool):
+    output_ += RandomChance(0.5) ? "true" : "false";
+    break;
+  case (Type::kIntArray): {
+    output_ += '"';
+    std::size_t length = RandomBelow(24);
+    for (std::size_t i = 0; i < length; i++) {
+      if (RandomChance(0.1)) {
+        output_ += kEscapes[RandomBelow(std::size(kEscapes))];
+      } else {
+        output_ += kLiteralCharacters[RandomBelow(kLiteralCharacters.size())];
+      }
+    }
+    output_ += '"';
+    break;
+  }
+  case (Type::kIntMatrix):
+    output_ += "{{1, 0}, {0, 1}}";
+    break;
+  }
+
+  return;
+}
+
+bool ProgramGenerator::GenerateCall(Type type, std::size_t budget) {
+  const std::vector<std::size_t> &indexes =
+      function_indexes_by_return_type_[static_cast<std::size_t>(type)];
+  if (indexes.empty()) {
+    return false;
+  }
+
+  const Function &function =
+      callable_functions_[indexes[RandomBelow(indexes.size())]];
+  output_ += function.name;
+  GenerateArguments(function, budget);
+
+  return true;
+}
+
+void ProgramGenerator::GenerateArguments(const Function &function,
+                                         std::size_t budget) {
+  output_ += '(';
+  for (std::size_t i = 0; i < function.parameter_types.size(); i++) {
+    if (i != 0) {
+      output_ += ", ";
+    }
+    GenerateExpression(function.parameter_types[i],
+                       budget / function.parameter_types.size());
+  }
+  output_ += ')';
+
+  return;
+}
+
+const ProgramGenerator::Variable *ProgramGenerator::FindVariable(Type type) {
+  std::size_t match_count = 0;
+  for (const Variable &variable : variables_) {
+    match_count += variable.type == type;
+  }
+  if (match_count == 0) {
+    return nullptr;
+  }
+
+  std::size_t chosen = RandomBelow(match_count);
+  for (const Variable &variable : variables_) {
+    if (variable.type == type && chosen-- == 0) {
+      return &variable;
+    }
+  }
+
+  return nullptr;
+}
+
+void ProgramGenerator::GeneratePathologicalFunctions() {
+  std::size_t scale = std::max<std::size_t>(options_.pathological_scale, 1);
+
+  // Blocks nested 'scale' levels deep.
+  output_ += "pathological_nesting(x: int): int {\n";
+  for (std::size_t depth = 1; depth <= scale; depth++) {
+    Indent(depth);
+    output_ += depth % 2 == 0 ? std::format("if x > {} {{\n", depth)
+                              : std::format("if x != {} {{\n", depth);
+  }
+  Indent(scale + 1);
+  output_ += "x = x + 1\n";
+  for (std::size_t depth = scale; depth >= 1; depth--) {
+    Indent(depth);
+    output_ += "}\n";
+  }
+  output_ += "  return x\n}\n\n";
+  AddCallableFunction({"pathological_nesting", {Type::kInt}, {Type::kInt}});
+
+  // Parentheses nested 'scale' levels deep, and a single line holding an
+  // expression with 'scale * 10' operands.
+  output_ += "pathological_expressions(x: int): int, bool {\n  y: int = ";
+  output_.append(scale, '(');
+  output_ += 'x';
+  output_.append(scale, ')');
+  output_ += "\n  return x";
+  for (std::size_t i = 0; i < scale * 10; i++) {
+    output_ += std::format(" {} {}", kArithmeticOperators[i % 3], i % 997 + 1);
+  }
+  output_ += ", y < x";
+  for (std::size_t i = 0; i < scale * 10; i++) {
+    output_ += i % 2 == 0 ? " & y < x" : " | !(x == y)";
+  }
+  output_ += "\n}\n\n";
+  AddCallableFunction({"pathological_expressions",
+                                 {Type::kInt},
+                                 {Type::kInt, Type::kBool}});
+
+  // Huge literals and identifiers, each one on a single line.
+  std::string long_name = "pathological_identifier_";
+  long_name.append(scale, 'x');
+  output_ += "pathological_literals(): int[] {\n  ";
+  output_ += long_name;
+  output_ += ": int[] = \"";
+  for (std::size_t i = 0; i < scale * 500; i++) {
+    if (i % 50 == 49) {
+      output_ += kEscapes[(i / 50) % std::size(kEscapes)];
+    } else {
+      output_ += kLiteralCharacters[i % kLiteralCharacters.size()];
+    }
+  }
+  output_ += "\"\n  numbers: int[] = {";
+  for (std::size_t i = 0; i < scale * 50; i++) {
+    output_ += i % 10 == 0 ? "9223372036854775807, " : "1234567890, ";
+  }
+  output_ += "}\n  return ";
+  output_ += long_name;
+  output_ += " + numbers\n}\n\n";
+  AddCallableFunction({"pathological_literals", {}, {Type::kIntArray}});
+
+  return;
+}
@@ -0,0 +1,284 @@
+#include "senbonzakura/simd_scanner.hpp"
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+#include "senbonzakura/lexer_tables.hpp"
+
+#if defined(__x86_64__)
+#define SENBONZAKURA_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// Scalar implementations. They are also used to finish the last few bytes of
+// a buffer, which are too few to fill a whole vector register. Identifier
+// characters are looked up in the same table as the lexer uses.
+
+bool IsWhitespace(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+bool IsDigit(char c) { return c >= '0' && c <= '9'; }
+
+std::size_t FindNewlineScalar(const char *data, std::size_t position,
+                              std::size_t end) {
+  const void *newline = std::memchr(data + position, '\n', end - position);
+
+  return newline != nullptr ? static_cast<const char *>(newline) - data : end;
+}
+
+std::size_t SkipWhitespaceScalar(const char *data, std::size_t position,
+                                 std::size_t end) {
+  while (position < end &&
+         (data[position] == '\n' || IsWhitespace(data[position]))) {
+    position++;
+  }
+
+  return position;
+}
+
+std::size_t SkipIdentifierPartScalar(const char *data, std::size_t position,
+                                     std::size_t end) {
+  while (position < end &&
+         kIdentifierPartTable[static_cast<unsigned char>(data[position])]) {
+    position++;
+  }
+
+  return position;
+}
+
+std::size_t SkipDigitsScalar(const char *data, std::size_t position,
+                             std::size_t end) {
+  while (position < end && IsDigit(data[position])) {
+    position++;
+  }
+
+  return position;
+}
+
+#ifdef SENBONZAKURA_SIMD_X86
+
+// SSE2 implementations, processing 16 bytes at a time. SSE2 only has signed
+// byte comparisons, which conveniently rejects every byte above 0x7F.
+
+__m128i InRangeSse2(__m128i chunk, char low, char high) {
+  return _mm_and_si128(_mm_cmpgt_epi8(chunk, _mm_set1_epi8(low - 1)),
+                       _mm_cmplt_epi8(chunk, _mm_set1_epi8(high + 1)));
+}
+
+std::size_t FindNewlineSse2(const char *data, std::size_t position,
+                            std::size_t end) {
+  const __m128i newline = _mm_set1_epi8('\n');
+  for (; position + 16 <= end; position += 16) {
+    __m128i chunk =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + position));
+    unsigned int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, newline));
+    if (mask != 0) {
+      return position + std::countr_zero(mask);
+    }
+  }
+
+  return FindNewlineScalar(data, position, end);
+}
+
+std::size_t SkipWhitespaceSse2(const char *data, std::size_t position,
+                               std::size_t end) {
+  for (; position + 16 <= end; position += 16) {
+    __m128i chunk =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + position));
+    __m128i whitespace = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(' ')),
+                     _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\t'))),
+        _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('\r')),
+                     _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\n'))));
+    unsigned int stop_mask = ~_mm_movemask_epi8(whitespace) & 0xFFFF;
+    if (stop_mask != 0) {
+      return position + std::countr_zero(stop_mask);
+    }
+  }
+
+  return SkipWhitespaceScalar(data, position, end);
+}
+
+std::size_t SkipIdentifierPartSse2(const char *data, std::size_t position,
+                                   std::size_t end) {
+  for (; position + 16 <= end; position += 16) {
+    __m128i chunk =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + position));
+    __m128i lower = _mm_or_si128(chunk, _mm_set1_epi8(0x20));
+    __m128i part = _mm_or_si128(
+        _mm_or_si128(InRangeSse2(lower, 'a', 'z'),
+                     InRangeSse2(chunk, '0', '9')),
+        _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('_')),
+                     _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\''))));
+    unsigned int stop_mask = ~_mm_movemask_epi8(part) & 0xFFFF;
+    if (stop_mask != 0) {
+      return position + std::countr_zero(stop_mask);
+    }
+  }
+
+  return SkipIdentifierPartScalar(data, position, end);
+}
+
+std::size_t SkipDigitsSse2(const char *data, std::size_t position,
+                           std::size_t end) {
+  for (; position + 16 <= end; position += 16) {
+    __m128i chunk =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + position));
+    unsigned int stop_mask =
+        ~_mm_movemask_epi8(InRangeSse2(chunk, '0', '9')) & 0xFFFF;
+    if (stop_mask != 0) {
+      return position + std::countr_zero(stop_mask);
+    }
+  }
+
+  return SkipDigitsScalar(data, position, end);
+}
+
+// AVX2 implementations, processing 32 bytes at a time. They are compiled for
+// AVX2 regardless of the global compiler flags and only called after the CPU
+// has been checked.
+
+#define SENBONZAKURA_TARGET_AVX2 __attribute__((target("avx2")))
+
+SENBONZAKURA_TARGET_AVX2 __m256i InRangeAvx2(__m256i chunk, char low,
+                                             char high) {
+  return _mm256_and_si256(
+      _mm256_cmpgt_epi8(chunk, _mm256_set1_epi8(low - 1)),
+      _mm256_cmpgt_epi8(_mm256_set1_epi8(high + 1), chunk));
+}
+
+SENBONZAKURA_TARGET_AVX2 std::size_t
+FindNewlineAvx2(const char *data, std::size_t position, std::size_t end) {
+  const __m256i newline = _mm256_set1_epi8('\n');
+  for (; position + 32 <= end; position += 32) {
+    __m256i chunk =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + position));
+    auto mask = static_cast<std::uint32_t>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, newline)));
+    if (mask != 0) {
+      return position + std::countr_zero(mask);
+    }
+  }
+
+  return FindNewlineSse2(data, position, end);
+}
+
+SENBONZAKURA_TARGET_AVX2 std::size_t
+SkipWhitespaceAvx2(const char *data, std::size_t position, std::size_t end) {
+  for (; position + 32 <= end; position += 32) {
+    __m256i chunk =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + position));
+    __m256i whitespace = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(' ')),
+                        _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\t'))),
+        _mm256_or_si256(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\r')),
+                        _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\n'))));
+    auto stop_mask =
+        ~static_cast<std::uint32_t>(_mm256_movemask_epi8(whitespace));
+    if (stop_mask != 0) {
+      return position + std::countr_zero(stop_mask);
+    }
+  }
+
+  return SkipWhitespaceSse2(data, position, end);
+}
+
+SENBONZAKURA_TARGET_AVX2 std::size_t
+SkipIdentifierPartAvx2(const char *data, std::size_t position,
+                       std::size_t end) {
+  for (; position + 32 <= end; position += 32) {
+    __m256i chunk =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + position));
+    __m256i lower = _mm256_or_si256(chunk, _mm256_set1_epi8(0x20));
+    __m256i part = _mm256_or_si256(
+        _mm256_or_si256(InRangeAvx2(lower, 'a', 'z'),
+                        InRangeAvx2(chunk, '0', '9')),
+        _mm256_or_si256(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('_')),
+                        _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\''))));
+    auto stop_mask = ~static_cast<std::uint32_t>(_mm256_movemask_epi8(part));
+    if (stop_mask != 0) {
+      return position + std::countr_zero(stop_mask);
+    }
+  }
+
+  return SkipIdentifierPartSse2(data, position, end);
+}
+
+SENBONZAKURA_TARGET_AVX2 std::size_t
+SkipDigitsAvx2(const char *data, std::size_t position, std::size_t end) {
+  for (; position + 32 <= end; position += 32) {
+    __m256i chunk =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + position));
+    auto stop_mask = ~static_cast<std::uint32_t>(
+        _mm256_movemask_epi8(InRangeAvx2(chunk, '0', '9')));
+    if (stop_mask != 0) {
+      return position + std::countr_zero(stop_mask);
+    }
+  }
+
+  return SkipDigitsSse2(data, position, end);
+}
+
+#endif
+
+const SimdScanner kScalarScanner{
+    .level = SimdLevel::kScalar,
+    .find_newline = FindNewlineScalar,
+    .skip_whitespace = SkipWhitespaceScalar,
+    .skip_identifier_part = SkipIdentifierPartScalar,
+    .skip_digits = SkipDigitsScalar,
+};
+
+#ifdef SENBONZAKURA_SIMD_X86
+const SimdScanner kSse2Scanner{
+    .level = SimdLevel::kSse2,
+    .find_newline = FindNewlineSse2,
+    .skip_whitespace = SkipWhitespaceSse2,
+    .skip_identifier_part = SkipIdentifierPartSse2,
+    .skip_digits = SkipDigitsSse2,
+};
+
+const SimdScanner kAvx2Scanner{
+    .level = SimdLevel::kAvx2,
+    .find_newline = FindNewlineAvx2,
+    .skip_whitespace = SkipWhitespaceAvx2,
+    .skip_identifier_part = SkipIdentifierPartAvx2,
+    .skip_digits = SkipDigitsAvx2,
+};
+#endif
+
+} // namespace
+
+SimdLevel GetSupportedSimdLevel() {
+#ifdef SENBONZAKURA_SIMD_X86
+  static const SimdLevel supported_level = __builtin_cpu_supports("avx2")
+                                               ? SimdLevel::kAvx2
+                                               : SimdLevel::kSse2;
+  return supported_level;
+#else
+  return SimdLevel::kScalar;
+#endif
+}
+
+const SimdScanner &GetSimdScanner() {
+  return GetSimdScanner(GetSupportedSimdLevel());
+}
+
+const SimdScanner &GetSimdScanner(SimdLevel level) {
+  if (level > GetSupportedSimdLevel()) {
+    level = GetSupportedSimdLevel();
+  }
+
+  switch (level) {
+#ifdef SENBONZAKURA_SIMD_X86
+  case (SimdLevel::kAvx2):
+    return kAvx2Scanner;
+  case (SimdLevel::kSse2):
+    return kSse2Scanner;
+#endif
+  default:
+    return kScalarScanner;
+  }
+}
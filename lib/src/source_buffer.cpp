@@ -0,0 +1,142 @@
+#include "senbonzakura/source_buffer.hpp"
+
+#include <cerrno>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+SourceBuffer::SourceBuffer(SourceBuffer &&other) noexcept
+    : mapping_(std::exchange(other.mapping_, nullptr)),
+      mapping_size_(std::exchange(other.mapping_size_, 0)),
+      size_(std::exchange(other.size_, 0)),
+      content_(std::move(other.content_)) {
+  other.content_.clear();
+}
+
+SourceBuffer &SourceBuffer::operator=(SourceBuffer &&other) noexcept {
+  if (this != &other) {
+    Release();
+    mapping_ = std::exchange(other.mapping_, nullptr);
+    mapping_size_ = std::exchange(other.mapping_size_, 0);
+    size_ = std::exchange(other.size_, 0);
+    content_ = std::move(other.content_);
+    other.content_.clear();
+  }
+
+  return *this;
+}
+
+SourceBuffer::~SourceBuffer() { Release(); }
+
+bool SourceBuffer::Load(const std::string &file_path) {
+  Release();
+
+  int file_descriptor = open(file_path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (file_descriptor < 0) {
+    return false;
+  }
+
+  struct stat file_status {};
+  bool loaded = false;
+  if (fstat(file_descriptor, &file_status) == 0 &&
+      S_ISREG(file_status.st_mode) && file_status.st_size > 0) {
+    loaded = MapFile(file_descriptor,
+                     static_cast<std::size_t>(file_status.st_size));
+  }
+  if (!loaded) {
+    loaded = ReadFile(file_descriptor);
+  }
+  close(file_descriptor);
+
+  return loaded;
+}
+
+const char *SourceBuffer::Data() const {
+  return mapping_ != nullptr ? mapping_ : content_.c_str();
+}
+
+bool SourceBuffer::IsMapped() const { return mapping_ != nullptr; }
+
+std::size_t SourceBuffer::Size() const { return size_; }
+
+std::string_view SourceBuffer::View() const {
+  return std::string_view{Data(), size_};
+}
+
+bool SourceBuffer::MapFile(int file_descriptor, std::size_t file_size) {
+  // The bytes of the last page that lie past the end of the file are zeroed
+  // by the kernel, which provides the '\0' sentinel for free. When the file
+  // size is a multiple of the page size there is no such slack, so one extra
+  // anonymous page is reserved first and the file is mapped over its start.
+  std::size_t page_size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+  std::size_t file_pages_size = (file_size + page_size - 1) / page_size *
+                                page_size;
+  std::size_t mapping_size =
+      file_pages_size == file_size ? file_size + page_size : file_pages_size;
+
+  void *reservation = mmap(nullptr, mapping_size, PROT_READ,
+                           MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (reservation == MAP_FAILED) {
+    return false;
+  }
+
+  void *mapping = mmap(reservation, file_size, PROT_READ,
+                       MAP_PRIVATE | MAP_FIXED, file_descriptor, 0);
+  if (mapping == MAP_FAILED) {
+    munmap(reservation, mapping_size);
+    return false;
+  }
+  madvise(mapping, file_size, MADV_SEQUENTIAL);
+
+  mapping_ = static_cast<char *>(mapping);
+  mapping_size_ = mapping_size;
+  size_ = file_size;
+
+  return true;
+}
+
+bool SourceBuffer::ReadFile(int file_descriptor) {
+  constexpr std::size_t kChunkSize = 64 * 1024;
+
+  content_.clear();
+  while (true) {
+    std::size_t old_size = content_.size();
+    content_.resize(old_size + kChunkSize);
+    ssize_t bytes_read = read(file_descriptor, content_.data() + old_size,
+                              kChunkSize);
+    if (bytes_read < 0 && errno == EINTR) {
+      content_.resize(old_size);
+      continue;
+    }
+    if (bytes_read <= 0) {
+      content_.resize(old_size);
+      if (bytes_read < 0) {
+        content_.clear();
+        return false;
+      }
+      break;
+    }
+    content_.resize(old_size + static_cast<std::size_t>(bytes_read));
+  }
+  size_ = content_.size();
+
+  return true;
+}
+
+void SourceBuffer::Release() {
+  if (mapping_ != nullptr) {
+    munmap(mapping_, mapping_size_);
+    mapping_ = nullptr;
+    mapping_size_ = 0;
+  }
+  content_.clear();
+  size_ = 0;
+
+  return;
+}
@@ -0,0 +1,169 @@
+#include "senbonzakura/string_interner.hpp"
+
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string_view>
+#include <utility>
+
+StringInterner::StringInterner() {
+  for (Shard &shard : shards_) {
+    shard.slots.resize(64);
+  }
+}
+
+Symbol StringInterner::Intern(std::string_view string) {
+  std::uint64_t hash = Hash(string);
+  std::size_t shard_index = hash & (kShardCount - 1);
+  Shard &shard = shards_[shard_index];
+  std::uint32_t slot_hash = static_cast<std::uint32_t>(hash >> 32);
+
+  {
+    std::shared_lock lock{shard.mutex};
+    std::uint32_t index = FindIndex(shard, string, slot_hash);
+    if (index != 0) {
+      return Symbol{static_cast<std::uint32_t>(index << kShardBits |
+                                               shard_index)};
+    }
+  }
+
+  std::unique_lock lock{shard.mutex};
+  // Another thread may have interned the same string between both locks.
+  std::uint32_t index = FindIndex(shard, string, slot_hash);
+  if (index == 0) {
+    if ((shard.strings.size() + 1) * 2 > shard.slots.size()) {
+      Grow(shard);
+    }
+    shard.strings.push_back(Store(shard, string));
+    index = static_cast<std::uint32_t>(shard.strings.size());
+
+    std::size_t mask = shard.slots.size() - 1;
+    std::size_t position = slot_hash & mask;
+    while (shard.slots[position].index != 0) {
+      position = (position + 1) & mask;
+    }
+    shard.slots[position] = Slot{slot_hash, index};
+  }
+
+  return Symbol{static_cast<std::uint32_t>(index << kShardBits | shard_index)};
+}
+
+Symbol StringInterner::Find(std::string_view string) const {
+  std::uint64_t hash = Hash(string);
+  std::size_t shard_index = hash & (kShardCount - 1);
+  const Shard &shard = shards_[shard_index];
+
+  std::shared_lock lock{shard.mutex};
+  std::uint32_t index =
+      FindIndex(shard, string, static_cast<std::uint32_t>(hash >> 32));
+  if (index == 0) {
+    return Symbol{};
+  }
+
+  return Symbol{static_cast<std::uint32_t>(index << kShardBits | shard_index)};
+}
+
+std::string_view StringInterner::GetString(Symbol symbol) const {
+  if (!symbol.IsValid()) {
+    return {};
+  }
+  const Shard &shard = shards_[symbol.id & (kShardCount - 1)];
+
+  std::shared_lock lock{shard.mutex};
+  return shard.strings[(symbol.id >> kShardBits) - 1];
+}
+
+std::size_t StringInterner::GetSize() const {
+  std::size_t size = 0;
+  for (const Shard &shard : shards_) {
+    std::shared_lock lock{shard.mutex};
+    size += shard.strings.size();
+  }
+
+  return size;
+}
+
+std::uint64_t StringInterner::Hash(std::string_view string) {
+  // Mixes eight bytes at a time, with a final partial word for the tail.
+  constexpr std::uint64_t kMultiplier = 0x9e3779b97f4a7c15;
+  std::uint64_t hash = string.length() * kMultiplier;
+  std::size_t position = 0;
+  for (; position + 8 <= string.length(); position += 8) {
+    std::uint64_t word;
+    std::memcpy(&word, string.data() + position, 8);
+    hash = (hash ^ word) * kMultiplier;
+    hash ^= hash >> 29;
+  }
+  if (position < string.length()) {
+    std::uint64_t word = 0;
+    std::memcpy(&word, string.data() + position, string.length() - position);
+    hash = (hash ^ word) * kMultiplier;
+    hash ^= hash >> 29;
+  }
+
+  return hash ^ (hash >> 32);
+}
+
+std::uint32_t StringInterner::FindIndex(const Shard &shard,
+                                        std::string_view string,
+                                        std::uint32_t hash) {
+  std::size_t mask = shard.slots.size() - 1;
+  for (std::size_t position = hash & mask;; position = (position + 1) & mask) {
+    const Slot &slot = shard.slots[position];
+    if (slot.index == 0) {
+      return 0;
+    }
+    if (slot.hash == hash && shard.strings[slot.index - 1] == string) {
+      return slot.index;
+    }
+  }
+}
+
+std::string_view StringInterner::Store(Shard &shard, std::string_view string) {
+  if (string.empty()) {
+    return std::string_view{};
+  }
+  // Long strings get a chunk of their own, so that they do not waste the rest
+  // of the current one.
+  if (string.length() > kChunkSize / 4) {
+    shard.chunks.push_back(std::make_unique<char[]>(string.length()));
+    std::memcpy(shard.chunks.back().get(), string.data(), string.length());
+    return std::string_view{shard.chunks.back().get(), string.length()};
+  }
+  if (shard.chunk_used + string.length() > kChunkSize) {
+    shard.chunks.push_back(std::make_unique<char[]>(kChunkSize));
+    shard.current_chunk = shard.chunks.back().get();
+    shard.chunk_used = 0;
+  }
+
+  char *destination = shard.current_chunk + shard.chunk_used;
+  std::memcpy(destination, string.data(), string.length());
+  shard.chunk_used += string.length();
+
+  return std::string_view{destination, string.length()};
+}
+
+void StringInterner::Grow(Shard &shard) {
+  std::vector<Slot> slots(shard.slots.size() * 2);
+  std::size_t mask = slots.size() - 1;
+  for (const Slot &slot : shard.slots) {
+    if (slot.index == 0) {
+      continue;
+    }
+    std::size_t position = slot.hash & mask;
+    while (slots[position].index != 0) {
+      position = (position + 1) & mask;
+    }
+    slots[position] = slot;
+  }
+  shard.slots = std::move(slots);
+
+  return;
+}
+
+StringInterner &GetStringInterner() {
+  static StringInterner string_interner;
+
+  return string_interner;
+}
@@ -0,0 +1,45 @@
+#include "senbonzakura/thread_pool.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <utility>
+
+ThreadPool::ThreadPool(std::size_t thread_count) {
+  thread_count = std::max<std::size_t>(thread_count, 1);
+  workers_.reserve(thread_count);
+  for (std::size_t i = 0; i < thread_count; i++) {
+    workers_.emplace_back([this]() { RunWorker(); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock{mutex_};
+    is_stopping_ = true;
+  }
+  task_available_.notify_all();
+  for (std::thread &worker : workers_) {
+    worker.join();
+  }
+}
+
+std::size_t ThreadPool::GetThreadCount() const { return workers_.size(); }
+
+void ThreadPool::RunWorker() {
+  while (true) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock{mutex_};
+      task_available_.wait(
+          lock, [this]() { return is_stopping_ || !tasks_.empty(); });
+      if (tasks_.empty()) {
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+    task();
+  }
+}
@@ -0,0 +1,255 @@
+#include "senbonzakura/time_report.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <sys/resource.h>
+
+#include "senbonzakura/allocation_tracker.hpp"
+#include "senbonzakura/json.hpp"
+
+namespace {
+
+double ToMilliseconds(std::chrono::nanoseconds wall_time) {
+  return std::chrono::duration<double, std::milli>(wall_time).count();
+}
+
+// Rate of 'count' items over 'wall_time', or 0 when nothing was measured.
+double GetRatePerSecond(std::size_t count,
+                        std::chrono::nanoseconds wall_time) {
+  if (wall_time.count() <= 0) {
+    return 0;
+  }
+
+  return static_cast<double>(count) /
+         std::chrono::duration<double>(wall_time).count();
+}
+
+double ToMebibytes(std::uint64_t byte_count) {
+  return static_cast<double>(byte_count) / (1 << 20);
+}
+
+void AppendTimeReportRow(std::string &output, std::string_view row_name,
+                         std::chrono::nanoseconds wall_time,
+                         std::chrono::nanoseconds total_time,
+                         const AllocationCounters &allocations,
+                         const TimeReport &time_report, bool has_allocations) {
+  double share = total_time.count() <= 0
+                     ? 0
+                     : 100.0 * static_cast<double>(wall_time.count()) /
+                           static_cast<double>(total_time.count());
+  std::format_to(
+      std::back_inserter(output), "  {:<12} {:>12.3f} ms {:>7.1f}% {:>10.1f} "
+                                  "MiB/s {:>14.0f} tokens/s",
+      row_name, ToMilliseconds(wall_time), share,
+      GetRatePerSecond(time_report.GetByteCount(), wall_time) / (1 << 20),
+      GetRatePerSecond(time_report.GetTokenCount(), wall_time));
+
+  if (has_allocations) {
+    std::format_to(std::back_inserter(output),
+                   " {:>10} allocs {:>10.1f} MiB {:>10.1f} MiB peak",
+                   allocations.allocation_count,
+                   ToMebibytes(allocations.allocated_bytes),
+                   ToMebibytes(allocations.peak_live_bytes));
+  }
+  output += '\n';
+
+  return;
+}
+
+void AppendJsonTimeReportFields(std::string &output,
+                                const TimeReport &time_report,
+                                std::chrono::nanoseconds wall_time,
+                                bool has_allocations) {
+  std::format_to(std::back_inserter(output),
+                 "\"bytes\": {}, \"tokens\": {}, \"peak_rss_bytes\": {}, "
+                 "\"wall_time_ns\": {}, \"tokens_per_second\": {:.0f}, "
+                 "\"phases\": [",
+                 time_report.GetByteCount(), time_report.GetTokenCount(),
+                 time_report.GetPeakResidentSetSize(), wall_time.count(),
+                 GetRatePerSecond(time_report.GetTokenCount(), wall_time));
+
+  const std::vector<PhaseTime> &phase_times = time_report.GetPhaseTimes();
+  for (std::size_t i = 0; i < phase_times.size(); i++) {
+    output += i == 0 ? "{\"name\": " : ", {\"name\": ";
+    AppendJsonString(output, phase_times[i].phase_name);
+    std::format_to(std::back_inserter(output), ", \"wall_time_ns\": {}",
+                   phase_times[i].wall_time.count());
+    if (has_allocations) {
+      const AllocationCounters &allocations = phase_times[i].allocations;
+      std::format_to(std::back_inserter(output),
+                     ", \"allocations\": {}, \"allocated_bytes\": {}, "
+                     "\"peak_live_bytes\": {}",
+                     allocations.allocation_count, allocations.allocated_bytes,
+                     allocations.peak_live_bytes);
+    }
+    output += '}';
+  }
+  output += ']';
+
+  return;
+}
+
+} // namespace
+
+void TimeReport::AddPhaseTime(std::string_view phase_name,
+                              std::chrono::nanoseconds wall_time,
+                              const AllocationCounters &allocations) {
+  // There are only a handful of phases, so a linear search is the fastest.
+  auto it = std::ranges::find(phase_times_, phase_name, &PhaseTime::phase_name);
+  if (it == phase_times_.end()) {
+    phase_times_.push_back(
+        PhaseTime{std::string{phase_name}, wall_time, allocations});
+  } else {
+    it->wall_time += wall_time;
+    it->allocations.allocation_count += allocations.allocation_count;
+    it->allocations.allocated_bytes += allocations.allocated_bytes;
+    it->allocations.peak_live_bytes = std::max(
+        it->allocations.peak_live_bytes, allocations.peak_live_bytes);
+  }
+
+  return;
+}
+
+void TimeReport::Merge(const TimeReport &other) {
+  for (const PhaseTime &phase_time : other.phase_times_) {
+    AddPhaseTime(phase_time.phase_name, phase_time.wall_time,
+                 phase_time.allocations);
+  }
+  byte_count_ += other.byte_count_;
+  token_count_ += other.token_count_;
+  peak_resident_set_size_ =
+      std::max(peak_resident_set_size_, other.peak_resident_set_size_);
+
+  return;
+}
+
+const std::vector<PhaseTime> &TimeReport::GetPhaseTimes() const {
+  return phase_times_;
+}
+
+std::chrono::nanoseconds TimeReport::GetTotalTime() const {
+  std::chrono::nanoseconds total_time{0};
+  for (const PhaseTime &phase_time : phase_times_) {
+    total_time += phase_time.wall_time;
+  }
+
+  return total_time;
+}
+
+std::size_t TimeReport::GetByteCount() const { return byte_count_; }
+
+std::size_t TimeReport::GetTokenCount() const { return token_count_; }
+
+std::size_t TimeReport::GetPeakResidentSetSize() const {
+  return peak_resident_set_size_;
+}
+
+void TimeReport::SetByteCount(std::size_t byte_count) {
+  byte_count_ = byte_count;
+
+  return;
+}
+
+void TimeReport::SetTokenCount(std::size_t token_count) {
+  token_count_ = token_count;
+
+  return;
+}
+
+void TimeReport::SetPeakResidentSetSize(std::size_t peak_resident_set_size) {
+  peak_resident_set_size_ = peak_resident_set_size;
+
+  return;
+}
+
+TimeReport::PhaseTimer::PhaseTimer(TimeReport &time_report,
+                                   std::string_view phase_name)
+    : time_report_{time_report}, phase_name_{phase_name},
+      start_{std::chrono::steady_clock::now()} {}
+
+TimeReport::PhaseTimer::~PhaseTimer() {
+  time_report_.AddPhaseTime(phase_name_,
+                            std::chrono::steady_clock::now() - start_,
+                            allocation_scope_.Stop());
+}
+
+std::size_t GetPeakResidentSetSize() {
+  rusage resource_usage{};
+  if (getrusage(RUSAGE_SELF, &resource_usage) != 0) {
+    return 0;
+  }
+
+  // Linux reports it in KiB.
+  return static_cast<std::size_t>(resource_usage.ru_maxrss) * 1024;
+}
+
+std::string FormatTimeReport(std::string_view title,
+                             const TimeReport &time_report,
+                             std::chrono::nanoseconds wall_time,
+                             bool has_allocations) {
+  std::chrono::nanoseconds total_time = time_report.GetTotalTime();
+  AllocationCounters total_allocations;
+  for (const PhaseTime &phase_time : time_report.GetPhaseTimes()) {
+    total_allocations.allocation_count +=
+        phase_time.allocations.allocation_count;
+    total_allocations.allocated_bytes += phase_time.allocations.allocated_bytes;
+    total_allocations.peak_live_bytes =
+        std::max(total_allocations.peak_live_bytes,
+                 phase_time.allocations.peak_live_bytes);
+  }
+
+  std::string output = std::format(
+      "===-- Time report for {} --===\n"
+      "  {} bytes, {} tokens, peak RSS {:.1f} MiB\n",
+      title, time_report.GetByteCount(), time_report.GetTokenCount(),
+      static_cast<double>(time_report.GetPeakResidentSetSize()) / (1 << 20));
+  for (const PhaseTime &phase_time : time_report.GetPhaseTimes()) {
+    AppendTimeReportRow(output, phase_time.phase_name, phase_time.wall_time,
+                        total_time, phase_time.allocations, time_report,
+                        has_allocations);
+  }
+  AppendTimeReportRow(output, "total", total_time, total_time,
+                      total_allocations, time_report, has_allocations);
+  if (wall_time.count() > 0) {
+    AppendTimeReportRow(output, "wall", wall_time, total_time,
+                        total_allocations, time_report, has_allocations);
+  }
+
+  return output;
+}
+
+std::string FormatTimeReportJson(
+    const std::vector<std::pair<std::string, TimeReport>> &file_time_reports,
+    const TimeReport &total_time_report, std::chrono::nanoseconds wall_time,
+    bool has_allocations) {
+  std::string output = "{\n  \"files\": [";
+  for (std::size_t i = 0; i < file_time_reports.size(); i++) {
+    const auto &[file_path, time_report] = file_time_reports[i];
+    output += i == 0 ? "\n    {\"path\": " : ",\n    {\"path\": ";
+    AppendJsonString(output, file_path);
+    output += ", ";
+    AppendJsonTimeReportFields(output, time_report, time_report.GetTotalTime(),
+                               has_allocations);
+    output += '}';
+  }
+
+  std::format_to(std::back_inserter(output),
+                 "\n  ],\n  \"total\": {{\"files\": {}, ",
+                 file_time_reports.size());
+  AppendJsonTimeReportFields(output, total_time_report, wall_time,
+                             has_allocations);
+  std::format_to(std::back_inserter(output),
+                 ", \"phase_time_ns\": {}}}\n}}\n",
+                 total_time_report.GetTotalTime().count());
+
+  return output;
+}
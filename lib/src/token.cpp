@@ -1,66 +1,98 @@
 #include "senbonzakura/token.hpp"
 
-#include <format>
-#include <iostream>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <string_view>
 
-Token::Token(int line, int column, TokenType token_type, std::any value,
-             std::string lexeme)
-    : line_(line), column_(column), token_type_(token_type),
-      value_(std::move(value)), lexeme_(std::move(lexeme)) {}
+#include "senbonzakura/literal_decoder.hpp"
+#include "senbonzakura/string_interner.hpp"
+
+Token::Token(TokenType token_type, std::uint32_t offset, std::uint32_t length,
+             TokenValue value)
+    : offset_(offset), length_(length), token_type_(token_type), value_(value) {
+}
 
 bool Token::operator==(const Token &other) const {
-  return line_ == other.line_ && column_ == other.column_ &&
-         token_type_ == other.token_type_ && lexeme_ == other.lexeme_;
+  return token_type_ == other.token_type_ && offset_ == other.offset_ &&
+         length_ == other.length_;
+}
+
+std::string_view Token::GetLexeme(std::string_view source_code) const {
+  return source_code.substr(offset_, length_);
+}
+
+std::string_view Token::GetStringValue() const {
+  return GetStringInterner().GetString(value_.symbol_value);
 }
 
-std::ostream &operator<<(std::ostream &os, const Token &token) {
-  os << std::format("[{:03}:{:03}] Type: {}", token.line_, token.column_,
-                    token.token_type_);
+namespace {
+
+void AppendNumber(std::string &output, std::uint64_t number,
+                  std::size_t min_width = 0) {
+  char digits[std::numeric_limits<std::uint64_t>::digits10 + 1];
+  char *digits_end =
+      std::to_chars(std::begin(digits), std::end(digits), number).ptr;
+  auto digit_count = static_cast<std::size_t>(digits_end - digits);
+  if (digit_count < min_width) {
+    output.append(min_width - digit_count, '0');
+  }
+  output.append(digits, digit_count);
+
+  return;
+}
+
+} // namespace
+
+std::string TokenToString(const Token &token, std::string_view source_code,
+                          const LineTable &line_table) {
+  std::string token_str;
+  AppendTokenString(token_str, token, source_code,
+                    line_table.Resolve(token.offset_));
+
+  return token_str;
+}
+
+void AppendTokenString(std::string &output, const Token &token,
+                       std::string_view source_code, LineColumn position) {
+  output += '[';
+  AppendNumber(output, position.line, 3);
+  output += ':';
+  AppendNumber(output, position.column, 3);
+  output += "] Type: ";
+  output += GetTokenTypeName(token.token_type_);
 
   switch (token.token_type_) {
   case (TokenType::kCharacter):
-    try {
-      const char ch_value = std::any_cast<const char>(token.value_);
-      os << std::format(" - Value: {}", ch_value);
-      os << std::format(" - Lexeme: {}", token.lexeme_);
-    } catch (const std::bad_any_cast &e) {
-      os << " - Value: <Error: Bad Any Cast for string>";
-    }
+    output += " - Value: ";
+    AppendEscapedLiteral(output,
+                         std::string_view{&token.value_.character_value, 1});
+    output += " - Lexeme: ";
+    output += token.GetLexeme(source_code);
     break;
-  case (TokenType::kString): {
-    try {
-      const std::string s_value =
-          std::any_cast<const std::string>(token.value_);
-      os << std::format(" - Value: {}", s_value);
-      os << std::format(" - Lexeme: {}", token.lexeme_);
-    } catch (const std::bad_any_cast &e) {
-      os << " - Value: <Error: Bad Any Cast for string>";
-    }
+  case (TokenType::kString):
+    output += " - Value: ";
+    AppendEscapedLiteral(output, token.GetStringValue());
+    output += " - Lexeme: ";
+    output += token.GetLexeme(source_code);
     break;
-  }
-  case (TokenType::kInteger): {
-    try {
-      int i_value = std::any_cast<int>(token.value_);
-      os << std::format(" - Value: {}", i_value);
-    } catch (const std::bad_any_cast &e) {
-      os << " - Value: <Error: Bad Any Cast for integer>";
-    }
+  case (TokenType::kInteger):
+    output += " - Value: ";
+    AppendNumber(output, token.value_.integer_value);
     break;
-  }
   case (TokenType::kTrue):
-  case (TokenType::kFalse): {
-    try {
-      bool b_value = std::any_cast<bool>(token.value_);
-      os << std::format(" - Value: {}", b_value ? "true" : "false");
-    } catch (const std::bad_any_cast &e) {
-      os << " - Value: <Error: Bad Any Cast for boolean>";
-    }
+  case (TokenType::kFalse):
+    output += " - Value: ";
+    output += token.value_.boolean_value ? "true" : "false";
     break;
-  }
   default:
-    os << std::format(" - Lexeme: {}",
-                      token.lexeme_); // Mantém o lexema para outros tipos
+    output += " - Lexeme: ";
+    output += token.GetLexeme(source_code);
     break;
   }
-  return os;
+
+  return;
 }
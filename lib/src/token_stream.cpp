@@ -0,0 +1,57 @@
+#include "senbonzakura/token_stream.hpp"
+
+#include <cassert>
+
+SpanTokenStream::SpanTokenStream(std::span<const Token> tokens)
+    : tokens_{tokens} {}
+
+Token SpanTokenStream::NextToken() {
+  if (next_ < tokens_.size()) {
+    return tokens_[next_++];
+  }
+
+  // The span has been exhausted, or it was cut short by a lexical error before
+  // its 'kFileEnd' token. Either way, the stream ends right after the last
+  // token it holds.
+  if (tokens_.empty()) {
+    return Token{TokenType::kFileEnd, 0, 0};
+  }
+  const Token &last_token = tokens_.back();
+  if (last_token.token_type_ == TokenType::kFileEnd) {
+    return last_token;
+  }
+
+  return Token{TokenType::kFileEnd, last_token.offset_ + last_token.length_,
+               0};
+}
+
+TokenCursor::TokenCursor(TokenStream &token_stream)
+    : token_stream_{token_stream} {}
+
+Token TokenCursor::Advance() {
+  Token current_token = Peek(0);
+  head_ = (head_ + 1) & (kCapacity - 1);
+  size_--;
+
+  return current_token;
+}
+
+bool TokenCursor::IsAtEnd() {
+  return Peek(0).token_type_ == TokenType::kFileEnd;
+}
+
+const Token &TokenCursor::Peek(std::size_t offset) {
+  assert(offset <= kMaxLookahead);
+  Fill(offset + 1);
+
+  return buffer_[(head_ + offset) & (kCapacity - 1)];
+}
+
+void TokenCursor::Fill(std::size_t count) {
+  while (size_ < count) {
+    buffer_[(head_ + size_) & (kCapacity - 1)] = token_stream_.NextToken();
+    size_++;
+  }
+
+  return;
+}
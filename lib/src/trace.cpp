@@ -0,0 +1,177 @@
+#include "senbonzakura/trace.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <unistd.h>
+
+#include "senbonzakura/json.hpp"
+
+namespace {
+
+// A complete event ("ph": "X" in the Chrome trace format). Counts are -1 when
+// they were not set.
+struct TraceEvent {
+  const char *name;
+  std::string file_path;
+  std::int64_t start;
+  std::int64_t duration;
+  std::int64_t byte_count;
+  std::int64_t token_count;
+};
+
+// Events of a single thread. Only its thread appends to it, until the trace
+// is formatted.
+struct ThreadTraceBuffer {
+  std::size_t thread_id;
+  std::vector<TraceEvent> events;
+};
+
+std::atomic<bool> is_tracing_enabled = false;
+std::atomic<std::int64_t> trace_start = 0;
+
+// The buffers outlive their threads, since the trace is only formatted once
+// the workers are gone.
+std::mutex thread_buffers_mutex;
+std::vector<std::unique_ptr<ThreadTraceBuffer>> thread_buffers;
+thread_local ThreadTraceBuffer *thread_buffer = nullptr;
+
+ThreadTraceBuffer &GetThreadTraceBuffer() {
+  if (thread_buffer == nullptr) {
+    std::lock_guard<std::mutex> lock{thread_buffers_mutex};
+    thread_buffers.push_back(std::make_unique<ThreadTraceBuffer>(
+        ThreadTraceBuffer{thread_buffers.size() + 1, {}}));
+    thread_buffer = thread_buffers.back().get();
+  }
+
+  return *thread_buffer;
+}
+
+std::int64_t GetTimestamp(std::chrono::steady_clock::time_point time_point) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             time_point.time_since_epoch())
+      .count();
+}
+
+// Chrome trace timestamps are in microseconds, and may have a fraction.
+void AppendMicroseconds(std::string &output, std::int64_t nanoseconds) {
+  std::format_to(std::back_inserter(output), "{}.{:03}", nanoseconds / 1000,
+                 nanoseconds % 1000);
+
+  return;
+}
+
+} // namespace
+
+bool IsTracingSupported() { return SENBONZAKURA_ENABLE_TRACING; }
+
+void StartTracing() {
+  if (!IsTracingSupported()) {
+    return;
+  }
+
+  trace_start.store(GetTimestamp(std::chrono::steady_clock::now()),
+                    std::memory_order_relaxed);
+  // The calling thread is registered first, so it is always thread 1.
+  GetThreadTraceBuffer();
+  is_tracing_enabled.store(true, std::memory_order_release);
+
+  return;
+}
+
+bool IsTracingEnabled() {
+  return is_tracing_enabled.load(std::memory_order_acquire);
+}
+
+std::string FormatTrace() {
+  std::lock_guard<std::mutex> lock{thread_buffers_mutex};
+  pid_t process_id = getpid();
+  std::int64_t start = trace_start.load(std::memory_order_relaxed);
+
+  std::string output = "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+  bool is_first_event = true;
+  for (const std::unique_ptr<ThreadTraceBuffer> &buffer : thread_buffers) {
+    std::format_to(std::back_inserter(output),
+                   "{}\n{{\"name\": \"thread_name\", \"ph\": \"M\", "
+                   "\"pid\": {}, \"tid\": {}, \"args\": {{\"name\": \"{}\"}}}}",
+                   is_first_event ? "" : ",", process_id, buffer->thread_id,
+                   buffer->thread_id == 1
+                       ? std::string{"main"}
+                       : std::format("worker {}", buffer->thread_id - 1));
+    is_first_event = false;
+
+    for (const TraceEvent &event : buffer->events) {
+      output += ",\n{\"name\": ";
+      AppendJsonString(output, event.name);
+      output += ", \"cat\": \"compilation\", \"ph\": \"X\", \"ts\": ";
+      AppendMicroseconds(output, event.start - start);
+      output += ", \"dur\": ";
+      AppendMicroseconds(output, event.duration);
+      std::format_to(std::back_inserter(output),
+                     ", \"pid\": {}, \"tid\": {}, \"args\": {{\"file\": ",
+                     process_id, buffer->thread_id);
+      AppendJsonString(output, event.file_path);
+      if (event.byte_count >= 0) {
+        std::format_to(std::back_inserter(output), ", \"bytes\": {}",
+                       event.byte_count);
+      }
+      if (event.token_count >= 0) {
+        std::format_to(std::back_inserter(output), ", \"tokens\": {}",
+                       event.token_count);
+      }
+      output += "}}";
+    }
+  }
+  output += "\n]}\n";
+
+  return output;
+}
+
+#if SENBONZAKURA_ENABLE_TRACING
+
+TraceScope::TraceScope(const char *name, std::string_view file_path) {
+  if (is_tracing_enabled.load(std::memory_order_acquire)) {
+    name_ = name;
+    file_path_ = file_path;
+    start_ = std::chrono::steady_clock::now();
+  }
+}
+
+TraceScope::~TraceScope() {
+  if (name_ == nullptr) {
+    return;
+  }
+
+  std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+  GetThreadTraceBuffer().events.push_back(TraceEvent{
+      .name = name_,
+      .file_path = std::string{file_path_},
+      .start = GetTimestamp(start_),
+      .duration = GetTimestamp(end) - GetTimestamp(start_),
+      .byte_count = byte_count_,
+      .token_count = token_count_,
+  });
+}
+
+void TraceScope::SetByteCount(std::size_t byte_count) {
+  byte_count_ = static_cast<std::int64_t>(byte_count);
+
+  return;
+}
+
+void TraceScope::SetTokenCount(std::size_t token_count) {
+  token_count_ = static_cast<std::int64_t>(token_count);
+
+  return;
+}
+
+#endif
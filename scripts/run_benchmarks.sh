@@ -0,0 +1,15 @@
+#!/bin/bash
+# Roda os benchmarks numa build otimizada e salva os resultados em JSON,
+# nomeados pelo commit atual, para comparar commits diferentes depois.
+# Uso: scripts/run_benchmarks.sh [argumentos extras do Google Benchmark]
+set -euo pipefail
+
+cd "$(dirname "$0")/.."
+cmake -S . -B build-release -DCMAKE_BUILD_TYPE=Release -DBUILD_BENCHMARKS=ON
+cmake --build build-release --target senbonzakura_bench
+
+mkdir -p benchmark-results
+output_file="benchmark-results/$(git rev-parse --short HEAD).json"
+./build-release/benchmarks/senbonzakura_bench \
+  --benchmark_out="${output_file}" --benchmark_out_format=json "$@"
+echo "Resultados salvos em ${output_file}"
@@ -0,0 +1,80 @@
+#include "senbonzakura/allocation_tracker.hpp"
+
+#include "senbonzakura/time_report.hpp"
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+// The tests are not linked with the allocation hooks, so only the allocations
+// recorded by hand are counted.
+
+TEST(AllocationTrackerTest, CountsTheAllocationsOfAScope) {
+  AllocationScope allocation_scope;
+  RecordAllocation(100);
+  RecordAllocation(50);
+  RecordDeallocation(100);
+  RecordAllocation(10);
+  AllocationCounters allocation_counters = allocation_scope.Stop();
+
+  EXPECT_EQ(allocation_counters.allocation_count, 3);
+  EXPECT_EQ(allocation_counters.allocated_bytes, 160);
+  EXPECT_EQ(allocation_counters.peak_live_bytes, 150);
+  RecordDeallocation(60);
+}
+
+TEST(AllocationTrackerTest, KeepsThePeakOfEnclosingScopes) {
+  AllocationScope outer_allocation_scope;
+  RecordAllocation(1000);
+  RecordDeallocation(1000);
+
+  AllocationScope inner_allocation_scope;
+  RecordAllocation(10);
+  RecordDeallocation(10);
+  AllocationCounters inner_allocation_counters = inner_allocation_scope.Stop();
+  AllocationCounters outer_allocation_counters = outer_allocation_scope.Stop();
+
+  EXPECT_EQ(inner_allocation_counters.allocation_count, 1);
+  EXPECT_EQ(inner_allocation_counters.peak_live_bytes, 10);
+  EXPECT_EQ(outer_allocation_counters.allocation_count, 2);
+  EXPECT_EQ(outer_allocation_counters.peak_live_bytes, 1000);
+}
+
+TEST(AllocationTrackerTest, DoesNotCountOtherThreads) {
+  AllocationScope allocation_scope;
+  std::thread thread{[]() { RecordAllocation(100); }};
+  thread.join();
+
+  EXPECT_EQ(allocation_scope.Stop().allocation_count, 0);
+}
+
+TEST(AllocationTrackerTest, AttributesAllocationsToTimeReportPhases) {
+  TimeReport time_report;
+  time_report.MeasurePhase("lex", []() {
+    RecordAllocation(1 << 20);
+    RecordDeallocation(1 << 20);
+  });
+  time_report.MeasurePhase("lex", []() { RecordAllocation(10); });
+  RecordDeallocation(10);
+
+  ASSERT_EQ(time_report.GetPhaseTimes().size(), 1);
+  const AllocationCounters &allocations =
+      time_report.GetPhaseTimes()[0].allocations;
+  EXPECT_EQ(allocations.allocation_count, 2);
+  EXPECT_EQ(allocations.allocated_bytes, (1 << 20) + 10);
+  EXPECT_EQ(allocations.peak_live_bytes, 1 << 20);
+
+  EXPECT_FALSE(AreAllocationHooksInstalled());
+  EXPECT_EQ(FormatTimeReport("'main.eta'", time_report).find("allocs"),
+            std::string::npos);
+  EXPECT_NE(FormatTimeReport("'main.eta'", time_report,
+                             std::chrono::nanoseconds{0}, true)
+                .find("          2 allocs        1.0 MiB        1.0 MiB peak"),
+            std::string::npos);
+  EXPECT_NE(FormatTimeReportJson({}, time_report, std::chrono::seconds{1}, true)
+                .find("\"allocations\": 2, \"allocated_bytes\": 1048586, "
+                      "\"peak_live_bytes\": 1048576"),
+            std::string::npos);
+}
@@ -0,0 +1,123 @@
+#include "senbonzakura/ast.hpp"
+#include "senbonzakura/string_interner.hpp"
+#include "senbonzakura/token_type.hpp"
+
+#include <span>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace {
+
+std::vector<AstIndex> GetChildren(const Ast &ast, AstRange range) {
+  std::span<const AstIndex> children = ast.GetChildren(range);
+  return {children.begin(), children.end()};
+}
+
+} // namespace
+
+TEST(AstTest, StartsWithoutRoot) {
+  Ast ast;
+
+  EXPECT_EQ(ast.GetRoot(), kNoAstIndex);
+  EXPECT_EQ(ast.GetNodeCount(), 0);
+}
+
+TEST(AstTest, AddsNodesWithConsecutiveIndices) {
+  Ast ast;
+  ast.Reserve(16);
+
+  AstIndex left = ast.AddNode(AstNodeKind::kInteger, 4);
+  ast.GetNode(left).integer_value = 1;
+  AstIndex right = ast.AddNode(AstNodeKind::kInteger, 8);
+  ast.GetNode(right).integer_value = 2;
+  AstIndex sum = ast.AddPairNode(AstNodeKind::kBinary, 4, left, right);
+  ast.GetNode(sum).operator_type = TokenType::kPlus;
+
+  EXPECT_EQ(left, 0);
+  EXPECT_EQ(right, 1);
+  EXPECT_EQ(sum, 2);
+  EXPECT_EQ(ast.GetNodeCount(), 3);
+
+  const AstNode &node = ast.GetNode(sum);
+  EXPECT_EQ(node.kind, AstNodeKind::kBinary);
+  EXPECT_EQ(node.operator_type, TokenType::kPlus);
+  EXPECT_EQ(node.offset, 4);
+  EXPECT_EQ(node.pair.first, left);
+  EXPECT_EQ(node.pair.second, right);
+  EXPECT_EQ(ast.GetNode(right).integer_value, 2);
+}
+
+TEST(AstTest, AddsPairNodesWithoutSecondChild) {
+  Ast ast;
+
+  AstIndex operand = ast.AddNode(AstNodeKind::kBoolean, 1);
+  AstIndex negation = ast.AddPairNode(AstNodeKind::kUnary, 0, operand);
+
+  EXPECT_EQ(ast.GetNode(negation).pair.first, operand);
+  EXPECT_EQ(ast.GetNode(negation).pair.second, kNoAstIndex);
+}
+
+TEST(AstTest, CopiesChildListsOutOfTheGivenBuffer) {
+  Ast ast;
+  std::vector<AstIndex> scratch;
+
+  scratch.push_back(ast.AddNode(AstNodeKind::kInteger, 1));
+  scratch.push_back(ast.AddNode(AstNodeKind::kInteger, 4));
+  AstIndex first = ast.AddRangeNode(AstNodeKind::kArrayLiteral, 0, scratch);
+  scratch.clear();
+  scratch.push_back(ast.AddNode(AstNodeKind::kInteger, 10));
+  AstIndex second = ast.AddRangeNode(AstNodeKind::kArrayLiteral, 9, scratch);
+
+  EXPECT_EQ(GetChildren(ast, ast.GetNode(first).range),
+            (std::vector<AstIndex>{0, 1}));
+  EXPECT_EQ(GetChildren(ast, ast.GetNode(second).range),
+            (std::vector<AstIndex>{3}));
+}
+
+TEST(AstTest, KeepsFunctionsIfStatementsAndAssignmentsInSideTables) {
+  Ast ast;
+  Symbol name = GetStringInterner().Intern("ast_test_function");
+
+  AstIndex parameter = ast.AddNode(AstNodeKind::kDeclaration, 2);
+  AstIndex return_type = ast.AddNode(AstNodeKind::kIntType, 10);
+  AstIndex condition = ast.AddNode(AstNodeKind::kBoolean, 20);
+  AstIndex target = ast.AddNode(AstNodeKind::kDiscard, 25);
+  AstIndex value = ast.AddNode(AstNodeKind::kInteger, 29);
+  std::vector<AstIndex> targets{target};
+  std::vector<AstIndex> values{value};
+  AstIndex assignment = ast.AddAssignment(25, targets, values);
+  AstIndex if_statement = ast.AddIf(17, condition, assignment, kNoAstIndex);
+  std::vector<AstIndex> statements{if_statement};
+  AstIndex body = ast.AddRangeNode(AstNodeKind::kBlock, 15, statements);
+  std::vector<AstIndex> parameters{parameter};
+  std::vector<AstIndex> return_types{return_type};
+  AstIndex function = ast.AddFunction(0, name, parameters, return_types, body);
+
+  const AstFunction &ast_function = ast.GetFunction(ast.GetNode(function));
+  EXPECT_EQ(ast_function.name, name);
+  EXPECT_EQ(GetChildren(ast, ast_function.parameters),
+            (std::vector<AstIndex>{parameter}));
+  EXPECT_EQ(GetChildren(ast, ast_function.return_types),
+            (std::vector<AstIndex>{return_type}));
+  EXPECT_EQ(ast_function.body, body);
+
+  const AstIf &ast_if = ast.GetIf(ast.GetNode(if_statement));
+  EXPECT_EQ(ast_if.condition, condition);
+  EXPECT_EQ(ast_if.then_branch, assignment);
+  EXPECT_EQ(ast_if.else_branch, kNoAstIndex);
+
+  const AstAssignment &ast_assignment =
+      ast.GetAssignment(ast.GetNode(assignment));
+  EXPECT_EQ(GetChildren(ast, ast_assignment.targets), targets);
+  EXPECT_EQ(GetChildren(ast, ast_assignment.values), values);
+}
+
+TEST(AstTest, SetsTheRoot) {
+  Ast ast;
+
+  AstIndex program = ast.AddRangeNode(AstNodeKind::kProgram, 0, {});
+  ast.SetRoot(program);
+
+  EXPECT_EQ(ast.GetRoot(), program);
+}
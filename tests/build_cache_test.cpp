@@ -0,0 +1,86 @@
+#include "senbonzakura/build_cache.hpp"
+
+#include "senbonzakura/diagnostic_reporter.hpp"
+#include "senbonzakura/lexer.hpp"
+#include "senbonzakura/token.hpp"
+#include "senbonzakura/token_type.hpp"
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+class BuildCacheTest : public ::testing::Test {
+protected:
+  std::string temp_dir_path_;
+  DiagnosticReporter diagnostic_reporter_;
+
+  void SetUp() override {
+    temp_dir_path_ = std::filesystem::temp_directory_path().string() +
+                     "/test_build_cache_dir";
+    std::filesystem::remove_all(temp_dir_path_);
+  }
+
+  void TearDown() override { std::filesystem::remove_all(temp_dir_path_); }
+};
+
+TEST_F(BuildCacheTest, KeysDependOnTheSourceCode) {
+  EXPECT_EQ(BuildCache::ComputeKey("x = 1"), BuildCache::ComputeKey("x = 1"));
+  EXPECT_NE(BuildCache::ComputeKey("x = 1"), BuildCache::ComputeKey("x = 2"));
+}
+
+TEST_F(BuildCacheTest, LoadsStoredTokens) {
+  std::string source_code = "main() {\n  s: int[] = \"hi\"\n}\n";
+  Lexer lexer{"file.eta", source_code, diagnostic_reporter_};
+  std::vector<Token> tokens = lexer.LexTokens();
+  BuildCache build_cache{temp_dir_path_ + "/cache"};
+  BuildCache::Key key = BuildCache::ComputeKey(source_code);
+
+  EXPECT_FALSE(build_cache.LoadTokens(key, source_code.length()));
+  ASSERT_TRUE(build_cache.StoreTokens(key, tokens, source_code));
+
+  std::optional<std::vector<Token>> cached_tokens =
+      build_cache.LoadTokens(key, source_code.length());
+  ASSERT_TRUE(cached_tokens);
+  EXPECT_EQ(*cached_tokens, tokens);
+  EXPECT_EQ((*cached_tokens)[10].token_type_, TokenType::kString);
+  EXPECT_EQ((*cached_tokens)[10].GetStringValue(), "hi");
+
+  // Only the final entry is left behind.
+  std::size_t file_count = 0;
+  for (const auto &entry :
+       std::filesystem::directory_iterator(temp_dir_path_ + "/cache")) {
+    EXPECT_EQ(entry.path().extension(), ".lexedb");
+    file_count++;
+  }
+  EXPECT_EQ(file_count, 1);
+}
+
+TEST_F(BuildCacheTest, IgnoresDamagedEntries) {
+  std::string source_code = "x = 1";
+  Lexer lexer{"file.eta", source_code, diagnostic_reporter_};
+  BuildCache build_cache{temp_dir_path_};
+  BuildCache::Key key = BuildCache::ComputeKey(source_code);
+  ASSERT_TRUE(build_cache.StoreTokens(key, lexer.LexTokens(), source_code));
+
+  EXPECT_FALSE(build_cache.LoadTokens(key, source_code.length() + 1));
+
+  for (const auto &entry :
+       std::filesystem::directory_iterator(temp_dir_path_)) {
+    std::ofstream{entry.path(), std::ios::app} << "garbage";
+  }
+  EXPECT_FALSE(build_cache.LoadTokens(key, source_code.length()));
+}
+
+TEST_F(BuildCacheTest, FailsToStoreIntoAnInvalidDirectory) {
+  std::filesystem::create_directory(temp_dir_path_);
+  std::ofstream{temp_dir_path_ + "/file"} << "";
+  BuildCache build_cache{temp_dir_path_ + "/file"};
+  std::vector<Token> tokens{Token{TokenType::kFileEnd, 0, 0}};
+
+  EXPECT_FALSE(build_cache.StoreTokens(BuildCache::ComputeKey(""), tokens, ""));
+}
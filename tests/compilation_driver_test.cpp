@@ -0,0 +1,150 @@
+#include "senbonzakura/compilation_driver.hpp"
+#include "senbonzakura/file_writer.hpp"
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+class CompilationDriverTest : public ::testing::Test {
+protected:
+  std::string temp_dir_path_;
+  std::vector<std::string> file_paths_;
+
+  void SetUp() override {
+    temp_dir_path_ = std::filesystem::temp_directory_path().string() +
+                     "/test_compilation_driver_dir";
+    std::filesystem::create_directory(temp_dir_path_);
+
+    // Every third file has an invalid symbol, which is a fatal error.
+    for (int i = 0; i < 12; i++) {
+      std::string file_path =
+          temp_dir_path_ + "/file_" + std::to_string(i) + ".eta";
+      std::ofstream file{file_path};
+      file << "main() {\n  x: int = " << i << (i % 3 == 0 ? " @" : "")
+           << "\n}\n";
+      file_paths_.push_back(file_path);
+    }
+  }
+
+  void TearDown() override { std::filesystem::remove_all(temp_dir_path_); }
+};
+
+TEST_F(CompilationDriverTest, ReportsResultsInInputOrder) {
+  FileWriter file_writer{file_paths_, temp_dir_path_};
+  std::vector<std::string> reported_file_paths;
+  std::vector<bool> reported_failures;
+
+  std::size_t failed_file_count = CompileFiles(
+      file_paths_, file_writer, CompilationOptions{.job_count = 4},
+      [&](const FileCompilationResult &result) {
+        reported_file_paths.push_back(result.file_path);
+        reported_failures.push_back(result.HasFailed());
+      });
+
+  EXPECT_EQ(failed_file_count, 4);
+  EXPECT_EQ(reported_file_paths, file_paths_);
+  for (std::size_t i = 0; i < file_paths_.size(); i++) {
+    EXPECT_EQ(reported_failures[i], i % 3 == 0);
+    EXPECT_TRUE(std::filesystem::exists(file_paths_[i] + ".lexed"));
+  }
+}
+
+TEST_F(CompilationDriverTest, KeepsCompilingAfterAFailedFile) {
+  FileWriter file_writer{file_paths_, temp_dir_path_};
+  std::size_t reported_file_count = 0;
+
+  std::size_t failed_file_count = CompileFiles(
+      file_paths_, file_writer, CompilationOptions{},
+      [&](const FileCompilationResult &) { reported_file_count++; });
+
+  EXPECT_EQ(failed_file_count, 4);
+  EXPECT_EQ(reported_file_count, file_paths_.size());
+}
+
+TEST_F(CompilationDriverTest, FailsOnFilesThatCannotBeRead) {
+  FileWriter file_writer{file_paths_, temp_dir_path_};
+
+  FileCompilationResult result = CompileFile(
+      temp_dir_path_ + "/missing.eta", file_writer, CompilationOptions{});
+
+  EXPECT_TRUE(result.HasFailed());
+  EXPECT_TRUE(result.diagnostic_reporter.HasFatalErrors());
+}
+
+TEST_F(CompilationDriverTest, ReusesCachedTokensOfUnchangedFiles) {
+  FileWriter file_writer{file_paths_, temp_dir_path_};
+  CompilationOptions options{.cache_directory = temp_dir_path_ + "/cache"};
+  std::string lexed_file_path = file_paths_[1] + ".lexed";
+
+  FileCompilationResult first_result =
+      CompileFile(file_paths_[1], file_writer, options);
+  std::ifstream first_lexed_file{lexed_file_path};
+  std::string first_output{(std::istreambuf_iterator<char>(first_lexed_file)),
+                           std::istreambuf_iterator<char>()};
+
+  FileCompilationResult second_result =
+      CompileFile(file_paths_[1], file_writer, options);
+  std::ifstream second_lexed_file{lexed_file_path};
+  std::string second_output{
+      (std::istreambuf_iterator<char>(second_lexed_file)),
+      std::istreambuf_iterator<char>()};
+
+  EXPECT_FALSE(first_result.is_cached);
+  EXPECT_TRUE(second_result.is_cached);
+  EXPECT_FALSE(second_result.HasFailed());
+  EXPECT_EQ(second_output, first_output);
+}
+
+TEST_F(CompilationDriverTest, DoesNotCacheFilesWithDiagnostics) {
+  FileWriter file_writer{file_paths_, temp_dir_path_};
+  CompilationOptions options{.cache_directory = temp_dir_path_ + "/cache"};
+
+  CompileFile(file_paths_[0], file_writer, options);
+  FileCompilationResult result =
+      CompileFile(file_paths_[0], file_writer, options);
+
+  EXPECT_FALSE(result.is_cached);
+  EXPECT_TRUE(result.HasFailed());
+}
+
+TEST_F(CompilationDriverTest, MeasuresEveryPhase) {
+  FileWriter file_writer{file_paths_, temp_dir_path_};
+
+  FileCompilationResult result =
+      CompileFile(file_paths_[1], file_writer, CompilationOptions{});
+
+  std::vector<std::string> phase_names;
+  for (const PhaseTime &phase_time : result.time_report.GetPhaseTimes()) {
+    phase_names.push_back(phase_time.phase_name);
+  }
+  EXPECT_EQ(phase_names,
+            (std::vector<std::string>{"scan", "lex", "parse", "write"}));
+  EXPECT_EQ(result.time_report.GetByteCount(),
+            std::filesystem::file_size(file_paths_[1]));
+  EXPECT_GT(result.time_report.GetTokenCount(), 0);
+  EXPECT_GT(result.time_report.GetPeakResidentSetSize(), 0);
+}
+
+TEST_F(CompilationDriverTest, WritesTheTreeOrTheFirstErrorAsParserOutput) {
+  FileWriter file_writer{file_paths_, temp_dir_path_};
+  CompilationOptions options{.emit_parsed = true};
+
+  CompileFile(file_paths_[0], file_writer, options);
+  CompileFile(file_paths_[1], file_writer, options);
+
+  std::ifstream failed_parsed_file{file_paths_[0] + ".parsed"};
+  std::string failed_output{
+      (std::istreambuf_iterator<char>(failed_parsed_file)),
+      std::istreambuf_iterator<char>()};
+  std::ifstream parsed_file{file_paths_[1] + ".parsed"};
+  std::string output{(std::istreambuf_iterator<char>(parsed_file)),
+                     std::istreambuf_iterator<char>()};
+
+  EXPECT_EQ(failed_output.rfind("2:14 error:", 0), 0) << failed_output;
+  EXPECT_EQ(output, "(() ((main () () ((= (x int) 1)))))\n");
+}
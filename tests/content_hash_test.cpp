@@ -0,0 +1,32 @@
+#include "senbonzakura/content_hash.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <gtest/gtest.h>
+
+TEST(ContentHashTest, MatchesTheReferenceImplementation) {
+  EXPECT_EQ(HashContent(""), 0xEF46DB3751D8E999);
+  EXPECT_EQ(HashContent("a"), 0xD24EC4F1A98C6E5B);
+  EXPECT_EQ(HashContent("abc"), 0x44BC2CF5AD770999);
+  // Long enough to go through the four lanes.
+  EXPECT_EQ(HashContent("Nobody inspects the spammish repetition"),
+            0xFBCEA83C8A378BF1);
+}
+
+TEST(ContentHashTest, DependsOnTheSeed) {
+  EXPECT_NE(HashContent("main() {}", 0), HashContent("main() {}", 1));
+}
+
+TEST(ContentHashTest, DependsOnEveryByte) {
+  std::string source_code(1000, 'x');
+  std::uint64_t hash = HashContent(source_code);
+
+  for (std::size_t i = 0; i < source_code.length(); i += 37) {
+    std::string changed_source_code = source_code;
+    changed_source_code[i] = 'y';
+    EXPECT_NE(HashContent(changed_source_code), hash);
+  }
+  EXPECT_NE(HashContent(source_code.substr(1)), hash);
+}
@@ -4,11 +4,15 @@
 
 #include <gtest/gtest.h>
 
+#include "senbonzakura/string_interner.hpp"
+
 TEST(DiagnosticReporterTest, ReportCompilerErrorTest) {
   DiagnosticReporter diagnostic_reporter;
 
   SourceCodeLocation src_code_location{
-      .source_name = "/path/to/file.eta", .line = 1, .column = 1};
+      .file = GetStringInterner().Intern("/path/to/file.eta"),
+      .line = 1,
+      .column = 1};
 
   EXPECT_FALSE(diagnostic_reporter.HasWarnings());
   EXPECT_FALSE(diagnostic_reporter.HasNormalErrors());
@@ -54,15 +58,21 @@ TEST_F(DiagnosticReporterOutputTest, OutputCompilerErrorsPrintsCorrectFormat) {
 
   diagnostic_reporter.ReportCompilerError(
       SourceCodeLocation{
-          .source_name = "/some/path/to/file_1.eta", .line = 1, .column = 2},
+          .file = GetStringInterner().Intern("/some/path/to/file_1.eta"),
+          .line = 1,
+          .column = 2},
       Severity::kWarning, "The variable 'foo' was declared but not used.");
   diagnostic_reporter.ReportCompilerError(
       SourceCodeLocation{
-          .source_name = "/some/path/to/file_2.eta", .line = 1, .column = 1},
+          .file = GetStringInterner().Intern("/some/path/to/file_2.eta"),
+          .line = 1,
+          .column = 1},
       Severity::kError, "Invalid symbol present within the source code: '@'.");
   diagnostic_reporter.ReportCompilerError(
       SourceCodeLocation{
-          .source_name = "/some/path/to/file_3.eta", .line = 10, .column = 23},
+          .file = GetStringInterner().Intern("/some/path/to/file_3.eta"),
+          .line = 10,
+          .column = 23},
       Severity::kFatal, "Expected a right operand of the binary operator '+'.");
 
   diagnostic_reporter.OutputCompilerErrors();
@@ -98,3 +108,123 @@ TEST_F(DiagnosticReporterOutputTest, OutputSystemErrorsPrintsCorrectFormat) {
 
   EXPECT_EQ(captured_cout_.str(), expected_output);
 }
+
+TEST_F(DiagnosticReporterOutputTest, MergeAppendsDiagnosticsInOrder) {
+  DiagnosticReporter diagnostic_reporter;
+  DiagnosticReporter other_diagnostic_reporter;
+
+  diagnostic_reporter.ReportCompilerError(
+      SourceCodeLocation{
+          .file = GetStringInterner().Intern("/some/path/to/file.eta"),
+          .line = 1,
+          .column = 2},
+      Severity::kWarning, "First.");
+  other_diagnostic_reporter.ReportCompilerError(
+      SourceCodeLocation{
+          .file = GetStringInterner().Intern("/some/path/to/file.eta"),
+          .line = 7,
+          .column = 3},
+      Severity::kFatal, "Second.");
+
+  diagnostic_reporter.Merge(other_diagnostic_reporter);
+  EXPECT_TRUE(diagnostic_reporter.HasWarnings());
+  EXPECT_FALSE(diagnostic_reporter.HasNormalErrors());
+  EXPECT_TRUE(diagnostic_reporter.HasFatalErrors());
+
+  diagnostic_reporter.OutputCompilerErrors();
+
+  std::string expected_output =
+      "\033[31m[Warning] - [Location]:[Source File: '/some/path/to/file.eta' "
+      "- Line: 1 - Column: 2] - [Message]:First.\033[0m\n"
+      "\033[31m[Fatal] - [Location]:[Source File: '/some/path/to/file.eta' "
+      "- Line: 7 - Column: 3] - [Message]:Second.\033[0m\n";
+
+  EXPECT_EQ(captured_cout_.str(), expected_output);
+}
+
+TEST_F(DiagnosticReporterOutputTest, DeferredMessagesAreFormattedOnOutput) {
+  DiagnosticReporter diagnostic_reporter;
+
+  diagnostic_reporter.ReportCompilerError(
+      SourceCodeLocation{.file = GetStringInterner().Intern("/file.eta"),
+                         .line = 2,
+                         .column = 5,
+                         .offset = 9},
+      Severity::kFatal,
+      DiagnosticMessage{.format = "[E]: The literal '{}' is {{invalid}}.",
+                        .argument = "0x"});
+  diagnostic_reporter.ReportSystemError(
+      Severity::kFatal,
+      DiagnosticMessage{.format = "[E]: Could not open '{}'.",
+                        .argument = "/file.eta"});
+
+  diagnostic_reporter.OutputCompilerErrors();
+  diagnostic_reporter.OutputSystemErrors();
+
+  std::string expected_output =
+      "\033[31m[Fatal] - [Location]:[Source File: '/file.eta' - Line: 2 - "
+      "Column: 5] - [Message]:[E]: The literal '0x' is {invalid}.\033[0m\n"
+      "\033[31m[Fatal] - [Message]:[E]: Could not open '/file.eta'.\033[0m\n";
+
+  EXPECT_EQ(captured_cout_.str(), expected_output);
+}
+
+TEST_F(DiagnosticReporterOutputTest, ErrorLimitSuppressesFurtherErrors) {
+  DiagnosticReporter diagnostic_reporter;
+  diagnostic_reporter.SetErrorLimit(2);
+  SourceCodeLocation location{
+      .file = GetStringInterner().Intern("/file.eta"), .line = 1, .column = 1};
+
+  diagnostic_reporter.ReportCompilerError(location, Severity::kError, "1.");
+  EXPECT_FALSE(diagnostic_reporter.HasReachedErrorLimit());
+  diagnostic_reporter.ReportCompilerError(location, Severity::kError, "2.");
+  EXPECT_TRUE(diagnostic_reporter.HasReachedErrorLimit());
+  diagnostic_reporter.ReportCompilerError(location, Severity::kFatal, "3.");
+  // Warnings are kept past the limit.
+  diagnostic_reporter.ReportCompilerError(location, Severity::kWarning, "4.");
+  diagnostic_reporter.ReportCompilerError(location, Severity::kError, "5.");
+
+  EXPECT_EQ(diagnostic_reporter.GetSuppressedErrorCount(), 2);
+  EXPECT_TRUE(diagnostic_reporter.HasNormalErrors());
+  EXPECT_TRUE(diagnostic_reporter.HasFatalErrors());
+
+  diagnostic_reporter.OutputCompilerErrors();
+
+  std::string expected_output =
+      "\033[31m[Error] - [Location]:[Source File: '/file.eta' - Line: 1 - "
+      "Column: 1] - [Message]:1.\033[0m\n"
+      "\033[31m[Error] - [Location]:[Source File: '/file.eta' - Line: 1 - "
+      "Column: 1] - [Message]:2.\033[0m\n"
+      "\033[31m[Warning] - [Location]:[Source File: '/file.eta' - Line: 1 - "
+      "Column: 1] - [Message]:4.\033[0m\n"
+      "\033[31m[Error] - [Message]:[E]: 2 more errors were found but not "
+      "shown, since the limit of errors per file was reached.\033[0m\n";
+
+  EXPECT_EQ(captured_cout_.str(), expected_output);
+}
+
+TEST(DiagnosticReporterTest, MergeKeepsTheErrorLimit) {
+  DiagnosticReporter diagnostic_reporter;
+  diagnostic_reporter.SetErrorLimit(2);
+  SourceCodeLocation location{
+      .file = GetStringInterner().Intern("/file.eta"), .line = 1, .column = 1};
+
+  // Chunks of a file are reported into reporters without a limit, which are
+  // then merged into the one of the file.
+  DiagnosticReporter first_chunk_reporter;
+  first_chunk_reporter.ReportCompilerError(location, Severity::kError, "1.");
+  DiagnosticReporter second_chunk_reporter;
+  second_chunk_reporter.ReportCompilerError(location, Severity::kError, "2.");
+  second_chunk_reporter.ReportCompilerError(location, Severity::kFatal, "3.");
+
+  diagnostic_reporter.Merge(first_chunk_reporter);
+  diagnostic_reporter.Merge(second_chunk_reporter);
+
+  EXPECT_TRUE(diagnostic_reporter.HasReachedErrorLimit());
+  EXPECT_EQ(diagnostic_reporter.GetSuppressedErrorCount(), 1);
+  EXPECT_TRUE(diagnostic_reporter.HasFatalErrors());
+}
+
+TEST(DiagnosticReporterTest, LocationsAreCompact) {
+  EXPECT_EQ(sizeof(SourceCodeLocation), 20);
+}
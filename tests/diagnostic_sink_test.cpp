@@ -0,0 +1,141 @@
+#include "senbonzakura/diagnostic_sink.hpp"
+
+#include <string>
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include "senbonzakura/diagnostic_reporter.hpp"
+#include "senbonzakura/string_interner.hpp"
+
+class DiagnosticSinkTest : public ::testing::Test {
+protected:
+  int pipe_fds_[2];
+
+  void SetUp() override { ASSERT_EQ(pipe(pipe_fds_), 0); }
+
+  void TearDown() override { close(pipe_fds_[0]); }
+
+  // Closes the write end of the pipe and returns everything written to it.
+  std::string ReadOutput() {
+    close(pipe_fds_[1]);
+    std::string output;
+    char buffer[4096];
+    ssize_t size;
+    while ((size = read(pipe_fds_[0], buffer, sizeof(buffer))) > 0) {
+      output.append(buffer, size);
+    }
+    return output;
+  }
+
+  static void ReportDiagnostics(DiagnosticReporter &diagnostic_reporter) {
+    diagnostic_reporter.ReportCompilerError(
+        SourceCodeLocation{.file = GetStringInterner().Intern("dir/a.eta"),
+                           .line = 2,
+                           .column = 10,
+                           .offset = 9,
+                           .length = 3},
+        Severity::kFatal,
+        DiagnosticMessage{.format = "[E]: Unknown escape '{}'.",
+                          .argument = "\\q"});
+    diagnostic_reporter.ReportSystemError(Severity::kWarning,
+                                          "[W]: Could not \"cache\" it.");
+  }
+};
+
+TEST_F(DiagnosticSinkTest, JsonLinesWritesARecordPerDiagnostic) {
+  JsonLinesDiagnosticSink diagnostic_sink{pipe_fds_[1]};
+  DiagnosticReporter diagnostic_reporter;
+  diagnostic_reporter.SetSink(&diagnostic_sink);
+
+  ReportDiagnostics(diagnostic_reporter);
+  diagnostic_sink.Finish();
+
+  EXPECT_EQ(ReadOutput(),
+            "{\"severity\":\"fatal\",\"file\":\"dir/a.eta\",\"line\":2,"
+            "\"column\":10,\"offset\":9,\"length\":3,\"message\":\"Unknown "
+            "escape '\\\\q'.\"}\n"
+            "{\"severity\":\"warning\",\"message\":\"Could not \\\"cache\\\" "
+            "it.\"}\n");
+  EXPECT_FALSE(diagnostic_sink.HasWriteError());
+}
+
+TEST_F(DiagnosticSinkTest, SarifWritesACompleteLog) {
+  SarifDiagnosticSink diagnostic_sink{pipe_fds_[1]};
+  DiagnosticReporter diagnostic_reporter;
+  diagnostic_reporter.SetSink(&diagnostic_sink);
+
+  ReportDiagnostics(diagnostic_reporter);
+  diagnostic_sink.Finish();
+
+  EXPECT_EQ(
+      ReadOutput(),
+      "{\"version\":\"2.1.0\",\"$schema\":"
+      "\"https://json.schemastore.org/sarif-2.1.0.json\",\"runs\":[{\"tool\":"
+      "{\"driver\":{\"name\":\"senbonzakura\"}},\"columnKind\":"
+      "\"unicodeCodePoints\",\"results\":[\n"
+      "{\"level\":\"error\",\"properties\":{\"severity\":\"fatal\"},"
+      "\"message\":{\"text\":\"Unknown escape '\\\\q'.\"},\"locations\":[{"
+      "\"physicalLocation\":{\"artifactLocation\":{\"uri\":\"dir/a.eta\"},"
+      "\"region\":{\"startLine\":2,\"startColumn\":10,\"byteOffset\":9,"
+      "\"byteLength\":3}}}]},\n"
+      "{\"level\":\"warning\",\"properties\":{\"severity\":\"warning\"},"
+      "\"message\":{\"text\":\"Could not \\\"cache\\\" it.\"}}\n"
+      "]}]}\n");
+}
+
+TEST_F(DiagnosticSinkTest, StreamsMergedButNotSuppressedDiagnostics) {
+  JsonLinesDiagnosticSink diagnostic_sink{pipe_fds_[1]};
+  DiagnosticReporter diagnostic_reporter;
+  diagnostic_reporter.SetSink(&diagnostic_sink);
+  diagnostic_reporter.SetErrorLimit(1);
+  SourceCodeLocation location{.file = GetStringInterner().Intern("a.eta"),
+                              .line = 1,
+                              .column = 1};
+
+  DiagnosticReporter chunk_diagnostic_reporter;
+  chunk_diagnostic_reporter.ReportCompilerError(location, Severity::kError,
+                                                "First.");
+  chunk_diagnostic_reporter.ReportCompilerError(location, Severity::kError,
+                                                "Second.");
+  diagnostic_reporter.Merge(chunk_diagnostic_reporter);
+
+  EXPECT_EQ(ReadOutput(),
+            "{\"severity\":\"error\",\"file\":\"a.eta\",\"line\":1,"
+            "\"column\":1,\"offset\":0,\"length\":0,\"message\":\"First.\"}\n");
+}
+
+TEST_F(DiagnosticSinkTest, StreamsTheNumberOfSuppressedErrors) {
+  JsonLinesDiagnosticSink diagnostic_sink{pipe_fds_[1]};
+  DiagnosticReporter diagnostic_reporter;
+  diagnostic_reporter.SetSink(&diagnostic_sink);
+  diagnostic_reporter.SetErrorLimit(1);
+  SourceCodeLocation location{.file = GetStringInterner().Intern("a.eta"),
+                              .line = 1,
+                              .column = 1};
+
+  diagnostic_reporter.StreamSuppressedErrorCount("a.eta");
+  for (int i = 0; i < 3; i++) {
+    diagnostic_reporter.ReportCompilerError(location, Severity::kError,
+                                            "Error.");
+  }
+  diagnostic_reporter.StreamSuppressedErrorCount("a.eta");
+
+  EXPECT_EQ(ReadOutput(),
+            "{\"severity\":\"error\",\"file\":\"a.eta\",\"line\":1,"
+            "\"column\":1,\"offset\":0,\"length\":0,\"message\":\"Error.\"}\n"
+            "{\"severity\":\"error\",\"message\":\"2 more errors were found in "
+            "'a.eta' but not shown, since the limit of errors per file was "
+            "reached.\"}\n");
+}
+
+TEST_F(DiagnosticSinkTest, ReportsWriteErrors) {
+  JsonLinesDiagnosticSink diagnostic_sink{pipe_fds_[0]};
+  DiagnosticReporter diagnostic_reporter;
+  diagnostic_reporter.SetSink(&diagnostic_sink);
+
+  diagnostic_reporter.ReportSystemError(Severity::kError, "[E]: Lost.");
+
+  EXPECT_TRUE(diagnostic_sink.HasWriteError());
+  close(pipe_fds_[1]);
+}
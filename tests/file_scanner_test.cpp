@@ -1,4 +1,5 @@
 #include "senbonzakura/file_scanner.hpp"
+#include "senbonzakura/token.hpp"
 
 #include <filesystem>
 #include <fstream>
@@ -76,3 +77,35 @@ TEST_F(FileScannerTest, FileScannerScanFileFailureOpenFileFTest) {
 
   EXPECT_TRUE(diagnostic_reporter.HasFatalErrors());
 }
+
+TEST_F(FileScannerTest, FileScannerScanFileContentTest) {
+  std::string filename = "test_2.eta";
+  std::string file_content = "use io\nmain() {\n  println(\"Hello\")\n}\n";
+
+  CreateTestFile(filename, file_content);
+
+  FileScanner file_scanner{temp_dir_path_ + "/" + filename,
+                           diagnostic_reporter_};
+
+  file_scanner.ScanFile();
+
+  EXPECT_EQ(file_scanner.GetFileContentBytes(), file_content);
+  EXPECT_EQ(file_scanner.GetFileContentBytes().data()[file_content.size()],
+            '\0');
+}
+
+TEST_F(FileScannerTest, FileScannerScanFileFailureTooLargeFileTest) {
+  std::string filename = "test_3.eta";
+  CreateTestFile(filename, "");
+  // The file is sparse, so it takes no space, and it is rejected before being
+  // read.
+  std::filesystem::resize_file(temp_dir_path_ + "/" + filename,
+                               Token::kMaxSourceSize + 1);
+
+  FileScanner file_scanner{temp_dir_path_ + "/" + filename,
+                           diagnostic_reporter_};
+  file_scanner.ScanFile();
+
+  EXPECT_TRUE(file_scanner.GetDiagnosticReporter().HasFatalErrors());
+  EXPECT_TRUE(file_scanner.GetFileContentBytes().empty());
+}
@@ -1,9 +1,20 @@
 #include "senbonzakura/file_writer.hpp"
+#include "senbonzakura/ast.hpp"
+#include "senbonzakura/diagnostic_reporter.hpp"
+#include "senbonzakura/lexedb.hpp"
+#include "senbonzakura/lexer.hpp"
+#include "senbonzakura/line_table.hpp"
+#include "senbonzakura/parser.hpp"
+#include "senbonzakura/string_interner.hpp"
 #include "senbonzakura/token.hpp"
+#include "senbonzakura/token_stream.hpp"
 #include "senbonzakura/token_type.hpp"
 
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
 #include <fstream>
+#include <iterator>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -26,6 +37,32 @@ protected:
     // Clean the temporary directory and its contents.
     std::filesystem::remove_all(temp_output_dir_path_);
   }
+
+  std::string ReadOutputFile(const std::string &file_name) {
+    std::ifstream input_file_stream{temp_output_dir_path_ + "/" + file_name};
+    return std::string{(std::istreambuf_iterator<char>(input_file_stream)),
+                       std::istreambuf_iterator<char>()};
+  }
+
+  // Writes the '.parsed' output of 'source_code', which must parse without
+  // errors, and returns it.
+  std::string WriteParsedSourceCode(const std::string &source_code,
+                                    bool is_pretty_printed) {
+    std::vector<std::string> programs_filepaths{"/home/user/parsed.eta"};
+    FileWriter file_writer{programs_filepaths, temp_output_dir_path_};
+    DiagnosticReporter diagnostic_reporter;
+    Lexer lexer{programs_filepaths[0], source_code, diagnostic_reporter};
+    SpanTokenStream token_stream{lexer.LexTokens()};
+    Parser parser{programs_filepaths[0], source_code, token_stream,
+                  diagnostic_reporter};
+    Ast ast = parser.Parse();
+    EXPECT_FALSE(diagnostic_reporter.HasNormalErrors());
+
+    file_writer.WriteParserOutput(programs_filepaths[0], ast,
+                                  is_pretty_printed);
+
+    return ReadOutputFile("parsed.eta.parsed");
+  }
 };
 
 TEST_F(FileWriterTest, FileWriterConstructorTest) {
@@ -42,16 +79,17 @@ TEST_F(FileWriterTest, WriteLexerOutputSuccessTest) {
   std::vector<std::string> programs_filepaths{"/home/user/test_1.eta"};
   FileWriter file_writer{programs_filepaths, temp_output_dir_path_};
 
+  std::string source_code = "foo:int=9";
   std::vector<Token> tokens{
-      Token{1, 1, TokenType::kIdentifier, {}, "foo"},
-      Token{1, 4, TokenType::kColon, {}, ":"},
-      Token{1, 5, TokenType::kInt, {}, "int"},
-      Token{1, 8, TokenType::kEqual, {}, "="},
-      Token{1, 9, TokenType::kInteger, 9, "9"},
-      Token{1, 10, TokenType::kFileEnd, {}, ""},
+      Token{TokenType::kIdentifier, 0, 3},
+      Token{TokenType::kColon, 3, 1},
+      Token{TokenType::kInt, 4, 3},
+      Token{TokenType::kEqual, 7, 1},
+      Token{TokenType::kInteger, 8, 1, {.integer_value = 9}},
+      Token{TokenType::kFileEnd, 9, 0},
   };
 
-  file_writer.WriteLexerOutput(programs_filepaths[0], tokens);
+  file_writer.WriteLexerOutput(programs_filepaths[0], tokens, source_code);
 
   std::filesystem::path output_file_path =
       std::filesystem::path(temp_output_dir_path_) / "test_1.eta.lexed";
@@ -73,6 +111,69 @@ TEST_F(FileWriterTest, WriteLexerOutputSuccessTest) {
   EXPECT_EQ(produced_output, expected_output);
 }
 
+TEST_F(FileWriterTest, WriteLexerOutputMatchesTokenToStringTest) {
+  std::vector<std::string> programs_filepaths{"/home/user/test_2.eta"};
+  FileWriter file_writer{programs_filepaths, temp_output_dir_path_};
+
+  // Large enough for the output to be written in several blocks.
+  std::string source_code;
+  std::vector<Token> tokens;
+  for (int i = 0; i < 50000; i++) {
+    std::uint32_t offset = source_code.length();
+    source_code += "\n\n  foo = 12345\n";
+    tokens.emplace_back(TokenType::kIdentifier, offset + 4, 3);
+    tokens.emplace_back(TokenType::kEqual, offset + 8, 1);
+    tokens.emplace_back(TokenType::kInteger, offset + 10, 5,
+                        TokenValue{.integer_value = 12345});
+  }
+  tokens.emplace_back(TokenType::kFileEnd, source_code.length(), 0);
+
+  file_writer.WriteLexerOutput(programs_filepaths[0], tokens, source_code);
+
+  LineTable line_table{source_code};
+  std::string expected_output;
+  for (const Token &token : tokens) {
+    expected_output += TokenToString(token, source_code, line_table) + "\n";
+  }
+
+  std::ifstream input_file_stream{std::filesystem::path(temp_output_dir_path_) /
+                                  "test_2.eta.lexed"};
+  std::string produced_output{
+      (std::istreambuf_iterator<char>(input_file_stream)),
+      std::istreambuf_iterator<char>()};
+
+  EXPECT_GT(produced_output.size(), 1 << 20);
+  EXPECT_EQ(produced_output, expected_output);
+}
+
+TEST_F(FileWriterTest, WriteLexedbOutputSuccessTest) {
+  std::vector<std::string> programs_filepaths{"/home/user/test_3.eta"};
+  FileWriter file_writer{programs_filepaths, temp_output_dir_path_};
+
+  std::string source_code = "foo:int=9";
+  std::vector<Token> tokens{
+      Token{TokenType::kIdentifier, 0, 3},
+      Token{TokenType::kColon, 3, 1},
+      Token{TokenType::kInt, 4, 3},
+      Token{TokenType::kEqual, 7, 1},
+      Token{TokenType::kInteger, 8, 1, {.integer_value = 9}},
+      Token{TokenType::kFileEnd, 9, 0},
+  };
+
+  file_writer.WriteLexedbOutput(programs_filepaths[0], tokens, source_code);
+
+  std::filesystem::path output_file_path =
+      std::filesystem::path(temp_output_dir_path_) / "test_3.eta.lexedb";
+  ASSERT_TRUE(std::filesystem::exists(output_file_path));
+
+  std::ifstream input_file_stream{output_file_path, std::ios::binary};
+  std::string produced_output{
+      (std::istreambuf_iterator<char>(input_file_stream)),
+      std::istreambuf_iterator<char>()};
+
+  EXPECT_EQ(produced_output, SerializeLexedb(tokens, source_code));
+}
+
 TEST_F(FileWriterTest, WriteLexerOutputFailureOutputDirPathDoesntExistTest) {
   std::vector<std::string> programs_filepaths{"test_1.eta"};
 
@@ -81,7 +182,7 @@ TEST_F(FileWriterTest, WriteLexerOutputFailureOutputDirPathDoesntExistTest) {
 
   std::vector<Token> tokens;
 
-  EXPECT_THROW(file_writer.WriteLexerOutput(programs_filepaths[0], tokens),
+  EXPECT_THROW(file_writer.WriteLexerOutput(programs_filepaths[0], tokens, ""),
                std::runtime_error);
 }
 
@@ -94,8 +195,114 @@ TEST_F(FileWriterTest, WriteLexerOutputFailureOutputDirPathIsNotDirectoryTest) {
   FileWriter file_writer{programs_filepaths, temp_file_path};
   std::vector<Token> tokens;
 
-  ASSERT_THROW(file_writer.WriteLexerOutput(programs_filepaths[0], tokens),
+  ASSERT_THROW(file_writer.WriteLexerOutput(programs_filepaths[0], tokens, ""),
                std::runtime_error);
 
   std::filesystem::remove(temp_file_path);
 }
+
+TEST_F(FileWriterTest, WriteParserOutputWritesSExpressionsTest) {
+  std::string source_code = "use io\n"
+                            "main(args: int[][]) {\n"
+                            "  print(\"Hello, \\\"World\\\"!\\n\")\n"
+                            "  c3po: int = 'x' + 47;\n"
+                            "  r2d2: int = c3po // No Han Solo\n"
+                            "}\n";
+
+  EXPECT_EQ(WriteParsedSourceCode(source_code, false),
+            "(((use io)) ((main ((args ([] ([] int)))) () ((print "
+            "\"Hello, \\\"World\\\"!\\n\") (= (c3po int) (+ 'x' 47)) "
+            "(= (r2d2 int) c3po)))))\n");
+}
+
+TEST_F(FileWriterTest, WriteParserOutputWritesEveryConstructTest) {
+  std::string source_code = "n: int = -3\n"
+                            "c: int = '\\''\n"
+                            "foo(): bool, int {\n"
+                            "  expr: int = 1 - 2 * 3 * -4 * 5\n"
+                            "  if (expr <= 47) { } else pred = !pred\n"
+                            "  while i < length(a) a[i] = {1, 0,}\n"
+                            "  x: int, y: bool\n"
+                            "  return pred, expr;\n"
+                            "}\n"
+                            "bar() {\n"
+                            "  _, i: int = foo()\n"
+                            "  b: int[i][]\n"
+                            "}\n";
+
+  EXPECT_EQ(WriteParsedSourceCode(source_code, false),
+            "(() ((:global n int -3) (:global c int '\\'') "
+            "(foo () (bool int) ((= (expr int) (- 1 (* (* (* 2 3) (- 4)) 5))) "
+            "(if (<= expr 47) () (= pred (! pred))) "
+            "(while (< i (length a)) (= ([] a i) (1 0))) "
+            "(x int) (y bool) (return pred expr))) "
+            "(bar () () ((= (_ (i int)) (foo)) (b ([] ([] int) i))))))\n");
+}
+
+TEST_F(FileWriterTest, WriteParserOutputPrettyPrintsStatementsTest) {
+  std::string source_code = "use io\n"
+                            "f(a: int) {\n"
+                            "  if a > 0 { g(a) }\n"
+                            "  return\n"
+                            "}\n"
+                            "g(a: int) {}\n";
+
+  EXPECT_EQ(WriteParsedSourceCode(source_code, true),
+            "(((use io))\n"
+            "  ((f ((a int)) ()\n"
+            "      ((if (> a 0)\n"
+            "          ((g a)))\n"
+            "        (return)))\n"
+            "    (g ((a int)) ()\n"
+            "      ())))\n");
+}
+
+TEST_F(FileWriterTest, WriteParserOutputWritesDeeplyNestedTreesTest) {
+  // Far deeper than the parser accepts, and than a recursive writer could
+  // handle.
+  constexpr std::size_t kDepth = 1'000'000;
+  Ast ast;
+  AstIndex expression = ast.AddNode(AstNodeKind::kInteger, 0);
+  ast.GetNode(expression).integer_value = 1;
+  for (std::size_t depth = 0; depth < kDepth; depth++) {
+    expression = ast.AddPairNode(AstNodeKind::kUnary, 0, expression);
+    ast.GetNode(expression).operator_type = TokenType::kBang;
+  }
+  AstIndex target = ast.AddNode(AstNodeKind::kDiscard, 0);
+  AstIndex assignment = ast.AddAssignment(0, std::vector<AstIndex>{target},
+                                          std::vector<AstIndex>{expression});
+  AstIndex body = ast.AddRangeNode(AstNodeKind::kBlock, 0,
+                                   std::vector<AstIndex>{assignment});
+  AstIndex function = ast.AddFunction(
+      0, GetStringInterner().Intern("deep"), {}, {}, body);
+  ast.SetRoot(ast.AddRangeNode(AstNodeKind::kProgram, 0,
+                               std::vector<AstIndex>{function}));
+  std::vector<std::string> programs_filepaths{"deep.eta"};
+  FileWriter file_writer{programs_filepaths, temp_output_dir_path_};
+
+  file_writer.WriteParserOutput(programs_filepaths[0], ast, false);
+
+  std::string nested_expression;
+  for (std::size_t depth = 0; depth < kDepth; depth++) {
+    nested_expression += "(! ";
+  }
+  nested_expression += "1";
+  nested_expression.append(kDepth, ')');
+  EXPECT_EQ(ReadOutputFile("deep.eta.parsed"),
+            "(() ((deep () () ((= _ " + nested_expression + ")))))\n");
+}
+
+TEST_F(FileWriterTest, WriteParserErrorWritesTheLocationAndMessageTest) {
+  std::vector<std::string> programs_filepaths{"/home/user/invalid.eta"};
+  FileWriter file_writer{programs_filepaths, temp_output_dir_path_};
+  CompilerError compiler_error{
+      .message = DiagnosticMessage{.format = "[E]: Unexpected token {}.",
+                                   .argument = "'+'"},
+      .location = SourceCodeLocation{.file = {}, .line = 1, .column = 2},
+      .severity = Severity::kError};
+
+  file_writer.WriteParserError(programs_filepaths[0], compiler_error);
+
+  EXPECT_EQ(ReadOutputFile("invalid.eta.parsed"),
+            "1:2 error:Unexpected token '+'.\n");
+}
@@ -0,0 +1,26 @@
+#include "senbonzakura/json.hpp"
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+TEST(JsonTest, AppendsAQuotedString) {
+  std::string output = "[";
+  AppendJsonString(output, "main.eta");
+
+  EXPECT_EQ(output, "[\"main.eta\"");
+}
+
+TEST(JsonTest, EscapesQuotesBackslashesAndControlCharacters) {
+  std::string output;
+  AppendJsonString(output, "a\"b\\c\nd\te\x01");
+
+  EXPECT_EQ(output, "\"a\\\"b\\\\c\\nd\\te\\u0001\"");
+}
+
+TEST(JsonTest, CopiesUtf8AsItIs) {
+  std::string output;
+  AppendJsonString(output, "s\xC3\xA3o");
+
+  EXPECT_EQ(output, "\"s\xC3\xA3o\"");
+}
@@ -0,0 +1,32 @@
+#include "senbonzakura/keywords.hpp"
+#include "senbonzakura/token_type.hpp"
+
+#include <string_view>
+
+#include <gtest/gtest.h>
+
+TEST(KeywordsTest, LookupKeywordRecognizesEveryKeyword) {
+  for (const Keyword &keyword : kKeywords) {
+    EXPECT_EQ(LookupKeyword(keyword.lexeme), keyword.token_type)
+        << keyword.lexeme;
+  }
+}
+
+TEST(KeywordsTest, LookupKeywordIsUsableAtCompileTime) {
+  static_assert(LookupKeyword("while") == TokenType::kWhile);
+  static_assert(LookupKeyword("whilst") == TokenType::kIdentifier);
+}
+
+TEST(KeywordsTest, LookupKeywordRejectsIdentifiers) {
+  for (std::string_view identifier :
+       {"i", "x", "in", "ints", "iff", "lengths", "use'", "True", "els",
+        "elsewhere", "return_", "fals", "bole", "wile", "lnegth", "a"}) {
+    EXPECT_EQ(LookupKeyword(identifier), TokenType::kIdentifier) << identifier;
+  }
+}
+
+TEST(KeywordsTest, LookupKeywordDoesNotReadPastTheLexeme) {
+  std::string_view source = "interface";
+  EXPECT_EQ(LookupKeyword(source.substr(0, 3)), TokenType::kInt);
+  EXPECT_EQ(LookupKeyword(source.substr(0, 5)), TokenType::kIdentifier);
+}
@@ -0,0 +1,196 @@
+#include "senbonzakura/lexedb.hpp"
+
+#include "senbonzakura/diagnostic_reporter.hpp"
+#include "senbonzakura/lexer.hpp"
+#include "senbonzakura/line_table.hpp"
+#include "senbonzakura/parser.hpp"
+#include "senbonzakura/token.hpp"
+#include "senbonzakura/token_stream.hpp"
+#include "senbonzakura/token_type.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+class LexedbTest : public ::testing::Test {
+protected:
+  std::string temp_dir_path_;
+  std::string lexedb_file_path_;
+  DiagnosticReporter diagnostic_reporter_;
+
+  void SetUp() override {
+    temp_dir_path_ =
+        std::filesystem::temp_directory_path().string() + "/test_lexedb_dir";
+    std::filesystem::create_directory(temp_dir_path_);
+    lexedb_file_path_ = temp_dir_path_ + "/file.eta.lexedb";
+  }
+
+  void TearDown() override { std::filesystem::remove_all(temp_dir_path_); }
+
+  void WriteFile(std::string_view content) {
+    std::ofstream file{lexedb_file_path_, std::ios::binary};
+    file.write(content.data(), content.size());
+
+    return;
+  }
+};
+
+TEST_F(LexedbTest, RoundTripsLexedTokens) {
+  std::string source_code = "use io\n"
+                            "main(args: int[][]) {\n"
+                            "  s: int[] = \"a\\tb\"; c: int = '\\n'\n"
+                            "  x: int = 9223372036854775808 + args[0][0]\n"
+                            "  if (true & !false) { print(s) }\n"
+                            "  print(\"a\\tb\")\n"
+                            "}\n";
+  Lexer lexer{"file.eta", source_code, diagnostic_reporter_};
+  std::vector<Token> tokens = lexer.LexTokens();
+  WriteFile(SerializeLexedb(tokens, source_code));
+
+  LexedbReader lexedb_reader;
+  ASSERT_TRUE(lexedb_reader.Load(lexedb_file_path_, diagnostic_reporter_));
+
+  LineTable line_table{source_code};
+  EXPECT_EQ(lexedb_reader.GetSourceSize(), source_code.length());
+  EXPECT_EQ(lexedb_reader.GetLineCount(), line_table.GetLineCount());
+  ASSERT_EQ(lexedb_reader.GetTokenCount(), tokens.size());
+  for (std::size_t i = 0; i < tokens.size(); i++) {
+    Token token = lexedb_reader.GetToken(i);
+    EXPECT_EQ(token, tokens[i]);
+    EXPECT_EQ(lexedb_reader.Resolve(token.offset_),
+              line_table.Resolve(tokens[i].offset_));
+
+    switch (token.token_type_) {
+    case (TokenType::kIdentifier):
+    case (TokenType::kString):
+      EXPECT_EQ(token.value_.symbol_value, tokens[i].value_.symbol_value);
+      break;
+    case (TokenType::kInteger):
+      EXPECT_EQ(token.value_.integer_value, tokens[i].value_.integer_value);
+      break;
+    case (TokenType::kCharacter):
+      EXPECT_EQ(token.value_.character_value,
+                tokens[i].value_.character_value);
+      break;
+    case (TokenType::kTrue):
+    case (TokenType::kFalse):
+      EXPECT_EQ(token.value_.boolean_value, tokens[i].value_.boolean_value);
+      break;
+    default:
+      break;
+    }
+  }
+  EXPECT_EQ(lexedb_reader.Resolve(source_code.length()),
+            line_table.Resolve(source_code.length()));
+}
+
+TEST_F(LexedbTest, StoresEveryDistinctStringOnce) {
+  std::string source_code = "foo bar foo \"foo\" \"a\\nb\"";
+  Lexer lexer{"file.eta", source_code, diagnostic_reporter_};
+  WriteFile(SerializeLexedb(lexer.LexTokens(), source_code));
+
+  LexedbReader lexedb_reader;
+  ASSERT_TRUE(lexedb_reader.Load(lexedb_file_path_, diagnostic_reporter_));
+
+  ASSERT_EQ(lexedb_reader.GetStringCount(), 3);
+  EXPECT_EQ(lexedb_reader.GetString(0), "foo");
+  EXPECT_EQ(lexedb_reader.GetString(1), "bar");
+  EXPECT_EQ(lexedb_reader.GetString(2), "a\nb");
+}
+
+TEST_F(LexedbTest, FeedsTokensToATokenCursor) {
+  std::string source_code = "x = 1";
+  Lexer lexer{"file.eta", source_code, diagnostic_reporter_};
+  WriteFile(SerializeLexedb(lexer.LexTokens(), source_code));
+
+  LexedbReader lexedb_reader;
+  ASSERT_TRUE(lexedb_reader.Load(lexedb_file_path_, diagnostic_reporter_));
+  LexedbTokenStream token_stream{lexedb_reader};
+  TokenCursor token_cursor{token_stream};
+
+  EXPECT_EQ(token_cursor.Peek(2).token_type_, TokenType::kInteger);
+  EXPECT_EQ(token_cursor.Advance().token_type_, TokenType::kIdentifier);
+  EXPECT_EQ(token_cursor.Advance().token_type_, TokenType::kEqual);
+  EXPECT_EQ(token_cursor.Advance().value_.integer_value, 1);
+  EXPECT_TRUE(token_cursor.IsAtEnd());
+  EXPECT_EQ(token_cursor.Advance().token_type_, TokenType::kFileEnd);
+  EXPECT_EQ(token_cursor.Advance().token_type_, TokenType::kFileEnd);
+}
+
+TEST_F(LexedbTest, EndsTokensCutShortByALexicalError) {
+  std::string source_code = "main() {\n  x: int = 1\n  y = @\n}\n";
+  Lexer lexer{"file.eta", source_code, diagnostic_reporter_};
+  std::vector<Token> tokens = lexer.LexTokens();
+  ASSERT_TRUE(diagnostic_reporter_.HasFatalErrors());
+  ASSERT_NE(tokens.back().token_type_, TokenType::kFileEnd);
+  WriteFile(SerializeLexedb(tokens, source_code));
+
+  LexedbReader lexedb_reader;
+  ASSERT_TRUE(lexedb_reader.Load(lexedb_file_path_, diagnostic_reporter_));
+  ASSERT_EQ(lexedb_reader.GetTokenCount(), tokens.size() + 1);
+  Token file_end = lexedb_reader.GetToken(tokens.size());
+  EXPECT_EQ(file_end.token_type_, TokenType::kFileEnd);
+  EXPECT_EQ(file_end.offset_, tokens.back().offset_ + tokens.back().length_);
+
+  // The parser reaches the end of the stream instead of looping on its last
+  // token.
+  LexedbTokenStream token_stream{lexedb_reader};
+  Parser parser{"file.eta", source_code, token_stream, diagnostic_reporter_};
+  parser.Parse();
+  EXPECT_GT(parser.GetSyntaxErrorCount(), 0);
+  EXPECT_EQ(token_stream.NextToken().token_type_, TokenType::kFileEnd);
+}
+
+TEST_F(LexedbTest, RejectsInvalidFiles) {
+  std::string source_code = "x = 1";
+  Lexer lexer{"file.eta", source_code, diagnostic_reporter_};
+  std::string lexedb = SerializeLexedb(lexer.LexTokens(), source_code);
+
+  std::vector<std::string> invalid_files{
+      lexedb.substr(0, 16),
+      lexedb.substr(0, lexedb.size() - 1),
+      lexedb,
+      lexedb,
+      lexedb,
+      lexedb,
+      lexedb,
+  };
+  invalid_files[2][0] = 'X';
+  std::uint32_t version = kLexedbVersion + 1;
+  std::memcpy(invalid_files[3].data() + 8, &version, sizeof(version));
+  // The token records start right after the header. The first one is moved
+  // past the source code, then given an unknown type, and the last one, which
+  // is the 'kFileEnd' record, is turned into an '='.
+  std::size_t first_record = sizeof(LexedbHeader);
+  std::size_t last_record = first_record + 3 * sizeof(LexedbTokenRecord);
+  std::uint32_t offset = 1000;
+  std::memcpy(invalid_files[4].data() + first_record, &offset, sizeof(offset));
+  invalid_files[5][first_record + offsetof(LexedbTokenRecord, token_type)] =
+      static_cast<char>(200);
+  invalid_files[6][last_record + offsetof(LexedbTokenRecord, token_type)] =
+      static_cast<char>(TokenType::kEqual);
+
+  for (const std::string &invalid_file : invalid_files) {
+    DiagnosticReporter diagnostic_reporter;
+    WriteFile(invalid_file);
+
+    LexedbReader lexedb_reader;
+    EXPECT_FALSE(lexedb_reader.Load(lexedb_file_path_, diagnostic_reporter));
+    EXPECT_TRUE(diagnostic_reporter.HasFatalErrors());
+  }
+}
+
+TEST_F(LexedbTest, ReportsMissingFiles) {
+  LexedbReader lexedb_reader;
+
+  EXPECT_FALSE(lexedb_reader.Load(temp_dir_path_ + "/missing.eta.lexedb",
+                                  diagnostic_reporter_));
+  EXPECT_TRUE(diagnostic_reporter_.HasFatalErrors());
+}
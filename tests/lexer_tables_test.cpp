@@ -0,0 +1,70 @@
+#include "senbonzakura/lexer_tables.hpp"
+#include "senbonzakura/token_type.hpp"
+
+#include <cstdint>
+#include <string_view>
+
+#include <gtest/gtest.h>
+
+namespace {
+
+// Runs the punctuator DFA over the whole input and returns the final state.
+std::uint8_t RunPunctuatorDfa(std::string_view input) {
+  std::uint8_t state = PunctuatorDfa::kStartState;
+  for (char c : input) {
+    state = kPunctuatorDfa.Next(state, c);
+  }
+  return state;
+}
+
+} // namespace
+
+TEST(LexerTablesTest, CharClassTableClassifiesEveryCategory) {
+  EXPECT_EQ(kCharClassTable['a'], CharClass::kAlpha);
+  EXPECT_EQ(kCharClassTable['Z'], CharClass::kAlpha);
+  EXPECT_EQ(kCharClassTable['7'], CharClass::kDigit);
+  EXPECT_EQ(kCharClassTable[' '], CharClass::kWhitespace);
+  EXPECT_EQ(kCharClassTable['\t'], CharClass::kWhitespace);
+  EXPECT_EQ(kCharClassTable['\r'], CharClass::kWhitespace);
+  EXPECT_EQ(kCharClassTable['\n'], CharClass::kNewline);
+  EXPECT_EQ(kCharClassTable['\"'], CharClass::kDoubleQuote);
+  EXPECT_EQ(kCharClassTable['\''], CharClass::kSingleQuote);
+  EXPECT_EQ(kCharClassTable['\0'], CharClass::kSentinel);
+  EXPECT_EQ(kCharClassTable['_'], CharClass::kPunctuator);
+  EXPECT_EQ(kCharClassTable['*'], CharClass::kPunctuator);
+  EXPECT_EQ(kCharClassTable['@'], CharClass::kInvalid);
+  EXPECT_EQ(kCharClassTable[0xE9], CharClass::kInvalid);
+}
+
+TEST(LexerTablesTest, IdentifierPartTableAcceptsEtaIdentifierCharacters) {
+  for (char c : std::string_view{"azAZ09_'"}) {
+    EXPECT_TRUE(kIdentifierPartTable[static_cast<unsigned char>(c)]) << c;
+  }
+  for (char c : std::string_view{" \n-*\"(@"}) {
+    EXPECT_FALSE(kIdentifierPartTable[static_cast<unsigned char>(c)]) << c;
+  }
+  EXPECT_FALSE(kIdentifierPartTable['\0']);
+}
+
+TEST(LexerTablesTest, PunctuatorDfaRecognizesEveryPunctuator) {
+  for (const Punctuator &punctuator : kPunctuators) {
+    std::uint8_t state = RunPunctuatorDfa(punctuator.lexeme);
+    ASSERT_NE(state, PunctuatorDfa::kRejectState) << punctuator.lexeme;
+    EXPECT_EQ(kPunctuatorDfa.actions[state], punctuator.action);
+    if (punctuator.action == PunctuatorAction::kToken) {
+      EXPECT_EQ(kPunctuatorDfa.token_types[state], punctuator.token_type);
+    }
+  }
+}
+
+TEST(LexerTablesTest, PunctuatorDfaRejectsIncompletePunctuators) {
+  // "*>" is only a prefix of "*>>", so the lexer must back up to '*'.
+  std::uint8_t state = RunPunctuatorDfa("*>");
+  ASSERT_NE(state, PunctuatorDfa::kRejectState);
+  EXPECT_EQ(kPunctuatorDfa.actions[state], PunctuatorAction::kNone);
+
+  EXPECT_EQ(RunPunctuatorDfa("=>"), PunctuatorDfa::kRejectState);
+  EXPECT_EQ(RunPunctuatorDfa("+a"), PunctuatorDfa::kRejectState);
+  EXPECT_EQ(kPunctuatorDfa.Next(PunctuatorDfa::kStartState, '\0'),
+            PunctuatorDfa::kRejectState);
+}
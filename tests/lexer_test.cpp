@@ -1,15 +1,33 @@
 #include "senbonzakura/diagnostic_reporter.hpp"
 #include "senbonzakura/file_scanner.hpp"
 #include "senbonzakura/lexer.hpp"
+#include "senbonzakura/line_table.hpp"
+#include "senbonzakura/string_interner.hpp"
 #include "senbonzakura/token.hpp"
 #include "senbonzakura/token_type.hpp"
 
+#include <cstdint>
 #include <filesystem>
 #include <fstream>
 #include <string>
 
 #include <gtest/gtest.h>
 
+// Token along with the line and column numbers resolved from its offset, so
+// that the tests keep checking the positions that tokens no longer store.
+struct LocatedToken {
+  LocatedToken(std::uint32_t line, std::uint32_t column, TokenType token_type,
+               std::uint32_t offset, std::uint32_t length,
+               TokenValue value = {})
+      : position{line, column}, token{token_type, offset, length, value} {}
+  LocatedToken(LineColumn position, Token token)
+      : position{position}, token{token} {}
+  bool operator==(const LocatedToken &other) const = default;
+
+  LineColumn position;
+  Token token;
+};
+
 class LexerTest : public ::testing::Test {
 protected:
   std::string temp_dir_path_;
@@ -34,7 +52,7 @@ protected:
     std::cout.rdbuf(original_cout_buffer_);
   }
 
-  std::vector<Token> LexSourceCode(const std::string &filename,
+  std::vector<LocatedToken> LexSourceCode(const std::string &filename,
                                    const std::string &file_content_bytes) {
     temp_lexer_filepath_ = temp_dir_path_ + "/" + filename;
     std::ofstream file{temp_lexer_filepath_};
@@ -48,45 +66,51 @@ protected:
     Lexer lexer{temp_lexer_filepath_, file_scanner.GetFileContentBytes(),
                 diagnostic_reporter_};
 
-    return lexer.LexTokens();
+    LineTable line_table{file_scanner.GetFileContentBytes()};
+    std::vector<LocatedToken> located_tokens;
+    for (const Token &token : lexer.LexTokens()) {
+      located_tokens.emplace_back(line_table.Resolve(token.offset_), token);
+    }
+
+    return located_tokens;
   }
 };
 
 TEST_F(LexerTest, LexesWithEmptySourceCode) {
   std::string file_content_bytes = "";
-  std::vector<Token> tokens =
+  std::vector<LocatedToken> tokens =
       LexSourceCode("test_empty_source_code.eta", file_content_bytes);
 
   EXPECT_EQ(tokens.size(), 1);
-  EXPECT_EQ(tokens[0].token_type_, TokenType::kFileEnd);
+  EXPECT_EQ(tokens[0].token.token_type_, TokenType::kFileEnd);
 }
 
 TEST_F(LexerTest, LexesWithOnlySingleCharacterTokensInSourceCode) {
   std::string file_content_bytes = "(){}[],:;+-%*/_=!><";
-  std::vector<Token> output_tokens =
+  std::vector<LocatedToken> output_tokens =
       LexSourceCode("test_single_character_tokens.eta", file_content_bytes);
 
-  std::vector<Token> expected_tokens{
-      Token{1, 1, TokenType::kLeftParen, {}, "("},
-      Token{1, 2, TokenType::kRightParen, {}, ")"},
-      Token{1, 3, TokenType::kLeftBracket, {}, "{"},
-      Token{1, 4, TokenType::kRightBracket, {}, "}"},
-      Token{1, 5, TokenType::kLeftSquareBracket, {}, "["},
-      Token{1, 6, TokenType::kRightSquareBracket, {}, "]"},
-      Token{1, 7, TokenType::kComma, {}, ","},
-      Token{1, 8, TokenType::kColon, {}, ":"},
-      Token{1, 9, TokenType::kSemiColon, {}, ";"},
-      Token{1, 10, TokenType::kPlus, {}, "+"},
-      Token{1, 11, TokenType::kMinus, {}, "-"},
-      Token{1, 12, TokenType::kRemainder, {}, "%"},
-      Token{1, 13, TokenType::kStar, {}, "*"},
-      Token{1, 14, TokenType::kSlash, {}, "/"},
-      Token{1, 15, TokenType::kUnderscore, {}, "_"},
-      Token{1, 16, TokenType::kEqual, {}, "="},
-      Token{1, 17, TokenType::kBang, {}, "!"},
-      Token{1, 18, TokenType::kGreater, {}, ">"},
-      Token{1, 19, TokenType::kLess, {}, "<"},
-      Token{1, 20, TokenType::kFileEnd, {}, ""},
+  std::vector<LocatedToken> expected_tokens{
+      LocatedToken{1, 1, TokenType::kLeftParen, 0, 1},
+      LocatedToken{1, 2, TokenType::kRightParen, 1, 1},
+      LocatedToken{1, 3, TokenType::kLeftBracket, 2, 1},
+      LocatedToken{1, 4, TokenType::kRightBracket, 3, 1},
+      LocatedToken{1, 5, TokenType::kLeftSquareBracket, 4, 1},
+      LocatedToken{1, 6, TokenType::kRightSquareBracket, 5, 1},
+      LocatedToken{1, 7, TokenType::kComma, 6, 1},
+      LocatedToken{1, 8, TokenType::kColon, 7, 1},
+      LocatedToken{1, 9, TokenType::kSemiColon, 8, 1},
+      LocatedToken{1, 10, TokenType::kPlus, 9, 1},
+      LocatedToken{1, 11, TokenType::kMinus, 10, 1},
+      LocatedToken{1, 12, TokenType::kRemainder, 11, 1},
+      LocatedToken{1, 13, TokenType::kStar, 12, 1},
+      LocatedToken{1, 14, TokenType::kSlash, 13, 1},
+      LocatedToken{1, 15, TokenType::kUnderscore, 14, 1},
+      LocatedToken{1, 16, TokenType::kEqual, 15, 1},
+      LocatedToken{1, 17, TokenType::kBang, 16, 1},
+      LocatedToken{1, 18, TokenType::kGreater, 17, 1},
+      LocatedToken{1, 19, TokenType::kLess, 18, 1},
+      LocatedToken{1, 20, TokenType::kFileEnd, 19, 0},
   };
 
   EXPECT_EQ(output_tokens.size(), expected_tokens.size());
@@ -95,17 +119,17 @@ TEST_F(LexerTest, LexesWithOnlySingleCharacterTokensInSourceCode) {
 
 TEST_F(LexerTest, LexesWithOnlyDoubleCharacterTokensInSourceCode) {
   std::string file_content_bytes = "!===>=<=&|";
-  std::vector<Token> output_tokens =
+  std::vector<LocatedToken> output_tokens =
       LexSourceCode("test_double_character_tokens.eta", file_content_bytes);
 
-  std::vector<Token> expected_tokens{
-      Token{1, 1, TokenType::kBangEqual, {}, "!="},
-      Token{1, 3, TokenType::kEqualEqual, {}, "=="},
-      Token{1, 5, TokenType::kGreaterEqual, {}, ">="},
-      Token{1, 7, TokenType::kLessEqual, {}, "<="},
-      Token{1, 9, TokenType::kLogicalAnd, {}, "&"},
-      Token{1, 10, TokenType::kLogicalOr, {}, "|"},
-      Token{1, 11, TokenType::kFileEnd, {}, ""},
+  std::vector<LocatedToken> expected_tokens{
+      LocatedToken{1, 1, TokenType::kBangEqual, 0, 2},
+      LocatedToken{1, 3, TokenType::kEqualEqual, 2, 2},
+      LocatedToken{1, 5, TokenType::kGreaterEqual, 4, 2},
+      LocatedToken{1, 7, TokenType::kLessEqual, 6, 2},
+      LocatedToken{1, 9, TokenType::kLogicalAnd, 8, 1},
+      LocatedToken{1, 10, TokenType::kLogicalOr, 9, 1},
+      LocatedToken{1, 11, TokenType::kFileEnd, 10, 0},
   };
 
   EXPECT_EQ(output_tokens.size(), expected_tokens.size());
@@ -114,14 +138,14 @@ TEST_F(LexerTest, LexesWithOnlyDoubleCharacterTokensInSourceCode) {
 
 TEST_F(LexerTest, LexesWithOnlyTripleCharacterTokensInSourceCode) {
   std::string file_content_bytes = "*>>*>";
-  std::vector<Token> output_tokens =
+  std::vector<LocatedToken> output_tokens =
       LexSourceCode("test_triple_character_tokens.eta", file_content_bytes);
 
-  std::vector<Token> expected_tokens{
-      Token{1, 1, TokenType::kHighMul, {}, "*>>"},
-      Token{1, 4, TokenType::kStar, {}, "*"},
-      Token{1, 5, TokenType::kGreater, {}, ">"},
-      Token{1, 6, TokenType::kFileEnd, {}, ""},
+  std::vector<LocatedToken> expected_tokens{
+      LocatedToken{1, 1, TokenType::kHighMul, 0, 3},
+      LocatedToken{1, 4, TokenType::kStar, 3, 1},
+      LocatedToken{1, 5, TokenType::kGreater, 4, 1},
+      LocatedToken{1, 6, TokenType::kFileEnd, 5, 0},
   };
 
   EXPECT_EQ(output_tokens.size(), expected_tokens.size());
@@ -130,10 +154,11 @@ TEST_F(LexerTest, LexesWithOnlyTripleCharacterTokensInSourceCode) {
 
 TEST_F(LexerTest, LexesWithOnlyWhitespaceCharactersInSourceCode) {
   std::string file_content_bytes = "  \r \t\r \t";
-  std::vector<Token> output_tokens =
+  std::vector<LocatedToken> output_tokens =
       LexSourceCode("test_whitespace_characters.eta", file_content_bytes);
 
-  std::vector<Token> expected_tokens{Token{1, 9, TokenType::kFileEnd, {}, ""}};
+  std::vector<LocatedToken> expected_tokens{
+      LocatedToken{1, 9, TokenType::kFileEnd, 8, 0}};
 
   EXPECT_EQ(output_tokens.size(), expected_tokens.size());
   EXPECT_EQ(output_tokens, expected_tokens);
@@ -142,10 +167,11 @@ TEST_F(LexerTest, LexesWithOnlyWhitespaceCharactersInSourceCode) {
 TEST_F(LexerTest, LexesWithOnlyCommentsInSourceCode) {
   std::string file_content_bytes = "// Just a comment here. There are no other "
                                    "tokens beside the 'kFileEnd' one.";
-  std::vector<Token> output_tokens =
+  std::vector<LocatedToken> output_tokens =
       LexSourceCode("test_comment.eta", file_content_bytes);
 
-  std::vector<Token> expected_tokens{Token{1, 77, TokenType::kFileEnd, {}, ""}};
+  std::vector<LocatedToken> expected_tokens{
+      LocatedToken{1, 77, TokenType::kFileEnd, 76, 0}};
 
   EXPECT_EQ(output_tokens.size(), expected_tokens.size());
   EXPECT_EQ(output_tokens, expected_tokens);
@@ -154,39 +180,53 @@ TEST_F(LexerTest, LexesWithOnlyCommentsInSourceCode) {
 TEST_F(LexerTest, LexesWithOnlyIdentifiersInSourceCode) {
   std::string file_content_bytes = "foo bar A a_Ab23\na1'c2r2d2";
 
-  std::vector<Token> output_tokens =
+  std::vector<LocatedToken> output_tokens =
       LexSourceCode("test_identifiers.eta", file_content_bytes);
 
-  std::vector<Token> expected_tokens{
-      Token{1, 1, TokenType::kIdentifier, {}, "foo"},
-      Token{1, 5, TokenType::kIdentifier, {}, "bar"},
-      Token{1, 9, TokenType::kIdentifier, {}, "A"},
-      Token{1, 11, TokenType::kIdentifier, {}, "a_Ab23"},
-      Token{2, 1, TokenType::kIdentifier, {}, "a1'c2r2d2"},
-      Token{2, 10, TokenType::kFileEnd, {}, ""},
+  std::vector<LocatedToken> expected_tokens{
+      LocatedToken{1, 1, TokenType::kIdentifier, 0, 3},
+      LocatedToken{1, 5, TokenType::kIdentifier, 4, 3},
+      LocatedToken{1, 9, TokenType::kIdentifier, 8, 1},
+      LocatedToken{1, 11, TokenType::kIdentifier, 10, 6},
+      LocatedToken{2, 1, TokenType::kIdentifier, 17, 9},
+      LocatedToken{2, 10, TokenType::kFileEnd, 26, 0},
   };
 
   EXPECT_EQ(output_tokens.size(), expected_tokens.size());
   EXPECT_EQ(output_tokens, expected_tokens);
 }
 
+TEST_F(LexerTest, LexesIdentifiersIntoInternedSymbols) {
+  std::string file_content_bytes = "foo bar foo";
+
+  std::vector<LocatedToken> output_tokens =
+      LexSourceCode("test_identifier_symbols.eta", file_content_bytes);
+
+  ASSERT_EQ(output_tokens.size(), 4);
+  Symbol foo_symbol = output_tokens[0].token.value_.symbol_value;
+  Symbol bar_symbol = output_tokens[1].token.value_.symbol_value;
+  EXPECT_EQ(GetStringInterner().GetString(foo_symbol), "foo");
+  EXPECT_EQ(GetStringInterner().GetString(bar_symbol), "bar");
+  EXPECT_EQ(output_tokens[2].token.value_.symbol_value, foo_symbol);
+}
+
 TEST_F(LexerTest, LexesWithOnlyKeywordsInSourceCode) {
   std::string file_content_bytes =
       "else if while return\ntrue false use   length";
 
-  std::vector<Token> output_tokens =
+  std::vector<LocatedToken> output_tokens =
       LexSourceCode("test_keywords.eta", file_content_bytes);
 
-  std::vector<Token> expected_tokens{
-      Token{1, 1, TokenType::kElse, {}, "else"},
-      Token{1, 6, TokenType::kIf, {}, "if"},
-      Token{1, 9, TokenType::kWhile, {}, "while"},
-      Token{1, 15, TokenType::kReturn, {}, "return"},
-      Token{2, 1, TokenType::kTrue, true, "true"},
-      Token{2, 6, TokenType::kFalse, false, "false"},
-      Token{2, 12, TokenType::kUse, {}, "use"},
-      Token{2, 18, TokenType::kLength, {}, "length"},
-      Token{2, 24, TokenType::kFileEnd, {}, ""},
+  std::vector<LocatedToken> expected_tokens{
+      LocatedToken{1, 1, TokenType::kElse, 0, 4},
+      LocatedToken{1, 6, TokenType::kIf, 5, 2},
+      LocatedToken{1, 9, TokenType::kWhile, 8, 5},
+      LocatedToken{1, 15, TokenType::kReturn, 14, 6},
+      LocatedToken{2, 1, TokenType::kTrue, 21, 4, {.boolean_value = true}},
+      LocatedToken{2, 6, TokenType::kFalse, 26, 5, {.boolean_value = false}},
+      LocatedToken{2, 12, TokenType::kUse, 32, 3},
+      LocatedToken{2, 18, TokenType::kLength, 38, 6},
+      LocatedToken{2, 24, TokenType::kFileEnd, 44, 0},
   };
 
   EXPECT_EQ(output_tokens.size(), expected_tokens.size());
@@ -196,16 +236,16 @@ TEST_F(LexerTest, LexesWithOnlyKeywordsInSourceCode) {
 TEST_F(LexerTest, LexesWithOnlyPrimitiveTypesInSourceCode) {
   std::string file_content_bytes = "int bool\n bool bool\nint";
 
-  std::vector<Token> output_tokens =
+  std::vector<LocatedToken> output_tokens =
       LexSourceCode("test_primitive_types.eta", file_content_bytes);
 
-  std::vector<Token> expected_tokens{
-      Token{1, 1, TokenType::kInt, {}, "int"},
-      Token{1, 5, TokenType::kBool, {}, "bool"},
-      Token{2, 2, TokenType::kBool, {}, "bool"},
-      Token{2, 7, TokenType::kBool, {}, "bool"},
-      Token{3, 1, TokenType::kInt, {}, "int"},
-      Token{3, 4, TokenType::kFileEnd, {}, ""},
+  std::vector<LocatedToken> expected_tokens{
+      LocatedToken{1, 1, TokenType::kInt, 0, 3},
+      LocatedToken{1, 5, TokenType::kBool, 4, 4},
+      LocatedToken{2, 2, TokenType::kBool, 10, 4},
+      LocatedToken{2, 7, TokenType::kBool, 15, 4},
+      LocatedToken{3, 1, TokenType::kInt, 20, 3},
+      LocatedToken{3, 4, TokenType::kFileEnd, 23, 0},
   };
 
   EXPECT_EQ(output_tokens.size(), expected_tokens.size());
@@ -215,15 +255,14 @@ TEST_F(LexerTest, LexesWithOnlyPrimitiveTypesInSourceCode) {
 TEST_F(LexerTest, LexesWithOnlyLiteralsInSourceCode) {
   std::string file_content_bytes = " 2 23 \"Hello, World!\"";
 
-  std::vector<Token> output_tokens =
+  std::vector<LocatedToken> output_tokens =
       LexSourceCode("test_literal_values.eta", file_content_bytes);
 
-  std::vector<Token> expected_tokens{Token{1, 2, TokenType::kInteger, 2, "2"},
-                                     Token{1, 4, TokenType::kInteger, 23, "23"},
-                                     Token{1, 7, TokenType::kString,
-                                           std::string{"Hello, World!"},
-                                           "\"Hello, World!\""},
-                                     Token{1, 22, TokenType::kFileEnd, {}, ""}};
+  std::vector<LocatedToken> expected_tokens{
+      LocatedToken{1, 2, TokenType::kInteger, 1, 1, {.integer_value = 2}},
+      LocatedToken{1, 4, TokenType::kInteger, 3, 2, {.integer_value = 23}},
+      LocatedToken{1, 7, TokenType::kString, 6, 15},
+      LocatedToken{1, 22, TokenType::kFileEnd, 21, 0}};
 
   EXPECT_EQ(output_tokens.size(), expected_tokens.size());
   EXPECT_EQ(output_tokens, expected_tokens);
@@ -232,16 +271,16 @@ TEST_F(LexerTest, LexesWithOnlyLiteralsInSourceCode) {
 TEST_F(LexerTest, LexesWithUnterminatedStringLiteralOnSourceCode) {
   std::string file_content_bytes = "s: int[] = \"Hello,";
 
-  std::vector<Token> output_tokens =
+  std::vector<LocatedToken> output_tokens =
       LexSourceCode("test_unterminated_string_literal.eta", file_content_bytes);
 
-  std::vector<Token> expected_tokens{
-      Token{1, 1, TokenType::kIdentifier, {}, "s"},
-      Token{1, 2, TokenType::kColon, {}, ":"},
-      Token{1, 4, TokenType::kInt, {}, "int"},
-      Token{1, 7, TokenType::kLeftSquareBracket, {}, "["},
-      Token{1, 8, TokenType::kRightSquareBracket, {}, "]"},
-      Token{1, 10, TokenType::kEqual, {}, "="},
+  std::vector<LocatedToken> expected_tokens{
+      LocatedToken{1, 1, TokenType::kIdentifier, 0, 1},
+      LocatedToken{1, 2, TokenType::kColon, 1, 1},
+      LocatedToken{1, 4, TokenType::kInt, 3, 3},
+      LocatedToken{1, 7, TokenType::kLeftSquareBracket, 6, 1},
+      LocatedToken{1, 8, TokenType::kRightSquareBracket, 7, 1},
+      LocatedToken{1, 10, TokenType::kEqual, 9, 1},
   };
 
   EXPECT_EQ(output_tokens.size(), expected_tokens.size());
@@ -268,14 +307,14 @@ TEST_F(LexerTest, LexesWithStringLiteralSpanningMultipleLinesOnSourceCode) {}
 TEST_F(LexerTest, LexesWithUnterminatedCharLiteralOnSourceCode) {
   std::string file_content_bytes = "s: int = 'a";
 
-  std::vector<Token> output_tokens =
+  std::vector<LocatedToken> output_tokens =
       LexSourceCode("test_unterminated_char_literal.eta", file_content_bytes);
 
-  std::vector<Token> expected_tokens{
-      Token{1, 1, TokenType::kIdentifier, {}, "s"},
-      Token{1, 2, TokenType::kColon, {}, ":"},
-      Token{1, 4, TokenType::kInt, {}, "int"},
-      Token{1, 8, TokenType::kEqual, {}, "="}};
+  std::vector<LocatedToken> expected_tokens{
+      LocatedToken{1, 1, TokenType::kIdentifier, 0, 1},
+      LocatedToken{1, 2, TokenType::kColon, 1, 1},
+      LocatedToken{1, 4, TokenType::kInt, 3, 3},
+      LocatedToken{1, 8, TokenType::kEqual, 7, 1}};
 
   EXPECT_EQ(output_tokens.size(), expected_tokens.size());
   EXPECT_EQ(output_tokens, expected_tokens);
@@ -301,14 +340,14 @@ TEST_F(LexerTest, LexesWithUnterminatedCharLiteralOnSourceCode) {
 TEST_F(LexerTest, LexesWithEmptyCharLiteralOnSourceCode) {
   std::string file_content_bytes = "s: int = '';";
 
-  std::vector<Token> output_tokens =
+  std::vector<LocatedToken> output_tokens =
       LexSourceCode("test_empty_char_literal.eta", file_content_bytes);
 
-  std::vector<Token> expected_tokens{
-      Token{1, 1, TokenType::kIdentifier, {}, "s"},
-      Token{1, 2, TokenType::kColon, {}, ":"},
-      Token{1, 4, TokenType::kInt, {}, "int"},
-      Token{1, 8, TokenType::kEqual, {}, "="},
+  std::vector<LocatedToken> expected_tokens{
+      LocatedToken{1, 1, TokenType::kIdentifier, 0, 1},
+      LocatedToken{1, 2, TokenType::kColon, 1, 1},
+      LocatedToken{1, 4, TokenType::kInt, 3, 3},
+      LocatedToken{1, 8, TokenType::kEqual, 7, 1},
   };
 
   EXPECT_EQ(output_tokens.size(), expected_tokens.size());
@@ -334,14 +373,14 @@ TEST_F(LexerTest, LexesWithEmptyCharLiteralOnSourceCode) {
 TEST_F(LexerTest, LexesWithMultiCharLiteralOnSourceCode) {
   std::string file_content_bytes = "s: int = 'abcd';";
 
-  std::vector<Token> output_tokens =
+  std::vector<LocatedToken> output_tokens =
       LexSourceCode("test_multi_char_literal.eta", file_content_bytes);
 
-  std::vector<Token> expected_tokens{
-      Token{1, 1, TokenType::kIdentifier, {}, "s"},
-      Token{1, 2, TokenType::kColon, {}, ":"},
-      Token{1, 4, TokenType::kInt, {}, "int"},
-      Token{1, 8, TokenType::kEqual, {}, "="},
+  std::vector<LocatedToken> expected_tokens{
+      LocatedToken{1, 1, TokenType::kIdentifier, 0, 1},
+      LocatedToken{1, 2, TokenType::kColon, 1, 1},
+      LocatedToken{1, 4, TokenType::kInt, 3, 3},
+      LocatedToken{1, 8, TokenType::kEqual, 7, 1},
   };
 
   EXPECT_EQ(output_tokens.size(), expected_tokens.size());
@@ -364,3 +403,95 @@ TEST_F(LexerTest, LexesWithMultiCharLiteralOnSourceCode) {
 
   EXPECT_EQ(captured_cout_.str(), expected_output);
 }
+
+TEST_F(LexerTest, LexesNewlineCharacterLiteralWithoutLineDrift) {
+  std::string file_content_bytes = "c = '\n'\n  x";
+  std::vector<LocatedToken> output_tokens =
+      LexSourceCode("test_newline_char_literal.eta", file_content_bytes);
+
+  std::vector<LocatedToken> expected_tokens{
+      LocatedToken{1, 1, TokenType::kIdentifier, 0, 1},
+      LocatedToken{1, 3, TokenType::kEqual, 2, 1},
+      LocatedToken{1, 5, TokenType::kCharacter, 4, 3,
+                   {.character_value = '\n'}},
+      LocatedToken{3, 3, TokenType::kIdentifier, 10, 1},
+      LocatedToken{3, 4, TokenType::kFileEnd, 11, 0},
+  };
+
+  EXPECT_EQ(output_tokens.size(), expected_tokens.size());
+  EXPECT_EQ(output_tokens, expected_tokens);
+}
+
+TEST_F(LexerTest, LexesEscapeSequencesInLiterals) {
+  std::string file_content_bytes =
+      "print(\"Hello, Worl\\x{64}!\\n\")\nc = '\\''";
+  std::vector<LocatedToken> output_tokens =
+      LexSourceCode("test_escape_sequences.eta", file_content_bytes);
+
+  std::vector<LocatedToken> expected_tokens{
+      LocatedToken{1, 1, TokenType::kIdentifier, 0, 5},
+      LocatedToken{1, 6, TokenType::kLeftParen, 5, 1},
+      LocatedToken{1, 7, TokenType::kString, 6, 22},
+      LocatedToken{1, 29, TokenType::kRightParen, 28, 1},
+      LocatedToken{2, 1, TokenType::kIdentifier, 30, 1},
+      LocatedToken{2, 3, TokenType::kEqual, 32, 1},
+      LocatedToken{2, 5, TokenType::kCharacter, 34, 4},
+      LocatedToken{2, 9, TokenType::kFileEnd, 38, 0},
+  };
+
+  EXPECT_EQ(output_tokens, expected_tokens);
+  EXPECT_EQ(output_tokens[2].token.GetStringValue(), "Hello, World!\n");
+  EXPECT_EQ(output_tokens[6].token.value_.character_value, '\'');
+  EXPECT_FALSE(diagnostic_reporter_.HasFatalErrors());
+}
+
+TEST_F(LexerTest, LexesWithUnknownEscapeSequenceOnSourceCode) {
+  std::string file_content_bytes = "s = \"ab\\qc\"";
+  LexSourceCode("test_unknown_escape.eta", file_content_bytes);
+
+  EXPECT_TRUE(diagnostic_reporter_.HasFatalErrors());
+
+  std::string expected_output =
+      kAnsiRed +
+      "[Fatal] - [Location]:[Source File: "
+      "'/tmp/test_lexer_dir/test_unknown_escape.eta' - Line: 1 - "
+      "Column: 8] - [Message]:[E]: An unknown escape sequence ('\\q') was "
+      "found within the source file." +
+      kAnsiReset + "\n";
+  diagnostic_reporter_.OutputCompilerErrors();
+
+  EXPECT_EQ(captured_cout_.str(), expected_output);
+}
+
+TEST_F(LexerTest, LexesSixtyFourBitIntegerLiterals) {
+  std::string file_content_bytes = "-9223372036854775808 2147483648";
+  std::vector<LocatedToken> output_tokens =
+      LexSourceCode("test_64_bit_integers.eta", file_content_bytes);
+
+  ASSERT_EQ(output_tokens.size(), 4);
+  EXPECT_EQ(output_tokens[1].token.value_.integer_value,
+            9223372036854775808u);
+  EXPECT_EQ(output_tokens[2].token.value_.integer_value, 2147483648u);
+  EXPECT_FALSE(diagnostic_reporter_.HasFatalErrors());
+}
+
+TEST_F(LexerTest, LexesWithOverflowingIntegerLiteralOnSourceCode) {
+  std::string file_content_bytes = "x = 9223372036854775809";
+  std::vector<LocatedToken> output_tokens =
+      LexSourceCode("test_overflowing_integer.eta", file_content_bytes);
+
+  EXPECT_EQ(output_tokens.size(), 2);
+  EXPECT_TRUE(diagnostic_reporter_.HasFatalErrors());
+
+  std::string expected_output =
+      kAnsiRed +
+      "[Fatal] - [Location]:[Source File: "
+      "'/tmp/test_lexer_dir/test_overflowing_integer.eta' - Line: 1 - "
+      "Column: 5] - [Message]:[E]: The integer literal '9223372036854775809' "
+      "is too large. Eta integers are 64-bit values, from "
+      "-9223372036854775808 to 9223372036854775807." +
+      kAnsiReset + "\n";
+  diagnostic_reporter_.OutputCompilerErrors();
+
+  EXPECT_EQ(captured_cout_.str(), expected_output);
+}
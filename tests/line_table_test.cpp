@@ -0,0 +1,49 @@
+#include "senbonzakura/line_table.hpp"
+
+#include <string>
+#include <string_view>
+
+#include <gtest/gtest.h>
+
+TEST(LineTableTest, ResolvesOffsetsOnASingleLine) {
+  LineTable line_table{"x: int = 42;"};
+
+  EXPECT_EQ(line_table.GetLineCount(), 1);
+  EXPECT_EQ(line_table.Resolve(0), (LineColumn{1, 1}));
+  EXPECT_EQ(line_table.Resolve(9), (LineColumn{1, 10}));
+  EXPECT_EQ(line_table.Resolve(12), (LineColumn{1, 13}));
+}
+
+TEST(LineTableTest, ResolvesOffsetsAcrossLines) {
+  std::string_view source_code = "use io\n\nmain() {\n\tx = 1\n}\n";
+  LineTable line_table{source_code};
+
+  EXPECT_EQ(line_table.GetLineCount(), 6);
+  EXPECT_EQ(line_table.GetLineStart(3), 8);
+  // The '\n' ending a line belongs to that line.
+  EXPECT_EQ(line_table.Resolve(6), (LineColumn{1, 7}));
+  EXPECT_EQ(line_table.Resolve(7), (LineColumn{2, 1}));
+  EXPECT_EQ(line_table.Resolve(8), (LineColumn{3, 1}));
+  // Tabs count as a single column.
+  EXPECT_EQ(line_table.Resolve(18), (LineColumn{4, 2}));
+  EXPECT_EQ(line_table.Resolve(source_code.length()), (LineColumn{6, 1}));
+}
+
+TEST(LineTableTest, HandlesEmptySourceCode) {
+  LineTable line_table{""};
+
+  EXPECT_EQ(line_table.GetLineCount(), 1);
+  EXPECT_EQ(line_table.Resolve(0), (LineColumn{1, 1}));
+}
+
+TEST(LineTableTest, FindsNewlinesPastTheVectorWidth) {
+  std::string source_code(100, 'a');
+  source_code[40] = '\n';
+  source_code[99] = '\n';
+  LineTable line_table{source_code};
+
+  EXPECT_EQ(line_table.GetLineCount(), 3);
+  EXPECT_EQ(line_table.Resolve(41), (LineColumn{2, 1}));
+  EXPECT_EQ(line_table.Resolve(98), (LineColumn{2, 58}));
+  EXPECT_EQ(line_table.Resolve(100), (LineColumn{3, 1}));
+}
@@ -0,0 +1,81 @@
+#include "senbonzakura/literal_decoder.hpp"
+
+#include <cstdint>
+#include <string>
+
+#include <gtest/gtest.h>
+
+TEST(LiteralDecoderTest, DecodesIntegerLiterals) {
+  std::uint64_t magnitude = 0;
+
+  EXPECT_TRUE(DecodeIntegerLiteral("0", magnitude));
+  EXPECT_EQ(magnitude, 0);
+  EXPECT_TRUE(DecodeIntegerLiteral("0047", magnitude));
+  EXPECT_EQ(magnitude, 47);
+  EXPECT_TRUE(DecodeIntegerLiteral("9223372036854775807", magnitude));
+  EXPECT_EQ(magnitude, 9223372036854775807u);
+}
+
+TEST(LiteralDecoderTest, AcceptsTheMagnitudeOfTheSmallestInteger) {
+  std::uint64_t magnitude = 0;
+
+  EXPECT_TRUE(DecodeIntegerLiteral("9223372036854775808", magnitude));
+  EXPECT_EQ(magnitude, kMaxIntegerLiteralMagnitude);
+}
+
+TEST(LiteralDecoderTest, RejectsOverflowingIntegerLiterals) {
+  std::uint64_t magnitude = 0;
+
+  EXPECT_FALSE(DecodeIntegerLiteral("9223372036854775809", magnitude));
+  EXPECT_FALSE(DecodeIntegerLiteral("18446744073709551616", magnitude));
+  EXPECT_FALSE(DecodeIntegerLiteral("123456789012345678901234567890",
+                                    magnitude));
+}
+
+TEST(LiteralDecoderTest, DecodesSimpleEscapeSequences) {
+  struct {
+    const char *text;
+    char value;
+  } cases[] = {{"\\\\", '\\'}, {"\\'", '\''}, {"\\\"", '\"'},
+               {"\\n", '\n'},  {"\\t", '\t'}, {"\\r", '\r'}};
+
+  for (const auto &test_case : cases) {
+    DecodedEscape escape = DecodeEscapeSequence(test_case.text);
+    EXPECT_EQ(escape.status, EscapeStatus::kValid) << test_case.text;
+    EXPECT_EQ(escape.value, test_case.value) << test_case.text;
+    EXPECT_EQ(escape.length, 2) << test_case.text;
+  }
+}
+
+TEST(LiteralDecoderTest, DecodesHexadecimalEscapeSequences) {
+  DecodedEscape escape = DecodeEscapeSequence("\\x{64}!\\n");
+  EXPECT_EQ(escape.status, EscapeStatus::kValid);
+  EXPECT_EQ(escape.value, 'd');
+  EXPECT_EQ(escape.length, 6);
+
+  escape = DecodeEscapeSequence("\\x{00000A}");
+  EXPECT_EQ(escape.status, EscapeStatus::kValid);
+  EXPECT_EQ(escape.value, '\n');
+  EXPECT_EQ(escape.length, 10);
+}
+
+TEST(LiteralDecoderTest, RejectsInvalidEscapeSequences) {
+  EXPECT_EQ(DecodeEscapeSequence("\\q").status, EscapeStatus::kUnknown);
+  EXPECT_EQ(DecodeEscapeSequence("\\").status, EscapeStatus::kUnknown);
+  EXPECT_EQ(DecodeEscapeSequence("\\x41").status, EscapeStatus::kMalformed);
+  EXPECT_EQ(DecodeEscapeSequence("\\x{}").status, EscapeStatus::kMalformed);
+  EXPECT_EQ(DecodeEscapeSequence("\\x{g1}").status, EscapeStatus::kMalformed);
+  EXPECT_EQ(DecodeEscapeSequence("\\x{1234567}").status,
+            EscapeStatus::kMalformed);
+  EXPECT_EQ(DecodeEscapeSequence("\\x{41").status, EscapeStatus::kMalformed);
+  EXPECT_EQ(DecodeEscapeSequence("\\x{80}").status, EscapeStatus::kOutOfRange);
+}
+
+TEST(LiteralDecoderTest, EscapesLiteralsForTheOutput) {
+  std::string output;
+
+  AppendEscapedLiteral(output, "Hello, World!\n\t\\ 'x' \"y\"");
+  AppendEscapedLiteral(output, std::string{"\x01\x7f", 2});
+
+  EXPECT_EQ(output, "Hello, World!\\n\\t\\\\ 'x' \"y\"\\x{01}\\x{7f}");
+}
@@ -0,0 +1,95 @@
+#include "senbonzakura/parallel_lexer.hpp"
+
+#include "senbonzakura/diagnostic_reporter.hpp"
+#include "senbonzakura/lexer.hpp"
+#include "senbonzakura/token.hpp"
+#include "senbonzakura/token_type.hpp"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace {
+
+// Builds a source file larger than 'size' bytes by repeating a snippet that
+// has every kind of token, so that it is split into several chunks.
+std::string BuildLargeSourceCode(std::size_t size) {
+  std::string snippet = "main(args: int[][]) {\n"
+                        "  // Comment with a quote ' in it.\n"
+                        "  s: int[] = \"Hello, \\x{48}\\n\"\n"
+                        "  c: int = '\n'\n"
+                        "  x: int = 9223372036854775807 % 10 *>> 2\n"
+                        "  if (x >= 0 & !false) { return x, 'a' }\n"
+                        "}\n";
+  std::string source_code;
+  while (source_code.length() <= size) {
+    source_code += snippet;
+  }
+
+  return source_code;
+}
+
+} // namespace
+
+TEST(ParallelLexerTest, SplitsRightAfterNewlines) {
+  std::string source_code = "ab\ncd\nef\ngh\n";
+  std::vector<std::size_t> boundaries = SplitAtNewlines(source_code, 4);
+
+  EXPECT_EQ(boundaries, (std::vector<std::size_t>{0, 6, 9, 12}));
+}
+
+TEST(ParallelLexerTest, SplitsIntoASingleChunkWithoutNewlines) {
+  std::string source_code = "main() { return }";
+
+  EXPECT_EQ(SplitAtNewlines(source_code, 4),
+            (std::vector<std::size_t>{0, source_code.length()}));
+  EXPECT_EQ(SplitAtNewlines("", 4), (std::vector<std::size_t>{0, 0}));
+}
+
+TEST(ParallelLexerTest, DoesNotSplitCharacterLiteralsWithARawNewline) {
+  std::string source_code = "x = '\n'\ny = 1\n";
+  std::vector<std::size_t> boundaries = SplitAtNewlines(source_code, 3);
+
+  EXPECT_EQ(boundaries, (std::vector<std::size_t>{0, 8, 14}));
+}
+
+TEST(ParallelLexerTest, LexesLikeASingleLexer) {
+  std::string source_code =
+      BuildLargeSourceCode(4 * kMinParallelLexingChunkSize);
+
+  DiagnosticReporter serial_diagnostic_reporter;
+  Lexer lexer{"large.eta", source_code, serial_diagnostic_reporter};
+  std::vector<Token> serial_tokens = lexer.LexTokens();
+
+  DiagnosticReporter parallel_diagnostic_reporter;
+  std::vector<Token> parallel_tokens = LexTokensInParallel(
+      "large.eta", source_code, parallel_diagnostic_reporter, 4);
+
+  EXPECT_FALSE(parallel_diagnostic_reporter.HasFatalErrors());
+  ASSERT_EQ(parallel_tokens.size(), serial_tokens.size());
+  EXPECT_EQ(parallel_tokens, serial_tokens);
+  EXPECT_EQ(parallel_tokens.back().token_type_, TokenType::kFileEnd);
+}
+
+TEST(ParallelLexerTest, StopsAtTheFirstFatalError) {
+  std::string source_code =
+      BuildLargeSourceCode(4 * kMinParallelLexingChunkSize);
+  // Places invalid symbols in the second and in the last chunk.
+  source_code.insert(source_code.find('\n', source_code.length() / 3) + 1,
+                     "@\n");
+  source_code += "#\n";
+
+  DiagnosticReporter serial_diagnostic_reporter;
+  Lexer lexer{"large.eta", source_code, serial_diagnostic_reporter};
+  std::vector<Token> serial_tokens = lexer.LexTokens();
+
+  DiagnosticReporter parallel_diagnostic_reporter;
+  std::vector<Token> parallel_tokens = LexTokensInParallel(
+      "large.eta", source_code, parallel_diagnostic_reporter, 4);
+
+  EXPECT_TRUE(parallel_diagnostic_reporter.HasFatalErrors());
+  ASSERT_EQ(parallel_tokens.size(), serial_tokens.size());
+  EXPECT_EQ(parallel_tokens, serial_tokens);
+}
@@ -1,3 +1,451 @@
 #include "senbonzakura/parser.hpp"
+#include "senbonzakura/ast.hpp"
+#include "senbonzakura/diagnostic_reporter.hpp"
+#include "senbonzakura/lexer.hpp"
+#include "senbonzakura/string_interner.hpp"
+#include "senbonzakura/token_stream.hpp"
+#include "senbonzakura/token_type.hpp"
 
-#include <gtest/gtest.h>
\ No newline at end of file
+#include <format>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace {
+
+std::string GetOperatorLexeme(TokenType token_type) {
+  switch (token_type) {
+  case TokenType::kLogicalOr:
+    return "|";
+  case TokenType::kLogicalAnd:
+    return "&";
+  case TokenType::kEqualEqual:
+    return "==";
+  case TokenType::kBangEqual:
+    return "!=";
+  case TokenType::kLess:
+    return "<";
+  case TokenType::kLessEqual:
+    return "<=";
+  case TokenType::kGreater:
+    return ">";
+  case TokenType::kGreaterEqual:
+    return ">=";
+  case TokenType::kPlus:
+    return "+";
+  case TokenType::kMinus:
+    return "-";
+  case TokenType::kStar:
+    return "*";
+  case TokenType::kHighMul:
+    return "*>>";
+  case TokenType::kSlash:
+    return "/";
+  case TokenType::kRemainder:
+    return "%";
+  case TokenType::kBang:
+    return "!";
+  default:
+    return "?";
+  }
+}
+
+// Compact S-expression of the subtree at 'index', so that the expected trees
+// can be written inline.
+std::string Dump(const Ast &ast, AstIndex index) {
+  if (index == kNoAstIndex) {
+    return "nil";
+  }
+
+  const AstNode &node = ast.GetNode(index);
+  auto dump_range = [&](AstRange range) {
+    std::string result;
+    for (AstIndex child : ast.GetChildren(range)) {
+      result += result.empty() ? "" : " ";
+      result += Dump(ast, child);
+    }
+    return result;
+  };
+  StringInterner &string_interner = GetStringInterner();
+
+  switch (node.kind) {
+  case AstNodeKind::kProgram:
+    return std::format("(program {})", dump_range(node.range));
+  case AstNodeKind::kUse:
+    return std::format("(use {})", string_interner.GetString(node.symbol));
+  case AstNodeKind::kFunction: {
+    const AstFunction &function = ast.GetFunction(node);
+    return std::format(
+        "({} ({}) ({}) {})", string_interner.GetString(function.name),
+        dump_range(function.parameters), dump_range(function.return_types),
+        Dump(ast, function.body));
+  }
+  case AstNodeKind::kGlobalDeclaration:
+    return std::format("(global {} {})", Dump(ast, node.pair.first),
+                       Dump(ast, node.pair.second));
+  case AstNodeKind::kDeclaration:
+    return std::format("({} {})", Dump(ast, node.pair.first),
+                       Dump(ast, node.pair.second));
+  case AstNodeKind::kIntType:
+    return "int";
+  case AstNodeKind::kBoolType:
+    return "bool";
+  case AstNodeKind::kArrayType:
+    return std::format("([] {} {})", Dump(ast, node.pair.first),
+                       Dump(ast, node.pair.second));
+  case AstNodeKind::kBlock:
+    return std::format("{{{}}}", dump_range(node.range));
+  case AstNodeKind::kIf: {
+    const AstIf &if_statement = ast.GetIf(node);
+    return std::format("(if {} {} {})", Dump(ast, if_statement.condition),
+                       Dump(ast, if_statement.then_branch),
+                       Dump(ast, if_statement.else_branch));
+  }
+  case AstNodeKind::kWhile:
+    return std::format("(while {} {})", Dump(ast, node.pair.first),
+                       Dump(ast, node.pair.second));
+  case AstNodeKind::kReturn:
+    return std::format("(return {})", dump_range(node.range));
+  case AstNodeKind::kAssignment: {
+    const AstAssignment &assignment = ast.GetAssignment(node);
+    return std::format("(= ({}) ({}))", dump_range(assignment.targets),
+                       dump_range(assignment.values));
+  }
+  case AstNodeKind::kDiscard:
+    return "_";
+  case AstNodeKind::kIdentifier:
+    return std::string{string_interner.GetString(node.symbol)};
+  case AstNodeKind::kInteger:
+    return std::to_string(node.integer_value);
+  case AstNodeKind::kCharacter:
+    return std::format("'{}'", node.character_value);
+  case AstNodeKind::kString:
+    return std::format("\"{}\"", string_interner.GetString(node.symbol));
+  case AstNodeKind::kBoolean:
+    return node.boolean_value ? "true" : "false";
+  case AstNodeKind::kArrayLiteral:
+    return std::format("(array {})", dump_range(node.range));
+  case AstNodeKind::kUnary:
+    return std::format("({} {})", GetOperatorLexeme(node.operator_type),
+                       Dump(ast, node.pair.first));
+  case AstNodeKind::kBinary:
+    return std::format("({} {} {})", GetOperatorLexeme(node.operator_type),
+                       Dump(ast, node.pair.first), Dump(ast, node.pair.second));
+  case AstNodeKind::kCall:
+    return std::format("(call {})", dump_range(node.range));
+  case AstNodeKind::kIndex:
+    return std::format("([] {} {})", Dump(ast, node.pair.first),
+                       Dump(ast, node.pair.second));
+  case AstNodeKind::kLength:
+    return std::format("(length {})", Dump(ast, node.pair.first));
+  case AstNodeKind::kError:
+    return "error";
+  }
+
+  return "?";
+}
+
+} // namespace
+
+class ParserTest : public ::testing::Test {
+protected:
+  DiagnosticReporter diagnostic_reporter_;
+  std::string source_code_;
+  std::size_t syntax_error_count_ = 0;
+
+  std::stringstream captured_cout_;
+  std::streambuf *original_cout_buffer_;
+
+  void SetUp() override {
+    original_cout_buffer_ = std::cout.rdbuf();
+    std::cout.rdbuf(captured_cout_.rdbuf());
+  }
+
+  void TearDown() override { std::cout.rdbuf(original_cout_buffer_); }
+
+  Ast ParseSourceCode(const std::string &source_code) {
+    source_code_ = source_code;
+    Lexer lexer{"parser_test.eta", source_code_, diagnostic_reporter_};
+    SpanTokenStream token_stream{lexer.LexTokens()};
+    Parser parser{"parser_test.eta", source_code_, token_stream,
+                  diagnostic_reporter_};
+    Ast ast = parser.Parse();
+    syntax_error_count_ = parser.GetSyntaxErrorCount();
+
+    return ast;
+  }
+
+  // Dump of the whole program, which must have parsed without errors.
+  std::string ParseAndDump(const std::string &source_code) {
+    Ast ast = ParseSourceCode(source_code);
+    EXPECT_FALSE(diagnostic_reporter_.HasNormalErrors());
+    EXPECT_EQ(syntax_error_count_, 0);
+
+    return Dump(ast, ast.GetRoot());
+  }
+
+  // Dump of the only statement of the body of 'f'.
+  std::string ParseStatement(const std::string &statement) {
+    std::string dump = ParseAndDump("f() {\n" + statement + "\n}\n");
+    std::string prefix = "(program (f () () {";
+    std::string suffix = "}))";
+    if (dump.size() < prefix.size() + suffix.size() ||
+        dump.compare(0, prefix.size(), prefix) != 0) {
+      return dump;
+    }
+
+    return dump.substr(prefix.size(),
+                       dump.size() - prefix.size() - suffix.size());
+  }
+
+  std::string ParseExpression(const std::string &expression) {
+    std::string dump = ParseStatement("x = " + expression);
+    std::string prefix = "(= (x) (";
+    if (dump.compare(0, prefix.size(), prefix) != 0) {
+      return dump;
+    }
+
+    return dump.substr(prefix.size(), dump.size() - prefix.size() - 2);
+  }
+
+  // The errors reported for 'source_code', which must fail to parse.
+  std::string ParseError(const std::string &source_code) {
+    Ast ast = ParseSourceCode(source_code);
+    EXPECT_TRUE(diagnostic_reporter_.HasNormalErrors());
+    EXPECT_NE(ast.GetRoot(), kNoAstIndex);
+    diagnostic_reporter_.OutputCompilerErrors();
+
+    return captured_cout_.str();
+  }
+};
+
+TEST_F(ParserTest, ParsesEmptyProgram) {
+  EXPECT_EQ(ParseAndDump(""), "(program )");
+}
+
+TEST_F(ParserTest, ParsesUsesFunctionsAndGlobals) {
+  std::string source_code = "use io\n"
+                            "use conv;\n"
+                            "\n"
+                            "n: int = -3\n"
+                            "c: int = 'a';\n"
+                            "flag: bool\n"
+                            "\n"
+                            "main(args: int[][]) {\n"
+                            "}\n"
+                            "\n"
+                            "gcd(a: int, b: int): int, bool {\n"
+                            "  return a, true\n"
+                            "}\n";
+
+  EXPECT_EQ(ParseAndDump(source_code),
+            "(program (use io) (use conv) (global (n int) (- 3)) "
+            "(global (c int) 'a') (global (flag bool) nil) "
+            "(main ((args ([] ([] int nil) nil))) () {}) "
+            "(gcd ((a int) (b int)) (int bool) {(return a true)}))");
+}
+
+TEST_F(ParserTest, ParsesBinaryOperatorsByPrecedence) {
+  EXPECT_EQ(ParseExpression("1 + 2 * 3"), "(+ 1 (* 2 3))");
+  EXPECT_EQ(ParseExpression("1 * 2 + 3"), "(+ (* 1 2) 3)");
+  EXPECT_EQ(ParseExpression("a | b & c == d < e + f *>> g"),
+            "(| a (& b (== c (< d (+ e (*>> f g))))))");
+  EXPECT_EQ(ParseExpression("(1 + 2) % 3"), "(% (+ 1 2) 3)");
+}
+
+TEST_F(ParserTest, ParsesBinaryOperatorsAsLeftAssociative) {
+  EXPECT_EQ(ParseExpression("a - b - c"), "(- (- a b) c)");
+  EXPECT_EQ(ParseExpression("a / b * c % d"), "(% (* (/ a b) c) d)");
+  EXPECT_EQ(ParseExpression("a != b == c"), "(== (!= a b) c)");
+}
+
+TEST_F(ParserTest, ParsesUnaryOperatorsTighterThanBinaryOnes) {
+  EXPECT_EQ(ParseExpression("-a * -b"), "(* (- a) (- b))");
+  EXPECT_EQ(ParseExpression("!a & !!b"), "(& (! a) (! (! b)))");
+  EXPECT_EQ(ParseExpression("-a[0][1]"), "(- ([] ([] a 0) 1))");
+}
+
+TEST_F(ParserTest, ParsesTheSmallestIntegerAsANegatedLiteral) {
+  EXPECT_EQ(ParseExpression("-9223372036854775808"), "(- 9223372036854775808)");
+  EXPECT_EQ(ParseExpression("9223372036854775807"), "9223372036854775807");
+  EXPECT_EQ(ParseAndDump("n: int = -9223372036854775808\n"),
+            "(program (global (n int) (- 9223372036854775808)))");
+}
+
+TEST_F(ParserTest, ParsesCallsIndicesAndArrayConstructors) {
+  EXPECT_EQ(ParseExpression("f()"), "(call f)");
+  EXPECT_EQ(ParseExpression("f(1, g(x))[2]"), "([] (call f 1 (call g x)) 2)");
+  EXPECT_EQ(ParseExpression("{1, 2, 3,}"), "(array 1 2 3)");
+  EXPECT_EQ(ParseExpression("{}"), "(array )");
+  EXPECT_EQ(ParseExpression("{1, 2}[0]"), "([] (array 1 2) 0)");
+  EXPECT_EQ(ParseExpression("length(\"abc\")"), "(length \"abc\")");
+}
+
+TEST_F(ParserTest, ParsesAssignmentsAndDeclarations) {
+  EXPECT_EQ(ParseStatement("a[i][j] = 3"), "(= (([] ([] a i) j)) (3))");
+  EXPECT_EQ(ParseStatement("x: int = 3"), "(= ((x int)) (3))");
+  EXPECT_EQ(ParseStatement("_ = f()"), "(= (_) ((call f)))");
+  EXPECT_EQ(ParseStatement("x: int, _, b: bool = g()"),
+            "(= ((x int) _ (b bool)) ((call g)))");
+  EXPECT_EQ(ParseStatement("x: int[n][]"), "(x ([] ([] int nil) n))");
+  EXPECT_EQ(ParseStatement("x: int, y: bool"), "(= ((x int) (y bool)) ())");
+  EXPECT_EQ(ParseStatement("print(\"hi\")"), "(call print \"hi\")");
+}
+
+TEST_F(ParserTest, ParsesControlFlowWithOptionalBracesAndSemicolons) {
+  EXPECT_EQ(ParseStatement("if x < 1 y = 2 else { y = 3; z = 4; }"),
+            "(if (< x 1) (= (y) (2)) {(= (y) (3)) (= (z) (4))})");
+  EXPECT_EQ(ParseStatement("while (i > 0) i = i - 1"),
+            "(while (> i 0) (= (i) ((- i 1))))");
+  EXPECT_EQ(ParseStatement("if a if b f() else g()"),
+            "(if a (if b (call f) (call g)) nil)");
+  EXPECT_EQ(ParseStatement("{ return }"), "{(return )}");
+}
+
+TEST_F(ParserTest, ReportsMissingClosingParenthesisWithItsLocation) {
+  std::string output = ParseError("f() {\n  x = (1 + 2\n}\n");
+
+  EXPECT_NE(output.find("Line: 3 - Column: 1"), std::string::npos) << output;
+  EXPECT_NE(output.find("Expected ')' to close the parenthesized "
+                        "expression, but found '}'."),
+            std::string::npos)
+      << output;
+}
+
+TEST_F(ParserTest, ReportsEveryIndependentSyntaxError) {
+  std::string output = ParseError("f() { x = }\ng() { y = }\n");
+
+  EXPECT_EQ(syntax_error_count_, 2);
+  EXPECT_NE(output.find("Line: 1 - Column: 11"), std::string::npos) << output;
+  EXPECT_NE(output.find("Line: 2 - Column: 11"), std::string::npos) << output;
+}
+
+TEST_F(ParserTest, ResynchronizesAtSemicolonsAndClosingBraces) {
+  Ast ast = ParseSourceCode("f() {\n"
+                            "  x = 1 + ; y = 2\n"
+                            "  if a { z = ) + 2 } w = 3\n"
+                            "}\n");
+
+  EXPECT_EQ(syntax_error_count_, 2);
+  EXPECT_EQ(Dump(ast, ast.GetRoot()),
+            "(program (f () () {(= (x) ((+ 1 error))) (= (y) (2)) "
+            "(if a {(= (z) (error))} nil) (= (w) (3))}))");
+}
+
+TEST_F(ParserTest, ResynchronizesAtTheNextDefinition) {
+  Ast ast = ParseSourceCode("use io\n"
+                            "f(a int) {\n"
+                            "  b: int\n"
+                            "}\n"
+                            "n: int = x\n"
+                            "g() {}\n");
+
+  EXPECT_EQ(syntax_error_count_, 2);
+  EXPECT_EQ(Dump(ast, ast.GetRoot()), "(program (use io) (f (error) () error) "
+                                      "(global (n int) error) (g () () {}))");
+}
+
+TEST_F(ParserTest, KeepsParsingAfterInvalidConstructs) {
+  Ast ast = ParseSourceCode("f() {\n"
+                            "  return 1\n"
+                            "  x + 1\n"
+                            "  a: int[3] = {}\n"
+                            "}\n"
+                            "use io\n");
+
+  EXPECT_EQ(syntax_error_count_, 4);
+  EXPECT_EQ(Dump(ast, ast.GetRoot()),
+            "(program (f () () {(return 1) error "
+            "(= ((a ([] int 3))) ((array )))}) (use io))");
+}
+
+TEST_F(ParserTest, StopsParsingOnceTheErrorLimitIsReached) {
+  diagnostic_reporter_.SetErrorLimit(2);
+  ParseSourceCode("f() { a = }\ng() { b = }\nh() { c = }\ni() { d = }\n");
+
+  EXPECT_EQ(syntax_error_count_, 2);
+  EXPECT_EQ(diagnostic_reporter_.GetSuppressedErrorCount(), 0);
+}
+
+TEST_F(ParserTest, ReportsIntegerLiteralsLargerThanTheLargestInteger) {
+  std::string output = ParseError("n: int = 9223372036854775808\n"
+                                  "f() {\n"
+                                  "  a = 9223372036854775808;\n"
+                                  "  b = 1 - 9223372036854775808;\n"
+                                  "  c = !9223372036854775808;\n"
+                                  "  d = -9223372036854775808[0]\n"
+                                  "}\n");
+
+  EXPECT_EQ(syntax_error_count_, 5);
+  EXPECT_NE(output.find("[E]: The integer literal '9223372036854775808' is "
+                        "too large."),
+            std::string::npos)
+      << output;
+  EXPECT_NE(output.find("Line: 1 - Column: 10"), std::string::npos) << output;
+  EXPECT_NE(output.find("Line: 6 - Column: 8"), std::string::npos) << output;
+}
+
+TEST_F(ParserTest, ReportsStatementsAfterReturn) {
+  std::string output = ParseError("f() {\n  return 1\n  g()\n}\n");
+
+  EXPECT_NE(output.find("must be the last statement of its block"),
+            std::string::npos)
+      << output;
+}
+
+TEST_F(ParserTest, ReportsArrayLengthsOutsideOfLocalDeclarations) {
+  EXPECT_NE(ParseError("a: int[3]\n")
+                .find("can only be given in the declaration of a local "
+                      "variable"),
+            std::string::npos);
+}
+
+TEST_F(ParserTest, ReportsInitializedArraysWithLengths) {
+  EXPECT_NE(ParseError("f() { a: int[3] = {1, 2, 3} }")
+                .find("declared with a length cannot also be initialized"),
+            std::string::npos);
+}
+
+TEST_F(ParserTest, ReportsExpressionsUsedAsStatements) {
+  EXPECT_NE(ParseError("f() { x + 1 }")
+                .find("neither a procedure call nor assigned to"),
+            std::string::npos);
+  EXPECT_NE(
+      ParseError("f() { 1 = x }").find("Expected a statement, but found '1'."),
+      std::string::npos);
+}
+
+TEST_F(ParserTest, ReportsUsesAfterDefinitions) {
+  EXPECT_NE(ParseError("f() {}\nuse io\n").find("must precede every"),
+            std::string::npos);
+}
+
+TEST_F(ParserTest, ReportsUnexpectedEndOfFile) {
+  EXPECT_NE(ParseError("f() {").find("but found the end of the file"),
+            std::string::npos);
+}
+
+TEST_F(ParserTest, ReportsDeeplyNestedCodeWithoutExhaustingTheStack) {
+  std::string expression(100000, '(');
+  std::string output = ParseError("f() { x = " + expression + " }");
+
+  EXPECT_NE(output.find("nested more than"), std::string::npos) << output;
+}
+
+TEST_F(ParserTest, CountsEveryIfOrWhileAndItsBlockAsOneLevelOfNesting) {
+  auto nest = [](std::size_t depth) {
+    std::string statement = "x = 1";
+    for (std::size_t level = 0; level < depth; level++) {
+      statement =
+          (level % 2 == 0 ? "if x { " : "while x { ") + statement + " }";
+    }
+    return "f() { " + statement + " }";
+  };
+
+  ParseSourceCode(nest(1990));
+  EXPECT_FALSE(diagnostic_reporter_.HasNormalErrors());
+  EXPECT_EQ(syntax_error_count_, 0);
+  EXPECT_NE(ParseError(nest(2010)).find("nested more than"), std::string::npos);
+}
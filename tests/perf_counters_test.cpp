@@ -0,0 +1,126 @@
+#include "senbonzakura/perf_counters.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace {
+
+PerfCounterValues MakeValues(std::uint64_t cycles, std::uint64_t instructions,
+                             std::uint64_t page_faults) {
+  PerfCounterValues values;
+  values.counts[static_cast<std::size_t>(PerfEvent::kCycles)] = cycles;
+  values.counts[static_cast<std::size_t>(PerfEvent::kInstructions)] =
+      instructions;
+  values.counts[static_cast<std::size_t>(PerfEvent::kPageFaults)] = page_faults;
+  values.is_available[static_cast<std::size_t>(PerfEvent::kCycles)] = true;
+  values.is_available[static_cast<std::size_t>(PerfEvent::kInstructions)] =
+      true;
+  values.is_available[static_cast<std::size_t>(PerfEvent::kPageFaults)] = true;
+
+  return values;
+}
+
+} // namespace
+
+TEST(PerfCountersTest, NamesEveryEvent) {
+  EXPECT_EQ(GetPerfEventName(PerfEvent::kCycles), "cycles");
+  EXPECT_EQ(GetPerfEventName(PerfEvent::kL1dMisses), "L1D-misses");
+  EXPECT_EQ(GetPerfEventName(PerfEvent::kPageFaults), "page-faults");
+}
+
+TEST(PerfCountersTest, SumsValuesAvailableInBoth) {
+  PerfCounterValues values = MakeValues(100, 200, 3);
+  PerfCounterValues other = MakeValues(50, 50, 1);
+  other.is_available[static_cast<std::size_t>(PerfEvent::kCycles)] = false;
+
+  values += other;
+
+  EXPECT_EQ(values.Get(PerfEvent::kInstructions), 250);
+  EXPECT_EQ(values.Get(PerfEvent::kPageFaults), 4);
+  EXPECT_FALSE(values.IsAvailable(PerfEvent::kCycles));
+  EXPECT_FALSE(values.IsAvailable(PerfEvent::kLlcMisses));
+}
+
+TEST(PerfCountersTest, MergesReportsPhaseByPhase) {
+  PerfCounterReport first_report;
+  first_report.AddPhaseCounters("lex", MakeValues(100, 300, 1));
+  first_report.SetByteCount(1024);
+  PerfCounterReport second_report;
+  second_report.AddPhaseCounters("scan", MakeValues(10, 10, 1));
+  second_report.AddPhaseCounters("lex", MakeValues(100, 100, 1));
+  second_report.SetByteCount(1024);
+
+  PerfCounterReport total_report;
+  total_report.Merge(first_report);
+  total_report.Merge(second_report);
+
+  ASSERT_EQ(total_report.GetPhaseCounters().size(), 2);
+  EXPECT_EQ(total_report.GetPhaseCounters()[0].phase_name, "lex");
+  EXPECT_EQ(
+      total_report.GetPhaseCounters()[0].values.Get(PerfEvent::kInstructions),
+      400);
+  EXPECT_EQ(total_report.GetPhaseCounters()[1].phase_name, "scan");
+  EXPECT_EQ(total_report.GetByteCount(), 2048);
+}
+
+TEST(PerfCountersTest, FormatsInstructionsPerCycleAndRatesPerKilobyte) {
+  PerfCounterReport report;
+  report.AddPhaseCounters("lex", MakeValues(1000, 2500, 8));
+  report.SetByteCount(4096);
+
+  std::string output = FormatPerfCounterReport("'main.eta'", report);
+
+  EXPECT_EQ(output.find("===-- Performance counters for 'main.eta' --===\n"),
+            0);
+  EXPECT_NE(output.find("  lex                    1000           2500   2.50"
+                        "              -              -              -"
+                        "           2.00\n"),
+            std::string::npos);
+  EXPECT_NE(output.find("  total "), std::string::npos);
+}
+
+TEST(PerfCountersTest, CountsTheEventsOfTheCallingThread) {
+  PerfCounters perf_counters;
+  if (!perf_counters.HasAnyEvent()) {
+    GTEST_SKIP() << "No event can be counted: "
+                 << perf_counters.DescribeUnavailableEvents();
+  }
+
+  PerfCounterValues start = perf_counters.Read();
+  // Touches fresh pages, which is counted by software events too.
+  constexpr std::size_t kSize = 16 << 20;
+  std::unique_ptr<char[]> memory{new char[kSize]};
+  for (std::size_t i = 0; i < kSize; i += 4096) {
+    memory[i] = static_cast<char>(i);
+  }
+  PerfCounterValues end = perf_counters.Read();
+
+  for (std::size_t i = 0; i < kPerfEventCount; i++) {
+    auto perf_event = static_cast<PerfEvent>(i);
+    if (end.IsAvailable(perf_event)) {
+      EXPECT_GE(end.Get(perf_event), start.Get(perf_event));
+    }
+  }
+  if (end.IsAvailable(PerfEvent::kPageFaults)) {
+    EXPECT_GT(end.Get(PerfEvent::kPageFaults),
+              start.Get(PerfEvent::kPageFaults));
+  }
+}
+
+TEST(PerfCountersTest, RecordsScopesOnlyIntoAReport) {
+  { PerfCounterScope perf_counter_scope{nullptr, "lex"}; }
+
+  PerfCounterReport report;
+  {
+    PerfCounterScope perf_counter_scope{&report, "lex"};
+  }
+  if (GetThreadPerfCounters() == nullptr) {
+    EXPECT_TRUE(report.GetPhaseCounters().empty());
+  } else {
+    ASSERT_EQ(report.GetPhaseCounters().size(), 1);
+    EXPECT_EQ(report.GetPhaseCounters()[0].phase_name, "lex");
+  }
+}
@@ -0,0 +1,107 @@
+#include "senbonzakura/program_generator.hpp"
+
+#include "senbonzakura/ast.hpp"
+#include "senbonzakura/diagnostic_reporter.hpp"
+#include "senbonzakura/lexer.hpp"
+#include "senbonzakura/parser.hpp"
+#include "senbonzakura/token.hpp"
+#include "senbonzakura/token_stream.hpp"
+#include "senbonzakura/token_type.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace {
+
+// Lexes and parses 'source_code', and returns whether it produced any
+// diagnostic.
+bool CompilesWithoutDiagnostics(const std::string &source_code) {
+  DiagnosticReporter diagnostic_reporter;
+  Lexer lexer{"generated.eta", source_code, diagnostic_reporter};
+  std::vector<Token> tokens = lexer.LexTokens();
+  if (tokens.empty() || tokens.back().token_type_ != TokenType::kFileEnd ||
+      diagnostic_reporter.HasFatalErrors()) {
+    return false;
+  }
+
+  SpanTokenStream token_stream{tokens};
+  Parser parser{"generated.eta", source_code, token_stream,
+                diagnostic_reporter};
+  Ast ast = parser.Parse();
+
+  return ast.GetRoot() != kNoAstIndex && !diagnostic_reporter.HasWarnings() &&
+         !diagnostic_reporter.HasNormalErrors() &&
+         !diagnostic_reporter.HasFatalErrors();
+}
+
+} // namespace
+
+TEST(ProgramGeneratorTest, GeneratesTheSameProgramForTheSameSeed) {
+  ProgramGeneratorOptions options{.seed = 42};
+  ProgramGenerator program_generator{options};
+  std::string program = program_generator.Generate();
+
+  EXPECT_EQ(ProgramGenerator{options}.Generate(), program);
+  EXPECT_EQ(program_generator.Generate(), program);
+  options.seed = 43;
+  EXPECT_NE(ProgramGenerator{options}.Generate(), program);
+}
+
+TEST(ProgramGeneratorTest, GeneratesProgramsThatCompileWithoutDiagnostics) {
+  for (std::uint64_t seed = 1; seed <= 50; seed++) {
+    ProgramGeneratorOptions options{.seed = seed,
+                                    .max_nesting_depth = 4,
+                                    .array_usage = 0.5,
+                                    .import_count = seed % 3};
+    std::string program = ProgramGenerator{options}.Generate();
+
+    EXPECT_NE(program.find("main(args: int[][]) {\n"), std::string::npos);
+    EXPECT_TRUE(CompilesWithoutDiagnostics(program)) << "Seed: " << seed;
+  }
+}
+
+TEST(ProgramGeneratorTest, ImportsTheRequestedInterfaces) {
+  ProgramGeneratorOptions options{.import_count = 0};
+  EXPECT_EQ(ProgramGenerator{options}.Generate().find("use "),
+            std::string::npos);
+
+  options.import_count = 2;
+  std::string program = ProgramGenerator{options}.Generate();
+  EXPECT_NE(program.find("use io\n"), std::string::npos);
+  EXPECT_NE(program.find("use conv"), std::string::npos);
+}
+
+TEST(ProgramGeneratorTest, KeepsAddingFunctionsUntilTheTargetSize) {
+  ProgramGeneratorOptions options{.function_count = 1,
+                                  .target_size = 1 << 20};
+  std::string program = ProgramGenerator{options}.Generate();
+
+  EXPECT_GE(program.size(), options.target_size);
+  EXPECT_NE(program.find("function_100("), std::string::npos);
+  EXPECT_TRUE(CompilesWithoutDiagnostics(program));
+}
+
+TEST(ProgramGeneratorTest, GeneratesPathologicalPrograms) {
+  ProgramGeneratorOptions options{.pathological = true,
+                                  .pathological_scale = 500};
+  std::string program = ProgramGenerator{options}.Generate();
+
+  EXPECT_NE(program.find("pathological_nesting(x: int): int {\n"),
+            std::string::npos);
+  EXPECT_NE(program.find(std::string(500, '(') + "x" + std::string(500, ')')),
+            std::string::npos);
+  EXPECT_NE(program.find("9223372036854775807"), std::string::npos);
+  EXPECT_TRUE(CompilesWithoutDiagnostics(program));
+}
+
+TEST(ProgramGeneratorTest, GeneratesPathologicalProgramsThatParseByDefault) {
+  ProgramGeneratorOptions options{.pathological = true};
+  std::string program = ProgramGenerator{options}.Generate();
+
+  EXPECT_NE(program.find(std::string(options.pathological_scale, '(') + "x"),
+            std::string::npos);
+  EXPECT_TRUE(CompilesWithoutDiagnostics(program));
+}
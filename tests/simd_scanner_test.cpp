@@ -0,0 +1,93 @@
+#include "senbonzakura/simd_scanner.hpp"
+
+#include <cstddef>
+#include <random>
+#include <string>
+#include <string_view>
+
+#include <gtest/gtest.h>
+
+namespace {
+
+constexpr SimdLevel kAllSimdLevels[] = {SimdLevel::kScalar, SimdLevel::kSse2,
+                                        SimdLevel::kAvx2};
+
+// Builds a buffer mixing long runs of every character class the scanners care
+// about, so that runs cross vector boundaries at every possible offset.
+std::string MakeRandomBuffer(std::size_t size, unsigned int seed) {
+  static constexpr std::string_view kAlphabet =
+      "  \t\r\n\nabcXYZ019_'+(\"@\x80\xff";
+  std::mt19937 generator{seed};
+  std::string buffer;
+  while (buffer.size() < size) {
+    char c = kAlphabet[generator() % kAlphabet.size()];
+    buffer.append(generator() % 40 + 1, c);
+  }
+  buffer.resize(size);
+  return buffer;
+}
+
+bool IsIdentifierPart(char c) {
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+         (c >= '0' && c <= '9') || c == '_' || c == '\'';
+}
+
+} // namespace
+
+TEST(SimdScannerTest, GetSimdScannerNeverExceedsSupportedLevel) {
+  for (SimdLevel level : kAllSimdLevels) {
+    EXPECT_LE(GetSimdScanner(level).level, GetSupportedSimdLevel());
+  }
+  EXPECT_EQ(GetSimdScanner().level, GetSupportedSimdLevel());
+}
+
+TEST(SimdScannerTest, AllLevelsMatchReferenceImplementation) {
+  std::string buffer = MakeRandomBuffer(4096, 42);
+  const char *data = buffer.data();
+
+  for (SimdLevel level : kAllSimdLevels) {
+    const SimdScanner &scanner = GetSimdScanner(level);
+    for (std::size_t position = 0; position < 300; position++) {
+      for (std::size_t end : {position, position + 7, position + 33,
+                              position + 100, buffer.size()}) {
+        std::size_t expected = position;
+        while (expected < end && data[expected] != '\n') {
+          expected++;
+        }
+        EXPECT_EQ(scanner.find_newline(data, position, end), expected);
+
+        expected = position;
+        while (expected < end && IsIdentifierPart(data[expected])) {
+          expected++;
+        }
+        EXPECT_EQ(scanner.skip_identifier_part(data, position, end), expected);
+
+        expected = position;
+        while (expected < end && data[expected] >= '0' &&
+               data[expected] <= '9') {
+          expected++;
+        }
+        EXPECT_EQ(scanner.skip_digits(data, position, end), expected);
+
+        expected = position;
+        while (expected < end &&
+               (data[expected] == ' ' || data[expected] == '\t' ||
+                data[expected] == '\r' || data[expected] == '\n')) {
+          expected++;
+        }
+        EXPECT_EQ(scanner.skip_whitespace(data, position, end), expected);
+      }
+    }
+  }
+}
+
+TEST(SimdScannerTest, SkipWhitespaceSkipsNewlinesAcrossLongRuns) {
+  std::string buffer = std::string(70, ' ') + "\n\t\t\n" +
+                       std::string(50, '\t') + "\r\nx";
+
+  for (SimdLevel level : kAllSimdLevels) {
+    EXPECT_EQ(GetSimdScanner(level).skip_whitespace(buffer.data(), 0,
+                                                    buffer.size()),
+              buffer.size() - 1);
+  }
+}
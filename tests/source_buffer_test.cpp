@@ -0,0 +1,100 @@
+#include "senbonzakura/source_buffer.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utility>
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+class SourceBufferTest : public ::testing::Test {
+protected:
+  std::string temp_dir_path_;
+
+  void SetUp() override {
+    temp_dir_path_ = std::filesystem::temp_directory_path().string() +
+                     "/test_sourcebuffer_dir";
+    std::filesystem::create_directory(temp_dir_path_);
+  }
+
+  void TearDown() override { std::filesystem::remove_all(temp_dir_path_); }
+
+  std::string CreateTestFile(const std::string &filename,
+                             const std::string &content) {
+    std::string file_path = temp_dir_path_ + "/" + filename;
+    std::ofstream file{file_path, std::ios::binary};
+    file << content;
+
+    return file_path;
+  }
+};
+
+TEST_F(SourceBufferTest, MapsRegularFiles) {
+  std::string content = "use io\nmain() {}\n";
+  SourceBuffer source_buffer;
+
+  ASSERT_TRUE(source_buffer.Load(CreateTestFile("test.eta", content)));
+
+  EXPECT_TRUE(source_buffer.IsMapped());
+  EXPECT_EQ(source_buffer.View(), content);
+  EXPECT_EQ(source_buffer.Data()[source_buffer.Size()], '\0');
+}
+
+TEST_F(SourceBufferTest, KeepsTheSentinelForPageSizedFiles) {
+  std::string content(static_cast<std::size_t>(sysconf(_SC_PAGESIZE)) * 2,
+                      'x');
+  SourceBuffer source_buffer;
+
+  ASSERT_TRUE(source_buffer.Load(CreateTestFile("page.eta", content)));
+
+  EXPECT_TRUE(source_buffer.IsMapped());
+  EXPECT_EQ(source_buffer.View(), content);
+  EXPECT_EQ(source_buffer.Data()[source_buffer.Size()], '\0');
+}
+
+TEST_F(SourceBufferTest, LoadsEmptyFiles) {
+  SourceBuffer source_buffer;
+
+  ASSERT_TRUE(source_buffer.Load(CreateTestFile("empty.eta", "")));
+
+  EXPECT_EQ(source_buffer.Size(), 0);
+  EXPECT_EQ(source_buffer.Data()[0], '\0');
+}
+
+TEST_F(SourceBufferTest, FallsBackToReadingPipes) {
+  int pipe_descriptors[2];
+  ASSERT_EQ(pipe(pipe_descriptors), 0);
+  std::string content = "x: int = 42;";
+  ASSERT_EQ(write(pipe_descriptors[1], content.data(), content.size()),
+            static_cast<ssize_t>(content.size()));
+  close(pipe_descriptors[1]);
+
+  SourceBuffer source_buffer;
+  bool loaded = source_buffer.Load("/dev/fd/" +
+                                   std::to_string(pipe_descriptors[0]));
+  close(pipe_descriptors[0]);
+
+  ASSERT_TRUE(loaded);
+  EXPECT_FALSE(source_buffer.IsMapped());
+  EXPECT_EQ(source_buffer.View(), content);
+  EXPECT_EQ(source_buffer.Data()[source_buffer.Size()], '\0');
+}
+
+TEST_F(SourceBufferTest, FailsOnMissingFiles) {
+  SourceBuffer source_buffer;
+
+  EXPECT_FALSE(source_buffer.Load(temp_dir_path_ + "/missing.eta"));
+  EXPECT_EQ(source_buffer.Size(), 0);
+}
+
+TEST_F(SourceBufferTest, MovesOwnership) {
+  std::string content = "length(a)";
+  SourceBuffer source_buffer;
+  ASSERT_TRUE(source_buffer.Load(CreateTestFile("move.eta", content)));
+
+  SourceBuffer moved_source_buffer{std::move(source_buffer)};
+
+  EXPECT_EQ(moved_source_buffer.View(), content);
+  EXPECT_EQ(source_buffer.Size(), 0);
+}
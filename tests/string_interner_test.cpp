@@ -0,0 +1,89 @@
+#include "senbonzakura/string_interner.hpp"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+TEST(StringInternerTest, InternsEqualStringsToTheSameSymbol) {
+  StringInterner string_interner;
+
+  Symbol foo_symbol = string_interner.Intern("foo");
+  Symbol bar_symbol = string_interner.Intern("bar");
+  std::string foo_copy = "foo";
+
+  EXPECT_TRUE(foo_symbol.IsValid());
+  EXPECT_NE(foo_symbol, bar_symbol);
+  EXPECT_EQ(string_interner.Intern(foo_copy), foo_symbol);
+  EXPECT_EQ(string_interner.GetSize(), 2);
+}
+
+TEST(StringInternerTest, GetStringReturnsTheInternedString) {
+  StringInterner string_interner;
+  std::string long_string(40000, 'x');
+
+  Symbol identifier_symbol = string_interner.Intern("a_b'c");
+  Symbol long_symbol = string_interner.Intern(long_string);
+  Symbol empty_symbol = string_interner.Intern("");
+
+  EXPECT_EQ(string_interner.GetString(identifier_symbol), "a_b'c");
+  EXPECT_EQ(string_interner.GetString(long_symbol), long_string);
+  EXPECT_EQ(string_interner.GetString(empty_symbol), "");
+  EXPECT_TRUE(empty_symbol.IsValid());
+  EXPECT_EQ(string_interner.GetString(Symbol{}), "");
+}
+
+TEST(StringInternerTest, FindDoesNotIntern) {
+  StringInterner string_interner;
+  Symbol symbol = string_interner.Intern("main");
+
+  EXPECT_EQ(string_interner.Find("main"), symbol);
+  EXPECT_FALSE(string_interner.Find("length").IsValid());
+  EXPECT_EQ(string_interner.GetSize(), 1);
+}
+
+TEST(StringInternerTest, KeepsStringsStableWhileGrowing) {
+  StringInterner string_interner;
+  std::vector<Symbol> symbols;
+  std::vector<const char *> first_characters;
+
+  for (int i = 0; i < 20000; i++) {
+    Symbol symbol = string_interner.Intern("name_" + std::to_string(i));
+    symbols.push_back(symbol);
+    first_characters.push_back(string_interner.GetString(symbol).data());
+  }
+
+  EXPECT_EQ(string_interner.GetSize(), 20000);
+  for (int i = 0; i < 20000; i++) {
+    EXPECT_EQ(string_interner.GetString(symbols[i]),
+              "name_" + std::to_string(i));
+    EXPECT_EQ(string_interner.GetString(symbols[i]).data(),
+              first_characters[i]);
+  }
+}
+
+TEST(StringInternerTest, InternsConcurrently) {
+  StringInterner string_interner;
+  constexpr int kThreadCount = 8;
+  constexpr int kNameCount = 2000;
+  std::vector<std::vector<Symbol>> symbols(kThreadCount);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreadCount; t++) {
+    threads.emplace_back([&, t]() {
+      for (int i = 0; i < kNameCount; i++) {
+        symbols[t].push_back(
+            string_interner.Intern("identifier" + std::to_string(i)));
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(string_interner.GetSize(), kNameCount);
+  for (int t = 1; t < kThreadCount; t++) {
+    EXPECT_EQ(symbols[t], symbols[0]);
+  }
+}
@@ -0,0 +1,48 @@
+#include "senbonzakura/thread_pool.hpp"
+
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+TEST(ThreadPoolTest, ReturnsTheResultOfEveryTask) {
+  ThreadPool thread_pool{4};
+  std::vector<std::future<int>> futures;
+  for (int i = 0; i < 100; i++) {
+    futures.push_back(thread_pool.Submit([i]() { return i * i; }));
+  }
+
+  EXPECT_EQ(thread_pool.GetThreadCount(), 4);
+  for (int i = 0; i < 100; i++) {
+    EXPECT_EQ(futures[i].get(), i * i);
+  }
+}
+
+TEST(ThreadPoolTest, ForwardsExceptionsThroughTheFuture) {
+  ThreadPool thread_pool{2};
+  std::future<int> future = thread_pool.Submit(
+      []() -> int { throw std::runtime_error{"Task failed."}; });
+
+  EXPECT_THROW(future.get(), std::runtime_error);
+}
+
+TEST(ThreadPoolTest, RunsPendingTasksBeforeBeingDestroyed) {
+  std::atomic<int> finished_task_count = 0;
+  {
+    ThreadPool thread_pool{2};
+    for (int i = 0; i < 50; i++) {
+      thread_pool.Submit([&finished_task_count]() { finished_task_count++; });
+    }
+  }
+
+  EXPECT_EQ(finished_task_count, 50);
+}
+
+TEST(ThreadPoolTest, UsesAtLeastOneThread) {
+  ThreadPool thread_pool{0};
+
+  EXPECT_EQ(thread_pool.GetThreadCount(), 1);
+  EXPECT_EQ(thread_pool.Submit([]() { return 42; }).get(), 42);
+}
@@ -0,0 +1,110 @@
+#include "senbonzakura/time_report.hpp"
+
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+TEST(TimeReportTest, KeepsPhasesInTheOrderTheyFirstRan) {
+  TimeReport time_report;
+  time_report.AddPhaseTime("scan", 2ms);
+  time_report.AddPhaseTime("lex", 5ms);
+  time_report.AddPhaseTime("scan", 1ms);
+
+  const std::vector<PhaseTime> &phase_times = time_report.GetPhaseTimes();
+  ASSERT_EQ(phase_times.size(), 2);
+  EXPECT_EQ(phase_times[0].phase_name, "scan");
+  EXPECT_EQ(phase_times[0].wall_time, 3ms);
+  EXPECT_EQ(phase_times[1].phase_name, "lex");
+  EXPECT_EQ(phase_times[1].wall_time, 5ms);
+  EXPECT_EQ(time_report.GetTotalTime(), 8ms);
+}
+
+TEST(TimeReportTest, MeasuresPhasesAndReturnsTheirResult) {
+  TimeReport time_report;
+  int result = time_report.MeasurePhase("lex", []() { return 42; });
+  time_report.MeasurePhase("parse", []() {});
+
+  EXPECT_EQ(result, 42);
+  ASSERT_EQ(time_report.GetPhaseTimes().size(), 2);
+  EXPECT_EQ(time_report.GetPhaseTimes()[1].phase_name, "parse");
+  EXPECT_GE(time_report.GetTotalTime().count(), 0);
+}
+
+TEST(TimeReportTest, MergesPhasesAndCounts) {
+  TimeReport first_time_report;
+  first_time_report.AddPhaseTime("scan", 1ms);
+  first_time_report.SetByteCount(100);
+  first_time_report.SetTokenCount(10);
+  first_time_report.SetPeakResidentSetSize(4096);
+  TimeReport second_time_report;
+  second_time_report.AddPhaseTime("scan", 2ms);
+  second_time_report.AddPhaseTime("write", 3ms);
+  second_time_report.SetByteCount(50);
+  second_time_report.SetTokenCount(5);
+  second_time_report.SetPeakResidentSetSize(1024);
+
+  TimeReport total_time_report;
+  total_time_report.Merge(first_time_report);
+  total_time_report.Merge(second_time_report);
+
+  EXPECT_EQ(total_time_report.GetTotalTime(), 6ms);
+  EXPECT_EQ(total_time_report.GetPhaseTimes()[0].wall_time, 3ms);
+  EXPECT_EQ(total_time_report.GetByteCount(), 150);
+  EXPECT_EQ(total_time_report.GetTokenCount(), 15);
+  EXPECT_EQ(total_time_report.GetPeakResidentSetSize(), 4096);
+}
+
+TEST(TimeReportTest, MeasuresThePeakResidentSetSize) {
+  EXPECT_GT(GetPeakResidentSetSize(), 0);
+}
+
+TEST(TimeReportTest, FormatsATableWithTheThroughput) {
+  TimeReport time_report;
+  time_report.AddPhaseTime("lex", 500ms);
+  time_report.AddPhaseTime("write", 500ms);
+  time_report.SetByteCount(1 << 20);
+  time_report.SetTokenCount(1000);
+
+  std::string output = FormatTimeReport("'main.eta'", time_report);
+
+  EXPECT_EQ(output.find("===-- Time report for 'main.eta' --===\n"), 0);
+  EXPECT_NE(output.find("1048576 bytes, 1000 tokens"), std::string::npos);
+  EXPECT_NE(output.find("lex"), std::string::npos);
+  EXPECT_NE(output.find("50.0%"), std::string::npos);
+  EXPECT_NE(output.find("1000 tokens/s"), std::string::npos);
+  EXPECT_EQ(output.find("wall"), std::string::npos);
+
+  output = FormatTimeReport("2 files", time_report, 250ms);
+  EXPECT_NE(output.find("wall"), std::string::npos);
+  EXPECT_NE(output.find("4000 tokens/s"), std::string::npos);
+}
+
+TEST(TimeReportTest, FormatsJson) {
+  TimeReport time_report;
+  time_report.AddPhaseTime("lex", 2ms);
+  time_report.SetByteCount(10);
+  time_report.SetTokenCount(4);
+
+  std::string output = FormatTimeReportJson(
+      {{"dir/\"quoted\".eta", time_report}}, time_report, 1ms);
+
+  EXPECT_NE(output.find("{\"path\": \"dir/\\\"quoted\\\".eta\", "
+                        "\"bytes\": 10, \"tokens\": 4, "),
+            std::string::npos);
+  EXPECT_NE(output.find("\"wall_time_ns\": 2000000, "
+                        "\"tokens_per_second\": 2000, \"phases\": "
+                        "[{\"name\": \"lex\", \"wall_time_ns\": 2000000}]}"),
+            std::string::npos);
+  EXPECT_NE(output.find("\"total\": {\"files\": 1, \"bytes\": 10, "),
+            std::string::npos);
+  EXPECT_NE(output.find("\"wall_time_ns\": 1000000, "
+                        "\"tokens_per_second\": 4000, "),
+            std::string::npos);
+  EXPECT_NE(output.find("\"phase_time_ns\": 2000000}\n}\n"),
+            std::string::npos);
+}
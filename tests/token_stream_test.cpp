@@ -0,0 +1,128 @@
+#include "senbonzakura/diagnostic_reporter.hpp"
+#include "senbonzakura/lexer.hpp"
+#include "senbonzakura/token.hpp"
+#include "senbonzakura/token_stream.hpp"
+#include "senbonzakura/token_type.hpp"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace {
+
+// Stream producing 'count' identifiers followed by 'kFileEnd', which records
+// how many tokens have been pulled from it.
+class CountingTokenStream : public TokenStream {
+public:
+  explicit CountingTokenStream(std::size_t count) : count_{count} {}
+
+  Token NextToken() override {
+    pulled_++;
+    if (produced_ == count_) {
+      return Token{TokenType::kFileEnd,
+                   static_cast<std::uint32_t>(produced_), 0};
+    }
+    produced_++;
+    return Token{TokenType::kIdentifier,
+                 static_cast<std::uint32_t>(produced_ - 1), 1};
+  }
+
+  std::size_t pulled_ = 0;
+
+private:
+  std::size_t count_;
+  std::size_t produced_ = 0;
+};
+
+} // namespace
+
+TEST(TokenStreamTest, SpanTokenStreamReturnsTokensThenFileEnd) {
+  std::vector<Token> tokens{
+      Token{TokenType::kIdentifier, 0, 1},
+      Token{TokenType::kFileEnd, 1, 0},
+  };
+  SpanTokenStream token_stream{tokens};
+
+  EXPECT_EQ(token_stream.NextToken(), tokens[0]);
+  EXPECT_EQ(token_stream.NextToken(), tokens[1]);
+  EXPECT_EQ(token_stream.NextToken(), tokens[1]);
+}
+
+TEST(TokenStreamTest, SpanTokenStreamEndsTruncatedSequences) {
+  std::vector<Token> tokens{Token{TokenType::kIdentifier, 10, 4}};
+  SpanTokenStream token_stream{tokens};
+
+  token_stream.NextToken();
+  Token file_end_token = token_stream.NextToken();
+  EXPECT_EQ(file_end_token.token_type_, TokenType::kFileEnd);
+  EXPECT_EQ(file_end_token.offset_, 14);
+
+  SpanTokenStream empty_token_stream{std::vector<Token>{}};
+  EXPECT_EQ(empty_token_stream.NextToken().token_type_, TokenType::kFileEnd);
+}
+
+TEST(TokenStreamTest, TokenCursorPeeksWithoutConsuming) {
+  CountingTokenStream token_stream{10};
+  TokenCursor token_cursor{token_stream};
+
+  EXPECT_EQ(token_cursor.Peek(2).offset_, 2);
+  EXPECT_EQ(token_cursor.Peek(0).offset_, 0);
+  EXPECT_EQ(token_cursor.Advance().offset_, 0);
+  EXPECT_EQ(token_cursor.Peek(0).offset_, 1);
+  EXPECT_EQ(token_cursor.Peek(TokenCursor::kMaxLookahead).offset_,
+            1 + TokenCursor::kMaxLookahead);
+}
+
+TEST(TokenStreamTest, TokenCursorOnlyPullsTheLookaheadWindow) {
+  CountingTokenStream token_stream{1000};
+  TokenCursor token_cursor{token_stream};
+
+  for (std::size_t i = 0; i < 500; i++) {
+    token_cursor.Peek(1);
+    token_cursor.Advance();
+    EXPECT_LE(token_stream.pulled_, i + 2);
+  }
+}
+
+TEST(TokenStreamTest, TokenCursorStopsAtFileEnd) {
+  CountingTokenStream token_stream{2};
+  TokenCursor token_cursor{token_stream};
+
+  EXPECT_FALSE(token_cursor.IsAtEnd());
+  token_cursor.Advance();
+  token_cursor.Advance();
+  EXPECT_TRUE(token_cursor.IsAtEnd());
+  EXPECT_EQ(token_cursor.Advance().token_type_, TokenType::kFileEnd);
+  EXPECT_EQ(token_cursor.Peek(3).token_type_, TokenType::kFileEnd);
+}
+
+TEST(TokenStreamTest, LexerNextTokenMatchesLexTokens) {
+  std::string source_code = "use io\nmain(args: int[][]) {\n  x: int = 'a' + "
+                            "47; // comment\n  s = \"str\" *>> 2\n}\n";
+  DiagnosticReporter diagnostic_reporter;
+  Lexer batch_lexer{"file.eta", source_code, diagnostic_reporter};
+  const std::vector<Token> &expected_tokens = batch_lexer.LexTokens();
+
+  Lexer streaming_lexer{"file.eta", source_code, diagnostic_reporter};
+  TokenCursor token_cursor{streaming_lexer};
+  std::vector<Token> streamed_tokens;
+  while (!token_cursor.IsAtEnd()) {
+    streamed_tokens.push_back(token_cursor.Advance());
+  }
+  streamed_tokens.push_back(token_cursor.Advance());
+
+  EXPECT_EQ(streamed_tokens, expected_tokens);
+}
+
+TEST(TokenStreamTest, LexerNextTokenEndsAtFatalError) {
+  DiagnosticReporter diagnostic_reporter;
+  Lexer lexer{"file.eta", "x = @ y", diagnostic_reporter};
+
+  EXPECT_EQ(lexer.NextToken().token_type_, TokenType::kIdentifier);
+  EXPECT_EQ(lexer.NextToken().token_type_, TokenType::kEqual);
+  EXPECT_EQ(lexer.NextToken().token_type_, TokenType::kFileEnd);
+  EXPECT_EQ(lexer.NextToken().token_type_, TokenType::kFileEnd);
+  EXPECT_TRUE(diagnostic_reporter.HasFatalErrors());
+}
@@ -1,142 +1,180 @@
+#include "senbonzakura/line_table.hpp"
+#include "senbonzakura/string_interner.hpp"
 #include "senbonzakura/token.hpp"
 #include "senbonzakura/token_type.hpp"
 
-#include <any>
-#include <sstream>
 #include <string>
+#include <string_view>
+#include <type_traits>
 
 #include <gtest/gtest.h>
 
 TEST(TokenTest, TokenConstructorTest) {
-  Token identifier_token{1, 5, TokenType::kIdentifier, {}, "x"};
-  EXPECT_EQ(identifier_token.line_, 1);
-  EXPECT_EQ(identifier_token.column_, 5);
+  Token identifier_token{TokenType::kIdentifier, 4, 1};
   EXPECT_EQ(identifier_token.token_type_, TokenType::kIdentifier);
-  EXPECT_EQ(identifier_token.value_.has_value(), false);
-  EXPECT_EQ(identifier_token.lexeme_, "x");
+  EXPECT_EQ(identifier_token.offset_, 4);
+  EXPECT_EQ(identifier_token.length_, 1);
 
-  Token integer_token{10, 23, TokenType::kInteger, 100, "100"};
-  EXPECT_EQ(integer_token.line_, 10);
-  EXPECT_EQ(integer_token.column_, 23);
+  Token integer_token{TokenType::kInteger, 120, 3, {.integer_value = 100}};
   EXPECT_EQ(integer_token.token_type_, TokenType::kInteger);
-  EXPECT_EQ(integer_token.value_.has_value(), true);
-  EXPECT_EQ(std::any_cast<int>(integer_token.value_), 100);
-  EXPECT_EQ(integer_token.lexeme_, "100");
+  EXPECT_EQ(integer_token.value_.integer_value, 100);
+  EXPECT_EQ(integer_token.length_, 3);
 
-  Token file_end_token{500, 1, TokenType::kFileEnd, {}, ""};
-  EXPECT_EQ(file_end_token.line_, 500);
-  EXPECT_EQ(file_end_token.column_, 1);
+  Token file_end_token{TokenType::kFileEnd, 8000, 0};
   EXPECT_EQ(file_end_token.token_type_, TokenType::kFileEnd);
-  EXPECT_EQ(file_end_token.value_.has_value(), false);
-  EXPECT_EQ(file_end_token.lexeme_, "");
-
-  Token string_literal_token{1, 5, TokenType::kString, "Hello World!",
-                             "\"Hello, World!\""};
-  EXPECT_EQ(string_literal_token.line_, 1);
-  EXPECT_EQ(string_literal_token.column_, 5);
-  EXPECT_EQ(string_literal_token.token_type_, TokenType::kString);
-  EXPECT_EQ(string_literal_token.value_.has_value(), true);
-  EXPECT_EQ(string_literal_token.lexeme_, "\"Hello, World!\"");
+  EXPECT_EQ(file_end_token.length_, 0);
 }
 
-TEST(TokenTest, OperatorPrintsIntegerCorrectlyTest) {
-  Token integer_token{1, 3, TokenType::kInteger, 12345, "12345"};
+TEST(TokenTest, TokenIsCompactAndTriviallyCopyableTest) {
+  EXPECT_TRUE(std::is_trivially_copyable_v<Token>);
+  EXPECT_LE(sizeof(Token), 16);
+}
 
-  std::stringstream ss;
-  ss << integer_token;
+TEST(TokenTest, GetLexemeViewsIntoSourceCodeTest) {
+  std::string_view source_code = "s: int[] = \"Hello, World!\";";
+  Symbol string_value = GetStringInterner().Intern("Hello, World!");
+  Token string_literal_token{TokenType::kString, 11, 15,
+                             {.symbol_value = string_value}};
 
-  std::string expected_output{"[001:003] Type: kInteger - Value: 12345"};
-  EXPECT_EQ(ss.str(), expected_output);
+  EXPECT_EQ(string_literal_token.GetLexeme(source_code), "\"Hello, World!\"");
+  EXPECT_EQ(string_literal_token.GetStringValue(), "Hello, World!");
+  EXPECT_EQ(string_literal_token.GetLexeme(source_code).data(),
+            source_code.data() + 11);
 }
 
-TEST(TokenTest, OperatorPrintsBooleanCorrectlyTest) {
-  Token truthy_boolean_token{10, 4, TokenType::kTrue, true, "true"};
-  Token falsey_boolean_token{11, 4, TokenType::kFalse, false, "false"};
+TEST(TokenTest, TokenToStringPrintsIntegerCorrectlyTest) {
+  std::string_view source_code = "  12345";
+  LineTable line_table{source_code};
+  Token integer_token{TokenType::kInteger, 2, 5, {.integer_value = 12345}};
 
-  std::stringstream ss;
-  ss << truthy_boolean_token;
+  std::string expected_output{"[001:003] Type: kInteger - Value: 12345"};
+  EXPECT_EQ(TokenToString(integer_token, source_code, line_table),
+            expected_output);
+}
 
-  std::string expected_truthy_boolean_output =
-      "[010:004] Type: kTrue - Value: true";
-  EXPECT_EQ(ss.str(), expected_truthy_boolean_output);
+TEST(TokenTest, TokenToStringPrintsBooleanCorrectlyTest) {
+  std::string_view source_code = "true\nfalse";
+  LineTable line_table{source_code};
+  Token truthy_boolean_token{TokenType::kTrue, 0, 4, {.boolean_value = true}};
+  Token falsey_boolean_token{TokenType::kFalse, 5, 5, {.boolean_value = false}};
 
-  ss.str("");
-  ss.clear();
-  ss << falsey_boolean_token;
+  std::string expected_truthy_boolean_output =
+      "[001:001] Type: kTrue - Value: true";
+  EXPECT_EQ(TokenToString(truthy_boolean_token, source_code, line_table),
+            expected_truthy_boolean_output);
 
   std::string expected_falsey_boolean_output =
-      "[011:004] Type: kFalse - Value: false";
-  EXPECT_EQ(ss.str(), expected_falsey_boolean_output);
+      "[002:001] Type: kFalse - Value: false";
+  EXPECT_EQ(TokenToString(falsey_boolean_token, source_code, line_table),
+            expected_falsey_boolean_output);
 }
 
-TEST(TokenTest, OperatorPrintsStringLiteralCorrectlyTest) {
-  std::string str = "Hello, World!\n";
-  Token string_literal_token{23, 2, TokenType::kString, str,
-                             "\"Hello, World!\n\""};
-
-  std::stringstream ss;
-  ss << string_literal_token;
+TEST(TokenTest, TokenToStringPrintsStringLiteralCorrectlyTest) {
+  std::string_view source_code = "x = \"Hello, World!\";";
+  LineTable line_table{source_code};
+  Symbol string_value = GetStringInterner().Intern("Hello, World!");
+  Token string_literal_token{TokenType::kString, 4, 15,
+                             {.symbol_value = string_value}};
 
   std::string expected_output =
-      "[023:002] Type: kString - Value: Hello, World!\n - Lexeme: \"Hello, World!\n\"";
+      "[001:005] Type: kString - Value: Hello, World! - Lexeme: \"Hello, "
+      "World!\"";
 
-  EXPECT_EQ(ss.str(), expected_output);
+  EXPECT_EQ(TokenToString(string_literal_token, source_code, line_table),
+            expected_output);
 }
 
-TEST(TokenTest, OperatorPrintsCharLiteralCorrectlyTest) {
-  char ch = 'd';
-  Token character_literal_token{1, 1, TokenType::kCharacter, ch, "'d'"};
+TEST(TokenTest, TokenToStringEscapesStringLiteralValuesTest) {
+  std::string_view source_code = "\"a\\tb\\n\\\\\"";
+  LineTable line_table{source_code};
+  Symbol string_value = GetStringInterner().Intern("a\tb\n\\");
+  Token string_literal_token{TokenType::kString, 0, 11,
+                             {.symbol_value = string_value}};
+
+  std::string expected_output =
+      "[001:001] Type: kString - Value: a\\tb\\n\\\\ - Lexeme: "
+      "\"a\\tb\\n\\\\\"";
 
-  std::stringstream ss;
-  ss << character_literal_token;
+  EXPECT_EQ(TokenToString(string_literal_token, source_code, line_table),
+            expected_output);
+}
 
-  std::string expected_output = "[001:001] Type: kCharacter - Value: d - Lexeme: 'd'";
+TEST(TokenTest, TokenToStringPrintsLargeIntegersTest) {
+  std::string_view source_code = "9223372036854775808";
+  LineTable line_table{source_code};
+  Token integer_token{TokenType::kInteger, 0, 19,
+                      {.integer_value = 9223372036854775808u}};
 
-  EXPECT_EQ(ss.str(), expected_output);
+  std::string expected_output{
+      "[001:001] Type: kInteger - Value: 9223372036854775808"};
+  EXPECT_EQ(TokenToString(integer_token, source_code, line_table),
+            expected_output);
 }
 
-TEST(TokenTest, OperatorPrintsDefaultLexemeCorrectlyTest) {
-  Token single_character_token{1, 1, TokenType::kColon, {}, ":"};
-  Token double_character_token{2, 1, TokenType::kEqualEqual, {}, "=="};
-  Token triple_character_token{3, 1, TokenType::kHighMul, {}, "*>>"};
-  Token identifier_token{4, 1, TokenType::kIdentifier, {}, "foo"};
-  Token primitive_type_token{5, 1, TokenType::kInt, {}, "int"};
-  Token keyword_token{6, 1, TokenType::kIf, {}, "if"};
-  Token file_end_token{7, 1, TokenType::kFileEnd, {}, ""};
+TEST(TokenTest, TokenToStringPrintsCharLiteralCorrectlyTest) {
+  std::string_view source_code = "'d'";
+  LineTable line_table{source_code};
+  Token character_literal_token{TokenType::kCharacter, 0, 3,
+                                {.character_value = 'd'}};
+
+  std::string expected_output =
+      "[001:001] Type: kCharacter - Value: d - Lexeme: 'd'";
+
+  EXPECT_EQ(TokenToString(character_literal_token, source_code, line_table),
+            expected_output);
+}
 
-  std::stringstream ss;
+TEST(TokenTest, TokenToStringPrintsDefaultLexemeCorrectlyTest) {
+  std::string_view source_code = ":\n==\n*>>\nfoo\nint\nif\n";
+  LineTable line_table{source_code};
+  Token single_character_token{TokenType::kColon, 0, 1};
+  Token double_character_token{TokenType::kEqualEqual, 2, 2};
+  Token triple_character_token{TokenType::kHighMul, 5, 3};
+  Token identifier_token{TokenType::kIdentifier, 9, 3};
+  Token primitive_type_token{TokenType::kInt, 13, 3};
+  Token keyword_token{TokenType::kIf, 17, 2};
+  Token file_end_token{TokenType::kFileEnd, 20, 0};
 
-  ss << single_character_token;
   std::string expected_output = "[001:001] Type: kColon - Lexeme: :";
-  EXPECT_EQ(ss.str(), expected_output);
+  EXPECT_EQ(TokenToString(single_character_token, source_code, line_table),
+            expected_output);
 
-  ss.str("");
-  ss << double_character_token;
   expected_output = "[002:001] Type: kEqualEqual - Lexeme: ==";
-  EXPECT_EQ(ss.str(), expected_output);
+  EXPECT_EQ(TokenToString(double_character_token, source_code, line_table),
+            expected_output);
 
-  ss.str("");
-  ss << triple_character_token;
   expected_output = "[003:001] Type: kHighMul - Lexeme: *>>";
-  EXPECT_EQ(ss.str(), expected_output);
+  EXPECT_EQ(TokenToString(triple_character_token, source_code, line_table),
+            expected_output);
 
-  ss.str("");
-  ss << identifier_token;
   expected_output = "[004:001] Type: kIdentifier - Lexeme: foo";
-  EXPECT_EQ(ss.str(), expected_output);
+  EXPECT_EQ(TokenToString(identifier_token, source_code, line_table),
+            expected_output);
 
-  ss.str("");
-  ss << primitive_type_token;
   expected_output = "[005:001] Type: kInt - Lexeme: int";
-  EXPECT_EQ(ss.str(), expected_output);
+  EXPECT_EQ(TokenToString(primitive_type_token, source_code, line_table),
+            expected_output);
 
-  ss.str("");
-  ss << keyword_token;
   expected_output = "[006:001] Type: kIf - Lexeme: if";
-  EXPECT_EQ(ss.str(), expected_output);
+  EXPECT_EQ(TokenToString(keyword_token, source_code, line_table),
+            expected_output);
 
-  ss.str("");
-  ss << file_end_token;
   expected_output = "[007:001] Type: kFileEnd - Lexeme: ";
-  EXPECT_EQ(ss.str(), expected_output);
+  EXPECT_EQ(TokenToString(file_end_token, source_code, line_table),
+            expected_output);
+}
+
+TEST(TokenTest, AppendTokenStringAppendsToTheOutputTest) {
+  std::string source_code = "x = 7";
+  std::string output = "previous line\n";
+
+  AppendTokenString(output, Token{TokenType::kIdentifier, 0, 1}, source_code,
+                    LineColumn{1234, 5});
+  AppendTokenString(output,
+                    Token{TokenType::kInteger, 4, 1, {.integer_value = 7}},
+                    source_code, LineColumn{1, 5});
+
+  EXPECT_EQ(output, "previous line\n"
+                    "[1234:005] Type: kIdentifier - Lexeme: x"
+                    "[001:005] Type: kInteger - Value: 7");
 }
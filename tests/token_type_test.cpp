@@ -1,5 +1,8 @@
 #include "senbonzakura/token_type.hpp"
 
+#include <cstddef>
+#include <format>
+
 #include <gtest/gtest.h>
 
 TEST(TokenTypeTest, AllTokenTypesReturnCorrectString) {
@@ -62,3 +65,15 @@ TEST(TokenTypeTest, AllTokenTypesReturnCorrectString) {
   // End of File Token
   EXPECT_EQ(TokenTypeToString(TokenType::kFileEnd), "kFileEnd");
 }
+
+TEST(TokenTypeTest, TokenTypeNamesMatchTokenTypeToString) {
+  static_assert(GetTokenTypeName(TokenType::kHighMul) == "kHighMul");
+
+  for (std::size_t i = 0; i < kTokenTypeNames.size(); i++) {
+    auto token_type = static_cast<TokenType>(i);
+    EXPECT_EQ(GetTokenTypeName(token_type), TokenTypeToString(token_type));
+    EXPECT_EQ(std::format("{}", token_type), TokenTypeToString(token_type));
+  }
+  EXPECT_EQ(GetTokenTypeName(static_cast<TokenType>(kTokenTypeNames.size())),
+            "Unknown TokenType");
+}
@@ -0,0 +1,79 @@
+#include "senbonzakura/trace.hpp"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+// Tracing cannot be stopped once started, so this test must run before the
+// ones that start it.
+TEST(TraceTest, RecordsNothingBeforeTracingStarts) {
+  if (IsTracingEnabled()) {
+    GTEST_SKIP() << "Tracing was already started.";
+  }
+
+  { TraceScope trace_scope{"Untraced", "trace_test_untraced.eta"}; }
+
+  EXPECT_EQ(FormatTrace().find("trace_test_untraced.eta"), std::string::npos);
+}
+
+TEST(TraceTest, RecordsSpansWithTheirCounts) {
+  if (!IsTracingSupported()) {
+    GTEST_SKIP() << "Built without tracing support.";
+  }
+  StartTracing();
+
+  {
+    TraceScope trace_scope{"Lexer::LexTokens", "trace_test_counts.eta"};
+    trace_scope.SetByteCount(1234);
+    trace_scope.SetTokenCount(56);
+  }
+  { TraceScope trace_scope{"Parser::Parse", "trace_test_no_counts.eta"}; }
+
+  std::string trace = FormatTrace();
+  EXPECT_EQ(trace.find("{\"displayTimeUnit\": \"ms\", \"traceEvents\": ["), 0);
+  EXPECT_NE(trace.find("\"name\": \"thread_name\", \"ph\": \"M\""),
+            std::string::npos);
+  EXPECT_NE(trace.find("{\"name\": \"Lexer::LexTokens\", \"cat\": "
+                       "\"compilation\", \"ph\": \"X\", \"ts\": "),
+            std::string::npos);
+  EXPECT_NE(trace.find("\"args\": {\"file\": \"trace_test_counts.eta\", "
+                       "\"bytes\": 1234, \"tokens\": 56}}"),
+            std::string::npos);
+  EXPECT_NE(trace.find("\"args\": {\"file\": \"trace_test_no_counts.eta\"}}"),
+            std::string::npos);
+}
+
+TEST(TraceTest, RecordsEveryThreadInItsOwnBuffer) {
+  if (!IsTracingSupported()) {
+    GTEST_SKIP() << "Built without tracing support.";
+  }
+  StartTracing();
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; i++) {
+    threads.emplace_back([i]() {
+      for (int j = 0; j < 100; j++) {
+        TraceScope trace_scope{"Worker",
+                               i == 0 ? "trace_test_first_worker.eta"
+                                      : "trace_test_other_worker.eta"};
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+
+  std::string trace = FormatTrace();
+  EXPECT_NE(trace.find("\"args\": {\"name\": \"worker 1\"}"),
+            std::string::npos);
+  EXPECT_NE(trace.find("trace_test_first_worker.eta"), std::string::npos);
+  std::size_t event_count = 0;
+  for (std::size_t position = trace.find("trace_test_other_worker.eta");
+       position != std::string::npos;
+       position = trace.find("trace_test_other_worker.eta", position + 1)) {
+    event_count++;
+  }
+  EXPECT_EQ(event_count, 300);
+}
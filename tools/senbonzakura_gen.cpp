@@ -0,0 +1,87 @@
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include <CLI/CLI.hpp>
+
+#include "senbonzakura/program_generator.hpp"
+
+int main(int argc, const char **argv) {
+  ProgramGeneratorOptions options;
+  std::string output_file_path;
+
+  CLI::App senbonzakura_gen_app{
+      "Generates synthetic Eta programs for scale and stress testing of the "
+      "Senbonzakura Compiler. The same options and seed always generate the "
+      "same program."};
+
+  senbonzakura_gen_app.add_option("-s,--seed", options.seed,
+                                  "The seed of the generated program. "
+                                  "Defaults to 1.");
+  senbonzakura_gen_app.add_option(
+      "-f,--functions", options.function_count,
+      "The number of functions besides 'main'. Defaults to 16.");
+  senbonzakura_gen_app.add_option(
+      "--size", options.target_size,
+      "The minimum size of the program, in bytes. Functions keep being added "
+      "until it is reached. Defaults to 0, which disables it.");
+  senbonzakura_gen_app.add_option(
+      "--depth", options.max_nesting_depth,
+      "The deepest nesting of 'if' and 'while' blocks. Defaults to 3.");
+  senbonzakura_gen_app.add_option(
+      "--expression-size", options.max_expression_size,
+      "The largest number of operators in an expression. Defaults to 8.");
+  senbonzakura_gen_app.add_option(
+      "--statements", options.statements_per_function,
+      "The number of statements in every function body. Defaults to 12.");
+  senbonzakura_gen_app
+      .add_option("--array-usage", options.array_usage,
+                  "The probability, from 0 to 1, of using an array instead "
+                  "of an 'int' or a 'bool'. Defaults to 0.3.")
+      ->check(CLI::Range(0.0, 1.0));
+  senbonzakura_gen_app
+      .add_option("--literal-density", options.literal_density,
+                  "The probability, from 0 to 1, that an operand is a "
+                  "literal instead of a variable. Defaults to 0.3.")
+      ->check(CLI::Range(0.0, 1.0));
+  senbonzakura_gen_app
+      .add_option("--imports", options.import_count,
+                  "The number of interfaces imported with 'use': 0, 1 ('io') "
+                  "or 2 ('io' and 'conv'). Defaults to 2.")
+      ->check(CLI::Range(0, 2));
+  senbonzakura_gen_app.add_flag(
+      "--pathological", options.pathological,
+      "Also generates functions with very deep nesting, very long lines and "
+      "huge literals.");
+  senbonzakura_gen_app
+      .add_option("--pathological-scale", options.pathological_scale,
+                  "The nesting depth and line length of the pathological "
+                  "functions. Defaults to 1000.")
+      ->check(CLI::PositiveNumber);
+  senbonzakura_gen_app.add_option(
+      "-o,--output", output_file_path,
+      "The file where the program is written. Defaults to the standard "
+      "output.");
+
+  CLI11_PARSE(senbonzakura_gen_app, argc, argv);
+
+  std::string program = ProgramGenerator{options}.Generate();
+  if (output_file_path.empty()) {
+    std::cout << program;
+    return 0;
+  }
+
+  std::ofstream output_file{output_file_path, std::ios::binary};
+  if (!output_file.write(program.data(),
+                         static_cast<std::streamsize>(program.size()))) {
+    std::cerr << std::format("[E]: Could not write the program to '{}'.",
+                             output_file_path)
+              << std::endl;
+    return 1;
+  }
+
+  return 0;
+}